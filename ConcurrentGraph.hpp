@@ -0,0 +1,898 @@
+/////////////////////////////////////////////////////////////////////
+// Graph that many threads may change and read at once. Vertices   //
+// are spread over lock stripes by a hash of their IDs, and each   //
+// stripe keeps the relationships of its vertices, back-links      //
+// included, as a Graph does. A change to the relationship between //
+// i and j locks only the stripes of i and j, in stripe order so   //
+// that changes cannot deadlock, and makes both sides of it before //
+// either lock is let go; a query locks only the stripe of the     //
+// first vertex. Changes and queries whose vertices share a stripe //
+// still wait for each other. Queries and changes have the same    //
+// meaning as on Graph.                                            //
+//                                                                 //
+// Keys are interned into a table that is copied when a key is     //
+// added, so looking up a key takes no lock; old tables are kept   //
+// until the graph is destroyed. size and num_edges add up counts  //
+// without locking, so they may be out of date by the changes in   //
+// progress. graph() takes every lock for a consistent copy.       //
+// Build with -pthread (or the platform's equivalent).             //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - set with a KeyID the graph did not issue does nothing.        //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_CONCURRENTGRAPH_20261015
+#define YOUNG_GIS_CONCURRENTGRAPH_20261015
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <scoped_allocator>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+#include "NodePool.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+template <class Id, class K, class W, class S=OrderedMaps>
+class BasicConcurrentGraph {
+public:
+	typedef BasicGraph<Id,K,W,S> G;
+private:
+	static const unsigned char UNDIRECTED;
+	static const unsigned char FROM;
+
+	// the relationships of a vertex, by neighbor and key ID, as in a
+	// Graph: the bool is false if the relationship only exists *to*
+	// the vertex from the neighbor
+	typedef typename RelStore<K, W>::Rel Rel;
+	typedef typename RelStore<K, W>::Map RelMap;   // key ID -> rel
+	typedef typename S::template Map<Id, RelMap,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, RelMap> > > >::type NbrMap; // j -> rels
+	typedef typename S::template Map<Id, NbrMap,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, NbrMap> > > >::type VertexMap; // i -> nbrs
+	typedef typename VertexMap::allocator_type Alloc;
+
+	// the vertices of one stripe, drawing from the stripe's own pool,
+	// with their number (n) and the number of relationships from them
+	// (m); the counts change under the lock but are read without it
+	struct Stripe {
+		std::mutex lock;
+		NodePool pool;                 // before rows
+		VertexMap rows;
+		std::atomic<size_t> n, m;
+
+		Stripe () : rows(Alloc(PoolAllocator<int>(&pool))), n(0), m(0) {}
+	};
+	std::vector<std::unique_ptr<Stripe> > stripes;
+	size_t mask;                     // stripes.size() - 1
+
+	// key dictionary, replaced by a larger copy when a key is added
+	struct Keys {
+		std::vector<K> names;
+		std::map<K, unsigned int> ids;
+	};
+	std::atomic<const Keys*> keys;
+	std::vector<std::unique_ptr<const Keys> > tables;  // every one made
+	std::mutex key_lock;             // held to add a key
+
+	typedef std::unique_lock<std::mutex> Lock;
+
+	void init ( size_t );
+	size_t stripe ( Id ) const;
+	void hold ( Id, Id, Lock&, Lock& ) const;
+	void hold_all ( std::vector<Lock>& ) const;
+	const Rel* rel ( Id, Id, unsigned int ) const;
+	void put ( Id, Id, unsigned int, bool, W );
+	void erase ( Id, Id, unsigned int );
+	std::set<Id> nbrs ( Id, unsigned char, bool, unsigned int ) const;
+	bool linked ( Id, Id, unsigned char ) const;
+	bool linked ( Id, unsigned char ) const;
+public:
+	// not to be changed while the graph is shared
+	bool directed;
+	W no_relationship;
+
+	// constructors, destructor
+	explicit BasicConcurrentGraph ( bool dir=true, W x=0,
+		size_t num_stripes=0 );
+	explicit BasicConcurrentGraph ( const G&, size_t num_stripes=0 );
+	~BasicConcurrentGraph ();
+
+	// whole graph
+	G graph () const;
+	size_t num_stripes () const;
+
+	// keys
+	KeyID key_id ( const K& ) const;
+	KeyID intern ( const K& );
+	const K& key_name ( KeyID ) const;
+	size_t num_keys () const;
+
+	// operations, as on Graph
+	size_t size () const;
+	size_t num_edges () const;
+	std::set<Id> nbrs ( Id, const K& ) const;
+	std::set<Id> nbrs ( Id, KeyID ) const;
+	std::set<Id> nbrs ( Id ) const;
+	std::set<Id> nbrs_from ( Id, const K& ) const;
+	std::set<Id> nbrs_from ( Id, KeyID ) const;
+	std::set<Id> nbrs_from ( Id ) const;
+	bool contains ( Id, Id, const K&, bool ) const;
+	bool contains ( Id, Id, KeyID, bool ) const;
+	bool contains_dir ( Id, Id, const K& ) const;
+	bool contains_dir ( Id, Id, KeyID ) const;
+	bool contains_undir ( Id, Id, const K& ) const;
+	bool contains_undir ( Id, Id, KeyID ) const;
+	bool contains ( Id, Id, const K& ) const;
+	bool contains ( Id, Id, KeyID ) const;
+	bool contains_dir ( Id, Id ) const;
+	bool contains_undir ( Id, Id ) const;
+	bool contains ( Id, Id ) const;
+	bool contains_dir ( Id ) const;
+	bool contains_undir ( Id ) const;
+	bool contains ( Id ) const;
+	W get ( Id, Id, const K& ) const;
+	W get ( Id, Id, KeyID ) const;
+	W get ( Id, Id ) const;
+	void set ( Id, Id, const K&, bool, W );
+	void set ( Id, Id, KeyID, bool, W );
+	void set ( Id, Id, const K&, W );
+	void set ( Id, Id, KeyID, W );
+	void set_dir ( Id, Id, const K&, W );
+	void set_dir ( Id, Id, KeyID, W );
+	void set_undir ( Id, Id, const K&, W );
+	void set_undir ( Id, Id, KeyID, W );
+	void set ( Id, Id, W );
+	void set_dir ( Id, Id, W );
+	void set_undir ( Id, Id, W );
+	void clear ( Id, Id, const K&, bool );
+	void clear ( Id, Id, KeyID, bool );
+	void clear_dir ( Id, Id, const K& );
+	void clear_dir ( Id, Id, KeyID );
+	void clear_undir ( Id, Id, const K& );
+	void clear_undir ( Id, Id, KeyID );
+	void clear ( Id, Id, const K& );
+	void clear ( Id, Id, KeyID );
+	void clear ( Id );
+	void clear ();
+}; // BasicConcurrentGraph
+
+// A Graph that many threads may change at once.
+typedef BasicConcurrentGraph<int, std::string, float> ConcurrentGraph;
+
+template <class Id, class K, class W, class S>
+const unsigned char BasicConcurrentGraph<Id,K,W,S>::UNDIRECTED = 0;
+template <class Id, class K, class W, class S>
+const unsigned char BasicConcurrentGraph<Id,K,W,S>::FROM = 1;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Start an empty graph. With num_stripes = 0 there are 16 stripes for
+// each hardware thread; the number is rounded up to a power of two.
+// More stripes make it less likely that two threads want the same one.
+template <class Id, class K, class W, class S>
+BasicConcurrentGraph<Id,K,W,S>::BasicConcurrentGraph ( bool dir, W x,
+	size_t num_stripes )
+: keys(0), directed(dir), no_relationship(x)
+{
+	init(num_stripes);
+	intern(K());
+}
+
+// Copy a graph, with its settings and KeyIDs.
+template <class Id, class K, class W, class S>
+BasicConcurrentGraph<Id,K,W,S>::BasicConcurrentGraph ( const G& g,
+	size_t num_stripes )
+: keys(0), directed(g.directed), no_relationship(g.no_relationship)
+{
+	init(num_stripes);
+	for ( size_t k = 0; k < g.num_keys(); ++k ) intern(g.key_name(KeyID(k)));
+
+	// every relationship, back-links included, as it is stored
+	typename G::VertexRange R = g.vertex_range();
+	for ( typename G::VertexIterator it = R.begin(); it != R.end(); ++it ) {
+		Stripe& T = *stripes[stripe(*it)];
+		NbrMap& V = T.rows[*it];
+		typename G::ArcRange E = g.edges(*it);
+		for ( typename G::ArcIterator at = E.begin(); at != E.end(); ++at ) {
+			typename G::Arc a = *at;
+			V[a.j][a.key.id] = Rel(a.out, a.out ? a.x : -1 * a.x);
+			if ( a.out ) ++T.m;
+		}
+		++T.n;
+	}
+}
+
+template <class Id, class K, class W, class S>
+BasicConcurrentGraph<Id,K,W,S>::~BasicConcurrentGraph () {}
+
+// Make the stripes.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::init ( size_t num_stripes )
+{
+	if ( num_stripes == 0 )
+		num_stripes = 16 * std::max(1u, std::thread::hardware_concurrency());
+	size_t n = 1;
+	while ( n < num_stripes ) n *= 2;
+	for ( size_t s = 0; s < n; ++s ) stripes.emplace_back(new Stripe);
+	mask = n - 1;
+}
+
+
+// STRIPES //////////////////////////////////////////////////////////
+
+// Get the stripe of vertex i. The hash is mixed with a different
+// constant than FlatHashMap's, so that the vertices of one stripe do
+// not crowd together in its hash map.
+template <class Id, class K, class W, class S>
+size_t BasicConcurrentGraph<Id,K,W,S>::stripe ( Id i ) const
+{
+	uint64_t h = (uint64_t)std::hash<Id>()(i) * 0xC2B2AE3D27D4EB4Full;
+	return (size_t)(h >> 32) & mask;
+}
+
+// Lock the stripes of i and j, in stripe order.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::hold ( Id i, Id j, Lock& a,
+	Lock& b ) const
+{
+	size_t s = stripe(i);
+	size_t t = stripe(j);
+	if ( t < s ) std::swap(s, t);
+	a = Lock(stripes[s]->lock);
+	if ( t != s ) b = Lock(stripes[t]->lock);
+}
+
+// Lock every stripe, in order.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::hold_all ( std::vector<Lock>& L ) const
+{
+	L.reserve(stripes.size());
+	for ( size_t s = 0; s < stripes.size(); ++s )
+		L.push_back(Lock(stripes[s]->lock));
+}
+
+// Get the relationship from i to j with key k, or null if there is
+// none. The stripe of i must be locked.
+template <class Id, class K, class W, class S>
+const typename BasicConcurrentGraph<Id,K,W,S>::Rel*
+BasicConcurrentGraph<Id,K,W,S>::rel ( Id i, Id j, unsigned int k ) const
+{
+	const VertexMap& V = stripes[stripe(i)]->rows;
+	typename VertexMap::const_iterator it = V.find(i);
+	if ( it == V.end() ) return 0;
+	typename NbrMap::const_iterator jt = it->second.find(j);
+	if ( jt == it->second.end() ) return 0;
+	typename RelMap::const_iterator kt = jt->second.find(k);
+	if ( kt == jt->second.end() ) return 0;
+	return &kt->second;
+}
+
+// Set the relationship from i to j with key k, creating it if it does
+// not exist. The stripe of i must be locked.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::put ( Id i, Id j, unsigned int k,
+	bool outward, W x )
+{
+	Stripe& T = *stripes[stripe(i)];
+	RelMap& N = T.rows[i][j];
+	T.n.store(T.rows.size(), std::memory_order_relaxed);
+	typename RelMap::iterator kt = N.find(k);
+	bool was = kt != N.end() && kt->second.first;
+	if ( outward && !was ) ++T.m;
+	if ( was && !outward ) --T.m;
+	if ( kt != N.end() ) kt->second = Rel(outward, x);
+	else N[k] = Rel(outward, x);
+}
+
+// Remove the relationship from i to j with key k, if there is one, and
+// j from i's neighbors and i from the graph if nothing is left. The
+// stripe of i must be locked.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::erase ( Id i, Id j, unsigned int k )
+{
+	Stripe& T = *stripes[stripe(i)];
+	typename VertexMap::iterator it = T.rows.find(i);
+	if ( it == T.rows.end() ) return;
+	typename NbrMap::iterator jt = it->second.find(j);
+	if ( jt == it->second.end() ) return;
+	typename RelMap::iterator kt = jt->second.find(k);
+	if ( kt == jt->second.end() ) return;
+	if ( kt->second.first ) --T.m;
+	jt->second.erase(kt);
+	if ( jt->second.size() == 0 ) it->second.erase(jt);
+	if ( it->second.size() == 0 ) {
+		T.rows.erase(it);
+		T.n.store(T.rows.size(), std::memory_order_relaxed);
+	}
+}
+
+
+// WHOLE GRAPH //////////////////////////////////////////////////////
+
+// Get an ordinary graph with the contents and KeyIDs of this one, as
+// of one moment: every stripe is locked while it is copied.
+template <class Id, class K, class W, class S>
+typename BasicConcurrentGraph<Id,K,W,S>::G
+BasicConcurrentGraph<Id,K,W,S>::graph () const
+{
+	std::vector<Lock> L;
+	hold_all(L);
+	const Keys& T = *keys.load(std::memory_order_acquire);
+	G g (directed, no_relationship);
+	for ( size_t k = 0; k < T.names.size(); ++k ) g.intern(T.names[k]);
+
+	std::vector<typename G::Edge> E;
+	for ( size_t s = 0; s < stripes.size(); ++s ) {
+		const VertexMap& V = stripes[s]->rows;
+		typename VertexMap::const_iterator it = V.begin();
+		for ( ; it != V.end(); ++it ) {
+			typename NbrMap::const_iterator jt = it->second.begin();
+			for ( ; jt != it->second.end(); ++jt ) {
+				typename RelMap::const_iterator kt = jt->second.begin();
+				for ( ; kt != jt->second.end(); ++kt ) {
+					if ( !kt->second.first ) continue;
+					E.push_back(typename G::Edge(it->first, jt->first,
+						T.names[kt->first], false, kt->second.second));
+				}
+			}
+		}
+	}
+	g.assign_edges(E.begin(), E.end());
+	return g;
+}
+
+// Get the number of lock stripes.
+template <class Id, class K, class W, class S>
+size_t BasicConcurrentGraph<Id,K,W,S>::num_stripes () const
+{
+	return stripes.size();
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of a key, or NO_KEY if the graph has never seen the key.
+// Takes no lock.
+template <class Id, class K, class W, class S>
+KeyID BasicConcurrentGraph<Id,K,W,S>::key_id ( const K& key ) const
+{
+	const Keys& T = *keys.load(std::memory_order_acquire);
+	typename std::map<K, unsigned int>::const_iterator it = T.ids.find(key);
+	if ( it == T.ids.end() ) return G::NO_KEY;
+	return KeyID(it->second);
+}
+
+// Get the ID of the key, interning it if it is new. A new key copies
+// the key table, so interning takes time in the number of keys; IDs
+// are never reused.
+template <class Id, class K, class W, class S>
+KeyID BasicConcurrentGraph<Id,K,W,S>::intern ( const K& key )
+{
+	if ( keys.load(std::memory_order_acquire) != 0 ) {
+		KeyID k = key_id(key);
+		if ( k != G::NO_KEY ) return k;
+	}
+
+	std::lock_guard<std::mutex> l (key_lock);
+	const Keys* T = keys.load(std::memory_order_acquire);
+	if ( T != 0 ) {
+		typename std::map<K, unsigned int>::const_iterator it =
+			T->ids.find(key);
+		if ( it != T->ids.end() ) return KeyID(it->second);
+	}
+	Keys* U = T == 0 ? new Keys : new Keys(*T);
+	tables.emplace_back(U);
+	unsigned int k = U->names.size();
+	U->names.push_back(key);
+	U->ids.insert(std::make_pair(key, k));
+	keys.store(U, std::memory_order_release);
+	return KeyID(k);
+}
+
+template <class Id, class K, class W, class S>
+const K& BasicConcurrentGraph<Id,K,W,S>::key_name ( KeyID k ) const
+{
+	return keys.load(std::memory_order_acquire)->names[k.id];
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicConcurrentGraph<Id,K,W,S>::num_keys () const
+{
+	return keys.load(std::memory_order_acquire)->names.size();
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of vertices represented in the graph.
+template <class Id, class K, class W, class S>
+size_t BasicConcurrentGraph<Id,K,W,S>::size () const
+{
+	size_t n = 0;
+	for ( size_t s = 0; s < stripes.size(); ++s )
+		n += stripes[s]->n.load(std::memory_order_relaxed);
+	return n;
+}
+
+// Get the number of relationships, as Graph::num_edges.
+template <class Id, class K, class W, class S>
+size_t BasicConcurrentGraph<Id,K,W,S>::num_edges () const
+{
+	size_t m = 0;
+	for ( size_t s = 0; s < stripes.size(); ++s )
+		m += stripes[s]->m.load(std::memory_order_relaxed);
+	return m;
+}
+
+// Get a set of neighbor IDs.
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs ( Id i,
+	unsigned char dir, bool limit_key, unsigned int key ) const
+{
+	std::set<Id> out;
+	Lock l (stripes[stripe(i)]->lock);
+	const VertexMap& V = stripes[stripe(i)]->rows;
+	typename VertexMap::const_iterator it = V.find(i);
+	if ( it == V.end() ) return out;
+
+	typename NbrMap::const_iterator jt = it->second.begin();
+	for ( ; jt != it->second.end(); ++jt ) {
+		const RelMap& N = jt->second;
+		typename RelMap::const_iterator kt = N.begin();
+		typename RelMap::const_iterator kend = N.end();
+		if ( limit_key ) {
+			kt = N.find(key);
+			if ( kt == kend ) continue;
+			kend = kt;
+			++kend;
+		}
+		for ( ; kt != kend; ++kt ) {
+			if ( dir == UNDIRECTED || kt->second.first ) {
+				out.insert(jt->first);
+				break;
+			}
+		}
+	}
+	return out;
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs ( Id i,
+	const K& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs ( Id i, KeyID key ) const
+{
+	return nbrs(i, UNDIRECTED, true, key.id);
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs ( Id i ) const
+{
+	return nbrs(i, UNDIRECTED, false, 0);
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs_from ( Id i,
+	const K& key ) const
+{
+	return nbrs_from(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs_from ( Id i,
+	KeyID key ) const
+{
+	return nbrs(i, FROM, true, key.id);
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicConcurrentGraph<Id,K,W,S>::nbrs_from ( Id i ) const
+{
+	return nbrs(i, FROM, false, 0);
+}
+
+// Returns true if the relationship exists for the given key.
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i, Id j,
+	const K& key, bool undir ) const
+{
+	return contains(i, j, key_id(key), undir);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i, Id j, KeyID key,
+	bool undir ) const
+{
+	Lock l (stripes[stripe(i)]->lock);
+	const Rel* R = rel(i, j, key.id);
+	return R != 0 && (undir || R->first);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_dir ( Id i, Id j,
+	const K& key ) const
+{
+	return contains(i, j, key, false);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_dir ( Id i, Id j,
+	KeyID key ) const
+{
+	return contains(i, j, key, false);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_undir ( Id i, Id j,
+	const K& key ) const
+{
+	return contains(i, j, key, true);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_undir ( Id i, Id j,
+	KeyID key ) const
+{
+	return contains(i, j, key, true);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i, Id j,
+	const K& key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i, Id j,
+	KeyID key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+// Returns true if any relationship exists between i and j, toward j
+// only (FROM) or either way (UNDIRECTED).
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::linked ( Id i, Id j,
+	unsigned char dir ) const
+{
+	Lock l (stripes[stripe(i)]->lock);
+	const VertexMap& V = stripes[stripe(i)]->rows;
+	typename VertexMap::const_iterator it = V.find(i);
+	if ( it == V.end() ) return false;
+	typename NbrMap::const_iterator jt = it->second.find(j);
+	if ( jt == it->second.end() ) return false;
+	if ( dir == UNDIRECTED ) return true;
+	typename RelMap::const_iterator kt = jt->second.begin();
+	for ( ; kt != jt->second.end(); ++kt )
+		if ( kt->second.first ) return true;
+	return false;
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_dir ( Id i, Id j ) const
+{
+	return linked(i, j, FROM);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_undir ( Id i, Id j ) const
+{
+	return linked(i, j, UNDIRECTED);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i, Id j ) const
+{
+	return linked(i, j, directed ? FROM : UNDIRECTED);
+}
+
+// Returns true if a relationship exists from i toward any vertex
+// (FROM), or with any vertex (UNDIRECTED).
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::linked ( Id i, unsigned char dir ) const
+{
+	Lock l (stripes[stripe(i)]->lock);
+	const VertexMap& V = stripes[stripe(i)]->rows;
+	typename VertexMap::const_iterator it = V.find(i);
+	if ( it == V.end() ) return false;
+	if ( dir == UNDIRECTED ) return true;
+	typename NbrMap::const_iterator jt = it->second.begin();
+	for ( ; jt != it->second.end(); ++jt ) {
+		typename RelMap::const_iterator kt = jt->second.begin();
+		for ( ; kt != jt->second.end(); ++kt )
+			if ( kt->second.first ) return true;
+	}
+	return false;
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_dir ( Id i ) const
+{
+	return linked(i, FROM);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains_undir ( Id i ) const
+{
+	return linked(i, UNDIRECTED);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicConcurrentGraph<Id,K,W,S>::contains ( Id i ) const
+{
+	return linked(i, directed ? FROM : UNDIRECTED);
+}
+
+// Get the value of the relationship, negative if it only exists from
+// j toward i, or no_relationship if it does not exist.
+template <class Id, class K, class W, class S>
+W BasicConcurrentGraph<Id,K,W,S>::get ( Id i, Id j, const K& key ) const
+{
+	return get(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+W BasicConcurrentGraph<Id,K,W,S>::get ( Id i, Id j, KeyID key ) const
+{
+	Lock l (stripes[stripe(i)]->lock);
+	const Rel* R = rel(i, j, key.id);
+	if ( R == 0 ) return no_relationship;
+	return R->first ? R->second : -1 * R->second;
+}
+
+template <class Id, class K, class W, class S>
+W BasicConcurrentGraph<Id,K,W,S>::get ( Id i, Id j ) const
+{
+	return get(i, j, KeyID());
+}
+
+// Undirected if undir == true. Both sides of the relationship are made
+// while the stripes of i and j are locked. A KeyID the graph did not
+// issue, such as NO_KEY, sets nothing.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set ( Id i, Id j, const K& key,
+	bool undir, W x )
+{
+	set(i, j, intern(key), undir, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set ( Id i, Id j, KeyID key,
+	bool undir, W x )
+{
+	if ( key.id >= num_keys() ) return;
+
+	// check for no-relationship value
+	if ( fabs(x - no_relationship) < 0.0000001 ) {
+		clear(i, j, key, undir);
+		return;
+	}
+
+	Lock a, b;
+	hold(i, j, a, b);
+	put(i, j, key.id, true, x);
+	if ( undir ) put(j, i, key.id, true, x);
+	else {
+		const Rel* R = rel(j, i, key.id);
+		if ( R == 0 || !R->first ) put(j, i, key.id, false, x);
+	}
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set ( Id i, Id j, const K& key, W x )
+{
+	set(i, j, key, !directed, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set ( Id i, Id j, KeyID key, W x )
+{
+	set(i, j, key, !directed, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_dir ( Id i, Id j, const K& key,
+	W x )
+{
+	set(i, j, key, false, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_dir ( Id i, Id j, KeyID key, W x )
+{
+	set(i, j, key, false, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_undir ( Id i, Id j, const K& key,
+	W x )
+{
+	set(i, j, key, true, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_undir ( Id i, Id j, KeyID key,
+	W x )
+{
+	set(i, j, key, true, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set ( Id i, Id j, W x )
+{
+	set(i, j, KeyID(), !directed, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_dir ( Id i, Id j, W x )
+{
+	set(i, j, KeyID(), false, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::set_undir ( Id i, Id j, W x )
+{
+	set(i, j, KeyID(), true, x);
+}
+
+// Remove the relationship, as Graph::clear: a relationship that also
+// points back from j is only turned around unless undir is true.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ( Id i, Id j, const K& key,
+	bool undir )
+{
+	clear(i, j, key_id(key), undir);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ( Id i, Id j, KeyID key,
+	bool undir )
+{
+	Lock a, b;
+	hold(i, j, a, b);
+	unsigned int k = key.id;
+	const Rel* R = rel(i, j, k);
+	if ( R == 0 ) return;
+	const Rel* B = rel(j, i, k);
+
+	if ( undir || (R->first && (i == j || !B->first)) ) {
+		erase(i, j, k);
+		erase(j, i, k);
+	}
+	else if ( R->first ) put(i, j, k, false, B->second);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear_dir ( Id i, Id j,
+	const K& key )
+{
+	clear(i, j, key, false);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear_dir ( Id i, Id j, KeyID key )
+{
+	clear(i, j, key, false);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear_undir ( Id i, Id j,
+	const K& key )
+{
+	clear(i, j, key, true);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear_undir ( Id i, Id j, KeyID key )
+{
+	clear(i, j, key, true);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ( Id i, Id j, const K& key )
+{
+	clear(i, j, key, !directed);
+}
+
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ( Id i, Id j, KeyID key )
+{
+	clear(i, j, key, !directed);
+}
+
+// Remove vertex i and all of its relationships. Locks the stripes of
+// i and its neighbors, in order; if a neighbor in another stripe was
+// added before they were all locked, tries again.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ( Id i )
+{
+	Stripe& T = *stripes[stripe(i)];
+	for ( ; ; ) {
+		std::vector<size_t> want (1, stripe(i));
+		{
+			Lock l (T.lock);
+			typename VertexMap::const_iterator it = T.rows.find(i);
+			if ( it == T.rows.end() ) return;
+			typename NbrMap::const_iterator jt = it->second.begin();
+			for ( ; jt != it->second.end(); ++jt )
+				want.push_back(stripe(jt->first));
+		}
+		std::sort(want.begin(), want.end());
+		want.erase(std::unique(want.begin(), want.end()), want.end());
+		std::vector<Lock> L;
+		for ( size_t s = 0; s < want.size(); ++s )
+			L.push_back(Lock(stripes[want[s]]->lock));
+
+		typename VertexMap::iterator it = T.rows.find(i);
+		if ( it == T.rows.end() ) return;
+		std::vector<Id> N;
+		typename NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) N.push_back(jt->first);
+		bool held = true;
+		for ( size_t n = 0; n < N.size() && held; ++n )
+			held = std::binary_search(want.begin(), want.end(), stripe(N[n]));
+		if ( !held ) continue;
+
+		// the back-links and relationships toward i, then i
+		for ( size_t n = 0; n < N.size(); ++n ) {
+			if ( N[n] == i ) continue;
+			it = T.rows.find(i);
+			std::vector<unsigned int> ks;
+			const RelMap& R = it->second.find(N[n])->second;
+			typename RelMap::const_iterator kt = R.begin();
+			for ( ; kt != R.end(); ++kt ) ks.push_back(kt->first);
+			for ( size_t k = 0; k < ks.size(); ++k ) {
+				erase(N[n], i, ks[k]);
+				erase(i, N[n], ks[k]);
+			}
+		}
+		it = T.rows.find(i);
+		if ( it != T.rows.end() ) {
+			std::vector<unsigned int> ks;
+			const RelMap& R = it->second.begin()->second;
+			typename RelMap::const_iterator kt = R.begin();
+			for ( ; kt != R.end(); ++kt ) ks.push_back(kt->first);
+			for ( size_t k = 0; k < ks.size(); ++k ) erase(i, i, ks[k]);
+		}
+		return;
+	}
+}
+
+// Remove all vertices and relationships.
+template <class Id, class K, class W, class S>
+void BasicConcurrentGraph<Id,K,W,S>::clear ()
+{
+	std::vector<Lock> L;
+	hold_all(L);
+	for ( size_t s = 0; s < stripes.size(); ++s ) {
+		stripes[s]->rows.clear();
+		stripes[s]->n = 0;
+		stripes[s]->m = 0;
+	}
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_CONCURRENTGRAPH_20261015
@@ -0,0 +1,1290 @@
+/////////////////////////////////////////////////////////////////////
+// Frozen, read-only snapshot of a Graph in compressed sparse row  //
+// (CSR) form. Outgoing and incoming relationships are packed into //
+// contiguous offset/neighbor/key/value arrays so that reads do    //
+// not chase map nodes. Queries have the same meaning as on the    //
+// Graph the snapshot was taken from.                              //
+//                                                                 //
+// The arrays live in a single image laid out exactly as the       //
+// binary file format, so a snapshot is saved by writing the image //
+// and loaded, or memory-mapped, without parsing it.               //
+//                                                                 //
+// A snapshot never changes, so any number of threads may query it //
+// at once. The batch queries spread their work over a ThreadPool. //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// - arrays moved into a shared image in the file layout; added    //
+//   save, load, map, and thaw.                                    //
+// - added batch queries over a ThreadPool (ThreadPool.hpp).       //
+// - added from_edge_list, building a snapshot from Edge records   //
+//   in parallel.                                                  //
+// - load and map check the sections of a file before using them.  //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- FILE FORMAT (VERSION 1) ------------------------------------ //
+// Values are in the writer's byte order, which is recorded so     //
+// that a reader with another order rejects the file. Sections     //
+// start on 8-byte boundaries, at the offsets in the header.       //
+//                                                                 //
+//   header     Header, below                                      //
+//   ids        int32[n], sorted vertex IDs; row r is ids[r]       //
+//   out_off    uint64[n+1], row r is [out_off[r], out_off[r+1])   //
+//   out_nbr    uint32[m], row the relationship points toward      //
+//   out_key    uint32[m], key ID                                  //
+//   out_val    float[m], value                                    //
+//   in_off     uint64[n+1]                                        //
+//   in_nbr     uint32[m], row the relationship points from        //
+//   in_key     uint32[m]                                          //
+//   in_val     float[m]                                           //
+//   key_off    uint64[keys+1], key k is chars [off[k], off[k+1])  //
+//   key_chars  char[key_off[keys]]                                //
+//                                                                 //
+// Rows are sorted by (nbr, key). out_* holds the relationships a  //
+// Graph flags FROM, and in_* those it flags TO.                   //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_CSRGRAPH_20261014
+#define YOUNG_GIS_CSRGRAPH_20261014
+
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bygis { // Brennan Young GIS namespace
+
+class CsrGraph {
+private:
+	static const char MAGIC[8];
+	static const uint32_t VERSION;
+	static const uint32_t ORDER;
+	
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t order;             // ORDER, as written
+		uint32_t directed;
+		float no_relationship;
+		uint64_t n, m, keys;
+		uint64_t ids, out_off, out_nbr, out_key, out_val;
+		uint64_t in_off, in_nbr, in_key, in_val;
+		uint64_t key_off, key_chars;
+		uint64_t bytes;             // size of the whole image
+	};
+	
+	// Memory holding an image, either allocated or mapped from a file.
+	// Copies of a snapshot share it, since it never changes.
+	class Image {
+	private:
+		Image ( const Image& );
+		Image& operator= ( const Image& );
+	public:
+		char* base;
+		size_t bytes;
+		bool mapped;
+		
+		explicit Image ( size_t );
+		Image ( char*, size_t );
+		~Image ();
+	}; // Image
+	
+	std::shared_ptr<const Image> image;
+	
+	// views into the image; row r describes vertex ids[r], and
+	// relationships (r -> nbr) are in out_*, (nbr -> r) in in_*
+	size_t n, m;
+	const int32_t* ids;
+	const uint64_t* out_off;
+	const uint32_t* out_nbr_;
+	const uint32_t* out_key_;
+	const float* out_val_;
+	const uint64_t* in_off;
+	const uint32_t* in_nbr_;
+	const uint32_t* in_key_;
+	const float* in_val_;
+	
+	std::vector<std::string> key_names;
+	
+	// a relationship during a parallel build: from vertex i to j, or
+	// from row r to row c, set by record seq (or removed, if !out)
+	struct BuildArc {
+		int32_t i, j;
+		uint32_t k;
+		float x;
+		uint64_t seq;
+		bool out;
+		bool operator< ( const BuildArc& a ) const {
+			if ( i != a.i ) return i < a.i;
+			if ( j != a.j ) return j < a.j;
+			if ( k != a.k ) return k < a.k;
+			return seq < a.seq;
+		}
+	};
+	struct BuildIn {
+		uint32_t c, r, k;
+		float x;
+		bool operator< ( const BuildIn& a ) const {
+			if ( c != a.c ) return c < a.c;
+			if ( r != a.r ) return r < a.r;
+			return k < a.k;
+		}
+	};
+	
+	static uint64_t layout ( Header&, uint64_t, uint64_t, uint64_t,
+		uint64_t );
+	static bool valid ( const Header&, const char* );
+	bool attach ( const std::shared_ptr<const Image>&, bool check=true );
+	
+	size_t find ( const uint32_t*, const uint32_t*, size_t, size_t,
+		uint32_t, uint32_t ) const;
+	bool has_nbr ( const uint32_t*, size_t, size_t, uint32_t ) const;
+	std::set<int> nbrs ( int, unsigned char, bool, unsigned int ) const;
+	std::vector<std::set<int> > nbrs_many ( const std::vector<int>&,
+		unsigned char, bool, unsigned int, ThreadPool& ) const;
+public:
+	static const size_t NO_INDEX;
+	
+	bool directed;
+	float no_relationship;
+	
+	// constructors, destructor
+	CsrGraph ();
+	explicit CsrGraph ( const Graph& );
+	~CsrGraph ();
+	template <class It>
+	static CsrGraph from_edge_list ( It, It, ThreadPool&, bool dir=true,
+		float x=0 );
+	
+	// persistence
+	bool save ( const std::string& ) const;
+	bool load ( const std::string& );
+	bool map ( const std::string&, bool check=true );
+	bool is_mapped () const;
+	Graph thaw () const;
+	
+	// keys
+	KeyID key_id ( const std::string& ) const;
+	const std::string& key_name ( KeyID ) const;
+	size_t num_keys () const;
+	
+	// rows and edges
+	size_t index ( int ) const;
+	int vertex ( size_t ) const;
+	size_t num_out () const;
+	size_t num_in () const;
+	size_t out_begin ( size_t ) const;
+	size_t out_end ( size_t ) const;
+	size_t in_begin ( size_t ) const;
+	size_t in_end ( size_t ) const;
+	size_t out_nbr ( size_t ) const;
+	size_t in_nbr ( size_t ) const;
+	KeyID out_key ( size_t ) const;
+	KeyID in_key ( size_t ) const;
+	float out_val ( size_t ) const;
+	float in_val ( size_t ) const;
+	
+	// operations, as on Graph
+	size_t size () const;
+	std::set<int> nbrs ( int, const std::string& ) const;
+	std::set<int> nbrs ( int, KeyID ) const;
+	std::set<int> nbrs ( int ) const;
+	std::set<int> nbrs_to ( int, const std::string& ) const;
+	std::set<int> nbrs_to ( int, KeyID ) const;
+	std::set<int> nbrs_to ( int ) const;
+	std::set<int> nbrs_from ( int, const std::string& ) const;
+	std::set<int> nbrs_from ( int, KeyID ) const;
+	std::set<int> nbrs_from ( int ) const;
+	std::set<int> vertices () const;
+	std::set<std::string> keys () const;
+	std::set<std::string> keys ( int ) const;
+	std::set<std::string> keys ( int, int ) const;
+	bool contains ( int, int, const std::string&, bool ) const;
+	bool contains ( int, int, KeyID, bool ) const;
+	bool contains_dir ( int, int, const std::string& ) const;
+	bool contains_dir ( int, int, KeyID ) const;
+	bool contains_undir ( int, int, const std::string& ) const;
+	bool contains_undir ( int, int, KeyID ) const;
+	bool contains ( int, int, const std::string& ) const;
+	bool contains ( int, int, KeyID ) const;
+	bool contains_dir ( int, int ) const;
+	bool contains_undir ( int, int ) const;
+	bool contains ( int, int ) const;
+	bool contains_dir ( int ) const;
+	bool contains_undir ( int ) const;
+	bool contains ( int ) const;
+	float get ( int, int, const std::string& ) const;
+	float get ( int, int, KeyID ) const;
+	float get ( int, int ) const;
+	
+	// batch queries
+	std::vector<float> get_many ( const std::vector<std::pair<int, int> >&,
+		const std::string&, ThreadPool& ) const;
+	std::vector<float> get_many ( const std::vector<std::pair<int, int> >&,
+		KeyID, ThreadPool& ) const;
+	std::vector<float> get_many ( const std::vector<std::pair<int, int> >&,
+		ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_many ( const std::vector<int>&,
+		const std::string&, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_many ( const std::vector<int>&,
+		KeyID, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_many ( const std::vector<int>&,
+		ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_to_many ( const std::vector<int>&,
+		const std::string&, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_to_many ( const std::vector<int>&,
+		KeyID, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_to_many ( const std::vector<int>&,
+		ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_from_many ( const std::vector<int>&,
+		const std::string&, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_from_many ( const std::vector<int>&,
+		KeyID, ThreadPool& ) const;
+	std::vector<std::set<int> > nbrs_from_many ( const std::vector<int>&,
+		ThreadPool& ) const;
+}; // CsrGraph
+
+const char CsrGraph::MAGIC[8] = { 'B','Y','G','I','S','C','S','R' };
+const uint32_t CsrGraph::VERSION = 1;
+const uint32_t CsrGraph::ORDER = 0x01020304;
+const size_t CsrGraph::NO_INDEX = ~(size_t)0;
+
+
+// IMAGE ////////////////////////////////////////////////////////////
+
+CsrGraph::Image::Image ( size_t b )
+: base(static_cast<char*>(::operator new(b))), bytes(b), mapped(false)
+{
+	memset(base, 0, bytes);
+}
+
+CsrGraph::Image::Image ( char* p, size_t b )
+: base(p), bytes(b), mapped(true)
+{}
+
+CsrGraph::Image::~Image ()
+{
+#ifndef _WIN32
+	if ( mapped ) {
+		munmap(base, bytes);
+		return;
+	}
+#endif
+	::operator delete(base);
+}
+
+// Set the identification and section offsets of a header for n rows,
+// m relationships, and the given number of keys and key characters.
+// Returns the size of the image.
+uint64_t CsrGraph::layout ( Header& h, uint64_t n, uint64_t m,
+	uint64_t keys, uint64_t chars )
+{
+	memcpy(h.magic, MAGIC, sizeof(h.magic));
+	h.version = VERSION;
+	h.order = ORDER;
+	h.n = n;
+	h.m = m;
+	h.keys = keys;
+	
+	uint64_t* section[] = { &h.ids, &h.out_off, &h.out_nbr, &h.out_key,
+		&h.out_val, &h.in_off, &h.in_nbr, &h.in_key, &h.in_val,
+		&h.key_off, &h.key_chars };
+	uint64_t bytes[] = { 4 * n, 8 * (n + 1), 4 * m, 4 * m, 4 * m,
+		8 * (n + 1), 4 * m, 4 * m, 4 * m, 8 * (keys + 1), chars };
+	uint64_t at = sizeof(Header);
+	for ( size_t s = 0; s < 11; ++s ) {
+		*section[s] = at;
+		at = (at + bytes[s] + 7) / 8 * 8;
+	}
+	h.bytes = at;
+	return at;
+}
+
+// True if the sections of an image with header h, at b, can be
+// queried safely: ids sorted, offsets running from 0 to m without
+// going back, each row sorted by (nbr, key), and every neighbor a row
+// and every key ID a key. Takes time in proportion to n + m.
+bool CsrGraph::valid ( const Header& h, const char* b )
+{
+	const int32_t* id = (const int32_t*)(b + h.ids);
+	for ( uint64_t r = 1; r < h.n; ++r )
+		if ( id[r - 1] >= id[r] ) return false;
+	
+	uint64_t offs[] = { h.out_off, h.in_off };
+	uint64_t nbrs[] = { h.out_nbr, h.in_nbr };
+	uint64_t keys[] = { h.out_key, h.in_key };
+	for ( size_t s = 0; s < 2; ++s ) {
+		const uint64_t* off = (const uint64_t*)(b + offs[s]);
+		const uint32_t* nbr = (const uint32_t*)(b + nbrs[s]);
+		const uint32_t* key = (const uint32_t*)(b + keys[s]);
+		if ( off[0] != 0 || off[h.n] != h.m ) return false;
+		for ( uint64_t r = 0; r < h.n; ++r ) {
+			if ( off[r] > off[r + 1] ) return false;
+			for ( uint64_t e = off[r]; e < off[r + 1]; ++e ) {
+				if ( nbr[e] >= h.n || key[e] >= h.keys ) return false;
+				if ( e > off[r] && (nbr[e - 1] > nbr[e]
+						|| (nbr[e - 1] == nbr[e] && key[e - 1] >= key[e])) )
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Point the views at the sections of an image, after checking that
+// its header describes an image of this version and size and, if
+// check, that its sections are valid. Returns false (and leaves the
+// snapshot unchanged) if it does not. Images this class built itself
+// are attached without the check.
+bool CsrGraph::attach ( const std::shared_ptr<const Image>& img, bool check )
+{
+	Header h;
+	if ( img->bytes < sizeof(Header) ) return false;
+	memcpy(&h, img->base, sizeof(Header));
+	if ( memcmp(h.magic, MAGIC, sizeof(h.magic)) != 0
+			|| h.version != VERSION || h.order != ORDER
+			|| h.n >= img->bytes || h.m >= img->bytes
+			|| h.keys >= img->bytes || h.bytes != img->bytes )
+		return false;
+	
+	// the sections must be where this version puts them
+	const char* b = img->base;
+	Header e;
+	e.directed = h.directed;
+	e.no_relationship = h.no_relationship;
+	if ( layout(e, h.n, h.m, h.keys, 0) > img->bytes ) return false;
+	const uint64_t* key_off = (const uint64_t*)(b + e.key_off);
+	layout(e, h.n, h.m, h.keys, key_off[h.keys]);
+	if ( memcmp(&e, &h, sizeof(Header)) != 0 ) return false;
+	if ( key_off[0] != 0 ) return false;
+	for ( size_t k = 0; k < h.keys; ++k )
+		if ( key_off[k] > key_off[k + 1] ) return false;
+	if ( check && !valid(h, b) ) return false;
+	
+	// the keys are the only part that is copied
+	std::vector<std::string> names (h.keys);
+	for ( size_t k = 0; k < h.keys; ++k ) {
+		names[k].assign(b + h.key_chars + key_off[k],
+			key_off[k + 1] - key_off[k]);
+	}
+	
+	image = img;
+	n = h.n;
+	m = h.m;
+	ids = (const int32_t*)(b + h.ids);
+	out_off = (const uint64_t*)(b + h.out_off);
+	out_nbr_ = (const uint32_t*)(b + h.out_nbr);
+	out_key_ = (const uint32_t*)(b + h.out_key);
+	out_val_ = (const float*)(b + h.out_val);
+	in_off = (const uint64_t*)(b + h.in_off);
+	in_nbr_ = (const uint32_t*)(b + h.in_nbr);
+	in_key_ = (const uint32_t*)(b + h.in_key);
+	in_val_ = (const float*)(b + h.in_val);
+	key_names.swap(names);
+	directed = h.directed != 0;
+	no_relationship = h.no_relationship;
+	return true;
+}
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+CsrGraph::CsrGraph ()
+{
+	Header h;
+	memset(&h, 0, sizeof(h));
+	std::shared_ptr<Image> img (new Image(layout(h, 0, 0, 1, 0)));
+	h.directed = 1;
+	h.no_relationship = 0;
+	memcpy(img->base, &h, sizeof(h));
+	attach(img, false);
+}
+
+CsrGraph::CsrGraph ( const Graph& g )
+{
+	// count
+	uint64_t rows = g.data.size(), rels = 0, chars = 0;
+	Graph::VertexMap::const_iterator it = g.data.begin();
+	for ( ; it != g.data.end(); ++it ) {
+		Graph::NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) {
+			Graph::RelMap::const_iterator kt = jt->second.begin();
+			for ( ; kt != jt->second.end(); ++kt )
+				if ( kt->second.first ) ++rels;
+		}
+	}
+	for ( size_t k = 0; k < g.key_names.size(); ++k )
+		chars += g.key_names[k].size();
+	
+	Header h;
+	memset(&h, 0, sizeof(h));
+	std::shared_ptr<Image> img (new Image(
+		layout(h, rows, rels, g.key_names.size(), chars)));
+	h.directed = g.directed;
+	h.no_relationship = g.no_relationship;
+	char* b = img->base;
+	memcpy(b, &h, sizeof(h));
+	int32_t* row_id = (int32_t*)(b + h.ids);
+	uint64_t* o_off = (uint64_t*)(b + h.out_off);
+	uint32_t* o_nbr = (uint32_t*)(b + h.out_nbr);
+	uint32_t* o_key = (uint32_t*)(b + h.out_key);
+	float* o_val = (float*)(b + h.out_val);
+	uint64_t* i_off = (uint64_t*)(b + h.in_off);
+	uint32_t* i_nbr = (uint32_t*)(b + h.in_nbr);
+	uint32_t* i_key = (uint32_t*)(b + h.in_key);
+	float* i_val = (float*)(b + h.in_val);
+	
+	// rows
+	size_t r = 0;
+	for ( it = g.data.begin(); it != g.data.end(); ++it )
+		row_id[r++] = it->first;
+	
+	// outgoing, in row order; count incoming by row
+	size_t e = 0;
+	for ( it = g.data.begin(), r = 0; it != g.data.end(); ++it, ++r ) {
+		Graph::NbrMap::const_iterator jt = it->second.begin();
+		int32_t* lo = row_id;
+		for ( ; jt != it->second.end(); ++jt ) {
+			// neighbors are visited in increasing order
+			lo = std::lower_bound(lo, row_id + rows, jt->first);
+			uint32_t c = lo - row_id;
+			Graph::RelMap::const_iterator kt = jt->second.begin();
+			for ( ; kt != jt->second.end(); ++kt ) {
+				if ( !kt->second.first ) continue;
+				o_nbr[e] = c;
+				o_key[e] = kt->first;
+				o_val[e] = kt->second.second;
+				++i_off[c + 1];
+				++e;
+			}
+		}
+		o_off[r + 1] = e;
+	}
+	
+	// incoming, by transposing outgoing; rows are filled in
+	// increasing source order, so they come out sorted
+	for ( r = 0; r < rows; ++r ) i_off[r + 1] += i_off[r];
+	std::vector<uint64_t> at (i_off, i_off + rows);
+	for ( r = 0; r < rows; ++r ) {
+		for ( e = o_off[r]; e < o_off[r + 1]; ++e ) {
+			uint64_t f = at[o_nbr[e]]++;
+			i_nbr[f] = r;
+			i_key[f] = o_key[e];
+			i_val[f] = o_val[e];
+		}
+	}
+	
+	// keys
+	uint64_t* k_off = (uint64_t*)(b + h.key_off);
+	for ( size_t k = 0; k < g.key_names.size(); ++k ) {
+		const std::string& key = g.key_names[k];
+		memcpy(b + h.key_chars + k_off[k], key.data(), key.size());
+		k_off[k + 1] = k_off[k] + key.size();
+	}
+	
+	attach(img, false);
+}
+
+CsrGraph::~CsrGraph () {}
+
+// Make a snapshot from the Graph::Edge records in [first, last), a
+// random access range, using the pool's threads. The result is the
+// same as CsrGraph(Graph::from_edge_list(first, last, dir, x)),
+// keys and their IDs included, without building the graph: records
+// are split by source vertex into ranges of IDs, each range is sorted
+// and reduced to its last change to each relationship on its own,
+// and the ranges are written into their places in the arrays.
+template <class It>
+CsrGraph CsrGraph::from_edge_list ( It first, It last, ThreadPool& pool,
+	bool dir, float x )
+{
+	const size_t N = last - first;
+	const size_t P = 4 * pool.size();                 // parts of work
+	
+	// keys, interned in order of first use, as the graph would
+	std::vector<std::map<std::string, size_t> > seen (P);
+	pool.parallel_for(P, [&] ( size_t b, size_t e ) {
+		for ( size_t c = b; c < e; ++c ) {
+			for ( size_t t = N * c / P; t < N * (c + 1) / P; ++t )
+				seen[c].insert(std::make_pair(first[t].key, t));
+		}
+	});
+	std::vector<std::pair<size_t, std::string> > uses;
+	for ( size_t c = 0; c < P; ++c ) {
+		std::map<std::string, size_t>::const_iterator st = seen[c].begin();
+		for ( ; st != seen[c].end(); ++st )
+			uses.push_back(std::make_pair(st->second, st->first));
+	}
+	std::sort(uses.begin(), uses.end());
+	std::vector<std::string> names (1, std::string());
+	std::map<std::string, uint32_t> ids;
+	ids[std::string()] = 0;
+	for ( size_t u = 0; u < uses.size(); ++u ) {
+		if ( ids.insert(std::make_pair(uses[u].second,
+				(uint32_t)names.size())).second )
+			names.push_back(uses[u].second);
+	}
+	
+	// ranges of source IDs, split at a sample of them
+	std::vector<int32_t> split;
+	for ( size_t s = 0; s < std::min<size_t>(N, 64 * P); ++s ) {
+		const Graph::Edge& ed = first[N * s / std::min<size_t>(N, 64 * P)];
+		split.push_back(ed.i);
+		if ( ed.undir ) split.push_back(ed.j);
+	}
+	std::sort(split.begin(), split.end());
+	std::vector<int32_t> bound;                       // first ID of range
+	for ( size_t p = 1; p < P && !split.empty(); ++p )
+		bound.push_back(split[split.size() * p / P]);
+	const size_t R = bound.size() + 1;                // ranges
+	auto range_of = [&] ( int32_t v ) -> size_t {
+		return std::upper_bound(bound.begin(), bound.end(), v)
+			- bound.begin();
+	};
+	
+	// count the arcs of each part of the records in each range, and
+	// then place them, so that a range's arcs are together in order
+	std::vector<std::vector<size_t> > at (P, std::vector<size_t>(R, 0));
+	auto expand = [&] ( size_t c, bool place, std::vector<BuildArc>& A ) {
+		for ( size_t t = N * c / P; t < N * (c + 1) / P; ++t ) {
+			const Graph::Edge& ed = first[t];
+			BuildArc a;
+			a.i = ed.i;
+			a.j = ed.j;
+			a.k = ids.find(ed.key)->second;
+			a.x = ed.x;
+			a.seq = t;
+			a.out = fabs(ed.x - x) >= 0.0000001;
+			for ( int d = 0; d < (ed.undir && ed.i != ed.j ? 2 : 1); ++d ) {
+				if ( d == 1 ) std::swap(a.i, a.j);
+				size_t q = range_of(a.i);
+				if ( place ) A[at[c][q]++] = a;
+				else ++at[c][q];
+			}
+		}
+	};
+	std::vector<BuildArc> A;
+	pool.parallel_for(P, [&] ( size_t b, size_t e ) {
+		for ( size_t c = b; c < e; ++c ) expand(c, false, A);
+	});
+	std::vector<size_t> begin (R + 1, 0);
+	for ( size_t q = 0, s = 0; q < R; ++q ) {
+		begin[q] = s;
+		for ( size_t c = 0; c < P; ++c ) {
+			size_t n = at[c][q];
+			at[c][q] = s;
+			s += n;
+		}
+		begin[q + 1] = s;
+	}
+	A.resize(begin[R]);
+	pool.parallel_for(P, [&] ( size_t b, size_t e ) {
+		for ( size_t c = b; c < e; ++c ) expand(c, true, A);
+	});
+	
+	// sort each range and keep the last change to each arc, if it sets
+	// the arc; note each range's sources and, by range, its targets
+	std::vector<size_t> kept (R, 0);
+	std::vector<std::vector<int32_t> > rows (R);
+	std::vector<std::vector<std::vector<int32_t> > > targets (R,
+		std::vector<std::vector<int32_t> >(R));
+	pool.parallel_for(R, [&] ( size_t b, size_t e ) {
+		for ( size_t q = b; q < e; ++q ) {
+			BuildArc* a = A.data() + begin[q];
+			size_t n = begin[q + 1] - begin[q], m = 0;
+			std::sort(a, a + n);
+			for ( size_t t = 0; t < n; ++t ) {
+				if ( t + 1 < n && a[t].i == a[t + 1].i
+						&& a[t].j == a[t + 1].j && a[t].k == a[t + 1].k )
+					continue;
+				if ( !a[t].out ) continue;
+				a[m++] = a[t];
+				if ( rows[q].empty() || rows[q].back() != a[t].i )
+					rows[q].push_back(a[t].i);
+				targets[q][range_of(a[t].j)].push_back(a[t].j);
+			}
+			kept[q] = m;
+		}
+	});
+	
+	// the vertices of each range: its sources, and the targets in it
+	pool.parallel_for(R, [&] ( size_t b, size_t e ) {
+		for ( size_t q = b; q < e; ++q ) {
+			std::vector<int32_t>& V = rows[q];
+			for ( size_t p = 0; p < R; ++p )
+				V.insert(V.end(), targets[p][q].begin(), targets[p][q].end());
+			std::sort(V.begin(), V.end());
+			V.erase(std::unique(V.begin(), V.end()), V.end());
+		}
+	});
+	std::vector<size_t> row0 (R + 1, 0), out0 (R + 1, 0);
+	for ( size_t q = 0; q < R; ++q ) {
+		row0[q + 1] = row0[q] + rows[q].size();
+		out0[q + 1] = out0[q] + kept[q];
+	}
+	
+	uint64_t chars = 0;
+	for ( size_t k = 0; k < names.size(); ++k ) chars += names[k].size();
+	Header h;
+	memset(&h, 0, sizeof(h));
+	std::shared_ptr<Image> img (new Image(
+		layout(h, row0[R], out0[R], names.size(), chars)));
+	h.directed = dir;
+	h.no_relationship = x;
+	char* bs = img->base;
+	memcpy(bs, &h, sizeof(h));
+	int32_t* row_id = (int32_t*)(bs + h.ids);
+	uint64_t* o_off = (uint64_t*)(bs + h.out_off);
+	uint32_t* o_nbr = (uint32_t*)(bs + h.out_nbr);
+	uint32_t* o_key = (uint32_t*)(bs + h.out_key);
+	float* o_val = (float*)(bs + h.out_val);
+	uint64_t* i_off = (uint64_t*)(bs + h.in_off);
+	uint32_t* i_nbr = (uint32_t*)(bs + h.in_nbr);
+	uint32_t* i_key = (uint32_t*)(bs + h.in_key);
+	float* i_val = (float*)(bs + h.in_val);
+	const size_t n = row0[R];
+	pool.parallel_for(R, [&] ( size_t b, size_t e ) {
+		for ( size_t q = b; q < e; ++q )
+			std::copy(rows[q].begin(), rows[q].end(), row_id + row0[q]);
+	});
+	
+	// outgoing, each range in its place; then the incoming arcs of
+	// each range, from every range
+	std::vector<std::vector<size_t> > in_at (R, std::vector<size_t>(R, 0));
+	std::vector<size_t> in0 (R + 1, 0);
+	for ( size_t q = 0, s = 0; q < R; ++q ) {
+		in0[q] = s;
+		for ( size_t p = 0; p < R; ++p ) {
+			in_at[p][q] = s;
+			s += targets[p][q].size();
+		}
+		in0[q + 1] = s;
+	}
+	std::vector<BuildIn> B (in0[R]);
+	pool.parallel_for(R, [&] ( size_t b, size_t e ) {
+		for ( size_t q = b; q < e; ++q ) {
+			const BuildArc* a = A.data() + begin[q];
+			size_t r = row0[q], t = 0;
+			for ( ; r < row0[q + 1]; ++r ) {
+				for ( ; t < kept[q] && a[t].i == row_id[r]; ++t ) {
+					uint32_t c = std::lower_bound(row_id, row_id + n, a[t].j)
+						- row_id;
+					size_t f = out0[q] + t;
+					o_nbr[f] = c;
+					o_key[f] = a[t].k;
+					o_val[f] = a[t].x;
+					BuildIn& in = B[in_at[q][range_of(a[t].j)]++];
+					in.c = c;
+					in.r = r;
+					in.k = a[t].k;
+					in.x = a[t].x;
+				}
+				o_off[r + 1] = out0[q] + t;
+			}
+		}
+	});
+	pool.parallel_for(R, [&] ( size_t b, size_t e ) {
+		for ( size_t q = b; q < e; ++q ) {
+			BuildIn* in = B.data() + in0[q];
+			size_t m = in0[q + 1] - in0[q], t = 0;
+			std::sort(in, in + m);
+			for ( size_t r = row0[q]; r < row0[q + 1]; ++r ) {
+				for ( ; t < m && in[t].c == r; ++t ) {
+					i_nbr[in0[q] + t] = in[t].r;
+					i_key[in0[q] + t] = in[t].k;
+					i_val[in0[q] + t] = in[t].x;
+				}
+				i_off[r + 1] = in0[q] + t;
+			}
+		}
+	});
+	
+	// keys
+	uint64_t* k_off = (uint64_t*)(bs + h.key_off);
+	for ( size_t k = 0; k < names.size(); ++k ) {
+		memcpy(bs + h.key_chars + k_off[k], names[k].data(), names[k].size());
+		k_off[k + 1] = k_off[k] + names[k].size();
+	}
+	
+	CsrGraph g;
+	g.attach(img, false);
+	return g;
+}
+
+
+// PERSISTENCE //////////////////////////////////////////////////////
+
+// Write the snapshot to a file. Returns false if it could not be
+// written.
+bool CsrGraph::save ( const std::string& path ) const
+{
+	FILE* f = fopen(path.c_str(), "wb");
+	if ( f == 0 ) return false;
+	
+	// directed and no_relationship may have changed since the image
+	// was made
+	Header h;
+	memcpy(&h, image->base, sizeof(h));
+	h.directed = directed;
+	h.no_relationship = no_relationship;
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+	size_t rest = image->bytes - sizeof(h);
+	if ( ok && rest > 0 )
+		ok = fwrite(image->base + sizeof(h), rest, 1, f) == 1;
+	return fclose(f) == 0 && ok;
+}
+
+// Read a snapshot from a file written by save(). Returns false (and
+// leaves the snapshot unchanged) if the file could not be read or is
+// not a valid snapshot of this version.
+bool CsrGraph::load ( const std::string& path )
+{
+	FILE* f = fopen(path.c_str(), "rb");
+	if ( f == 0 ) return false;
+	bool ok = fseek(f, 0, SEEK_END) == 0;
+	long bytes = ok ? ftell(f) : -1;
+	ok = ok && bytes > 0 && fseek(f, 0, SEEK_SET) == 0;
+	std::shared_ptr<Image> img;
+	if ( ok ) {
+		img.reset(new Image(bytes));
+		ok = fread(img->base, bytes, 1, f) == 1;
+	}
+	fclose(f);
+	return ok && attach(img);
+}
+
+// Map a snapshot file written by save() into memory and answer
+// queries straight from the mapping; pages are read on demand, and
+// are shared with other processes mapping the same file. The file
+// must not change while it is mapped. Where mapping is not
+// available, reads the file as load() does. Returns false (and
+// leaves the snapshot unchanged) on failure. Checking the sections
+// reads every page of the file; with !check, a file that is trusted
+// opens without reading any, but a damaged one gives undefined
+// results.
+bool CsrGraph::map ( const std::string& path, bool check )
+{
+#ifdef _WIN32
+	(void)check;
+	return load(path);
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if ( fd < 0 ) return false;
+	struct stat st;
+	if ( fstat(fd, &st) != 0 || st.st_size <= 0 ) {
+		close(fd);
+		return false;
+	}
+	void* p = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if ( p == MAP_FAILED ) return false;
+	std::shared_ptr<Image> img (
+		new Image(static_cast<char*>(p), st.st_size));
+	return attach(img, check);
+#endif
+}
+
+// True if the snapshot is served from a memory-mapped file.
+bool CsrGraph::is_mapped () const
+{
+	return image->mapped;
+}
+
+// Make an editable Graph with the same contents and KeyIDs.
+Graph CsrGraph::thaw () const
+{
+	Graph g (directed, no_relationship);
+	g.key_names = key_names;
+	g.key_ids.clear();
+	for ( size_t k = 0; k < key_names.size(); ++k )
+		g.key_ids[key_names[k]] = k;
+	
+	// merge the outgoing and incoming relationships of each row, which
+	// are both sorted by (nbr, key); maps are filled in order
+	for ( size_t r = 0; r < n; ++r ) {
+		Graph::NbrMap& V = g.data.emplace_hint(g.data.end(),
+			std::piecewise_construct, std::forward_as_tuple(ids[r]),
+			std::forward_as_tuple())->second;
+		Graph::NbrMap::iterator jt = V.end();
+		size_t a = out_off[r], b = in_off[r];
+		while ( a < out_off[r + 1] || b < in_off[r + 1] ) {
+			bool out = b == in_off[r + 1] || (a < out_off[r + 1]
+				&& (out_nbr_[a] < in_nbr_[b] || (out_nbr_[a] == in_nbr_[b]
+				&& out_key_[a] <= in_key_[b])));
+			uint32_t c = out ? out_nbr_[a] : in_nbr_[b];
+			uint32_t k = out ? out_key_[a] : in_key_[b];
+			float x = out ? out_val_[a] : in_val_[b];
+			if ( jt == V.end() || jt->first != ids[c] ) {
+				jt = V.emplace_hint(V.end(), std::piecewise_construct,
+					std::forward_as_tuple(ids[c]), std::forward_as_tuple());
+			}
+			jt->second.emplace_hint(jt->second.end(), k, Graph::Rel(out, x));
+			
+			// as in the Graph, a relationship toward c hides the
+			// back-link of one from c with the same key
+			if ( out ) {
+				if ( b < in_off[r + 1] && in_nbr_[b] == c
+						&& in_key_[b] == k ) ++b;
+				++a;
+			}
+			else ++b;
+		}
+	}
+	g.reindex();
+	return g;
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of a key, or Graph::NO_KEY if the graph did not have it.
+// IDs are the same as those of the graph the snapshot was taken of.
+KeyID CsrGraph::key_id ( const std::string& key ) const
+{
+	std::vector<std::string>::const_iterator it =
+		std::find(key_names.begin(), key_names.end(), key);
+	if ( it == key_names.end() ) return Graph::NO_KEY;
+	return KeyID(it - key_names.begin());
+}
+
+const std::string& CsrGraph::key_name ( KeyID k ) const
+{
+	return key_names[k.id];
+}
+
+size_t CsrGraph::num_keys () const
+{
+	return key_names.size();
+}
+
+
+// ROWS AND EDGES ///////////////////////////////////////////////////
+
+// Get the row of vertex i, or NO_INDEX if it is not in the graph.
+size_t CsrGraph::index ( int i ) const
+{
+	const int32_t* it = std::lower_bound(ids, ids + n, i);
+	if ( it == ids + n || *it != i ) return NO_INDEX;
+	return it - ids;
+}
+
+// Get the vertex ID of row r.
+int CsrGraph::vertex ( size_t r ) const
+{
+	return ids[r];
+}
+
+// Get the number of outgoing (equivalently, incoming) relationships.
+size_t CsrGraph::num_out () const { return m; }
+size_t CsrGraph::num_in () const { return m; }
+
+// Range [begin, end) of the edges of row r.
+size_t CsrGraph::out_begin ( size_t r ) const { return out_off[r]; }
+size_t CsrGraph::out_end ( size_t r ) const { return out_off[r + 1]; }
+size_t CsrGraph::in_begin ( size_t r ) const { return in_off[r]; }
+size_t CsrGraph::in_end ( size_t r ) const { return in_off[r + 1]; }
+
+// Row of the other vertex of edge e, its key, and its value. The
+// value of an incoming edge is that of the relationship toward the
+// row, so in_val(e) is positive where get() would return -x.
+size_t CsrGraph::out_nbr ( size_t e ) const { return out_nbr_[e]; }
+size_t CsrGraph::in_nbr ( size_t e ) const { return in_nbr_[e]; }
+KeyID CsrGraph::out_key ( size_t e ) const { return KeyID(out_key_[e]); }
+KeyID CsrGraph::in_key ( size_t e ) const { return KeyID(in_key_[e]); }
+float CsrGraph::out_val ( size_t e ) const { return out_val_[e]; }
+float CsrGraph::in_val ( size_t e ) const { return in_val_[e]; }
+
+// Find the (c, k) edge in [a, b) of the given arrays, or NO_INDEX.
+size_t CsrGraph::find ( const uint32_t* nbr, const uint32_t* key,
+	size_t a, size_t b, uint32_t c, uint32_t k ) const
+{
+	size_t e = std::lower_bound(nbr + a, nbr + b, c) - nbr;
+	for ( ; e < b && nbr[e] == c; ++e ) {
+		if ( key[e] == k ) return e;
+		if ( key[e] > k ) break;
+	}
+	return NO_INDEX;
+}
+
+// True if c appears in [a, b) of the given neighbor array.
+bool CsrGraph::has_nbr ( const uint32_t* nbr, size_t a, size_t b,
+	uint32_t c ) const
+{
+	return std::binary_search(nbr + a, nbr + b, c);
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of vertices represented in the graph.
+size_t CsrGraph::size () const
+{
+	return n;
+}
+
+// Get a set of neighbor IDs.
+std::set<int> CsrGraph::nbrs ( int i, unsigned char dir,
+	bool limit_key, unsigned int key ) const
+{
+	std::set<int> out;
+	size_t r = index(i);
+	if ( r == NO_INDEX ) return out;
+	
+	size_t e;
+	if ( dir != Graph::TO ) {
+		for ( e = out_off[r]; e < out_off[r + 1]; ++e )
+			if ( !limit_key || out_key_[e] == key )
+				out.insert(out.end(), ids[out_nbr_[e]]);
+	}
+	if ( dir != Graph::FROM ) {
+		for ( e = in_off[r]; e < in_off[r + 1]; ++e )
+			if ( !limit_key || in_key_[e] == key )
+				out.insert(ids[in_nbr_[e]]);
+	}
+	return out;
+}
+
+std::set<int> CsrGraph::nbrs ( int i, const std::string& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+std::set<int> CsrGraph::nbrs ( int i, KeyID key ) const
+{
+	return nbrs(i, Graph::UNDIRECTED, true, key.id);
+}
+
+std::set<int> CsrGraph::nbrs ( int i ) const
+{
+	return nbrs(i, Graph::UNDIRECTED, false, 0);
+}
+
+std::set<int> CsrGraph::nbrs_to ( int i, const std::string& key ) const
+{
+	return nbrs_to(i, key_id(key));
+}
+
+std::set<int> CsrGraph::nbrs_to ( int i, KeyID key ) const
+{
+	return nbrs(i, Graph::TO, true, key.id);
+}
+
+std::set<int> CsrGraph::nbrs_to ( int i ) const
+{
+	return nbrs(i, Graph::TO, false, 0);
+}
+
+std::set<int> CsrGraph::nbrs_from (
+	int i, const std::string& key ) const
+{
+	return nbrs_from(i, key_id(key));
+}
+
+std::set<int> CsrGraph::nbrs_from ( int i, KeyID key ) const
+{
+	return nbrs(i, Graph::FROM, true, key.id);
+}
+
+std::set<int> CsrGraph::nbrs_from ( int i ) const
+{
+	return nbrs(i, Graph::FROM, false, 0);
+}
+
+// Returns a set of object IDs.
+std::set<int> CsrGraph::vertices () const
+{
+	return std::set<int>(ids, ids + n);
+}
+
+// Returns all of the keys in the graph.
+std::set<std::string> CsrGraph::keys () const
+{
+	std::vector<bool> used (key_names.size(), false);
+	for ( size_t e = 0; e < m; ++e ) used[out_key_[e]] = true;
+	
+	std::set<std::string> out;
+	for ( size_t k = 0; k < used.size(); ++k )
+		if ( used[k] ) out.insert(key_names[k]);
+	return out;
+}
+
+// Returns all of the keys associated with the vertex.
+std::set<std::string> CsrGraph::keys ( int i ) const
+{
+	std::set<std::string> out;
+	size_t r = index(i);
+	if ( r == NO_INDEX ) return out;
+	
+	size_t e;
+	for ( e = out_off[r]; e < out_off[r + 1]; ++e )
+		out.insert(key_names[out_key_[e]]);
+	for ( e = in_off[r]; e < in_off[r + 1]; ++e )
+		out.insert(key_names[in_key_[e]]);
+	return out;
+}
+
+// Returns a set of the relationship's keys or properties.
+std::set<std::string> CsrGraph::keys ( int i, int j ) const
+{
+	std::set<std::string> out;
+	size_t r = index(i);
+	size_t c = index(j);
+	if ( r == NO_INDEX || c == NO_INDEX ) return out;
+	
+	size_t e = std::lower_bound(out_nbr_ + out_off[r],
+		out_nbr_ + out_off[r + 1], c) - out_nbr_;
+	for ( ; e < out_off[r + 1] && out_nbr_[e] == c; ++e )
+		out.insert(key_names[out_key_[e]]);
+	e = std::lower_bound(in_nbr_ + in_off[r],
+		in_nbr_ + in_off[r + 1], c) - in_nbr_;
+	for ( ; e < in_off[r + 1] && in_nbr_[e] == c; ++e )
+		out.insert(key_names[in_key_[e]]);
+	return out;
+}
+
+// Returns true if the relationship exists for the given key.
+bool CsrGraph::contains (
+	int i, int j, const std::string& key, bool undir ) const
+{
+	return contains(i, j, key_id(key), undir);
+}
+
+bool CsrGraph::contains ( int i, int j, KeyID key, bool undir ) const
+{
+	size_t r = index(i);
+	size_t c = index(j);
+	if ( r == NO_INDEX || c == NO_INDEX ) return false;
+	
+	if ( find(out_nbr_, out_key_, out_off[r], out_off[r + 1], c,
+			key.id) != NO_INDEX )
+		return true;
+	return undir && find(in_nbr_, in_key_, in_off[r], in_off[r + 1],
+		c, key.id) != NO_INDEX;
+}
+
+bool CsrGraph::contains_dir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool CsrGraph::contains_dir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool CsrGraph::contains_undir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool CsrGraph::contains_undir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool CsrGraph::contains ( int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+bool CsrGraph::contains ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+// Returns true if a relationship exists between the given vertices.
+bool CsrGraph::contains_dir ( int i, int j ) const
+{
+	size_t r = index(i);
+	size_t c = index(j);
+	if ( r == NO_INDEX || c == NO_INDEX ) return false;
+	return has_nbr(out_nbr_, out_off[r], out_off[r + 1], c);
+}
+
+bool CsrGraph::contains_undir ( int i, int j ) const
+{
+	size_t r = index(i);
+	size_t c = index(j);
+	if ( r == NO_INDEX || c == NO_INDEX ) return false;
+	return has_nbr(out_nbr_, out_off[r], out_off[r + 1], c)
+		|| has_nbr(in_nbr_, in_off[r], in_off[r + 1], c);
+}
+
+bool CsrGraph::contains ( int i, int j ) const
+{
+	if ( directed ) return contains_dir(i, j);
+	return contains_undir(i, j);
+}
+
+// Returns true if the given vertex exists. If specifying directed
+// (undir=false), only returns true if the vertex has an outgoing
+// 'from' relationship.
+bool CsrGraph::contains_dir ( int i ) const
+{
+	size_t r = index(i);
+	return r != NO_INDEX && out_off[r] < out_off[r + 1];
+}
+
+bool CsrGraph::contains_undir ( int i ) const
+{
+	return index(i) != NO_INDEX;
+}
+
+bool CsrGraph::contains ( int i ) const
+{
+	if ( directed ) return contains_dir(i);
+	return contains_undir(i);
+}
+
+// Returns the value of the relationship. If the relationship does
+// not exist, returns the no_relationship value. As on Graph, if the
+// relationship only exists from j to i, returns its value negated.
+float CsrGraph::get ( int i, int j, const std::string& key ) const
+{
+	return get(i, j, key_id(key));
+}
+
+float CsrGraph::get ( int i, int j, KeyID key ) const
+{
+	size_t r = index(i);
+	size_t c = index(j);
+	if ( r == NO_INDEX || c == NO_INDEX ) return no_relationship;
+	
+	size_t e = find(out_nbr_, out_key_, out_off[r], out_off[r + 1], c,
+		key.id);
+	if ( e != NO_INDEX ) return out_val_[e];
+	e = find(in_nbr_, in_key_, in_off[r], in_off[r + 1], c, key.id);
+	if ( e != NO_INDEX ) return -1 * in_val_[e];
+	return no_relationship;
+}
+
+float CsrGraph::get ( int i, int j ) const
+{
+	return get(i, j, KeyID());
+}
+
+
+// BATCH QUERIES ////////////////////////////////////////////////////
+
+// Answer get(q[n].first, q[n].second, key) for every n, in parallel
+// on the pool. Results are in the order of the queries.
+std::vector<float> CsrGraph::get_many (
+	const std::vector<std::pair<int, int> >& q, const std::string& key,
+	ThreadPool& pool ) const
+{
+	return get_many(q, key_id(key), pool);
+}
+
+std::vector<float> CsrGraph::get_many (
+	const std::vector<std::pair<int, int> >& q, KeyID key,
+	ThreadPool& pool ) const
+{
+	std::vector<float> out (q.size());
+	pool.parallel_for(q.size(), [&] ( size_t b, size_t e ) {
+		for ( size_t t = b; t < e; ++t )
+			out[t] = get(q[t].first, q[t].second, key);
+	});
+	return out;
+}
+
+std::vector<float> CsrGraph::get_many (
+	const std::vector<std::pair<int, int> >& q, ThreadPool& pool ) const
+{
+	return get_many(q, KeyID(), pool);
+}
+
+// Get the neighbors of every vertex in v, in parallel on the pool.
+std::vector<std::set<int> > CsrGraph::nbrs_many (
+	const std::vector<int>& v, unsigned char dir, bool limit_key,
+	unsigned int key, ThreadPool& pool ) const
+{
+	std::vector<std::set<int> > out (v.size());
+	pool.parallel_for(v.size(), [&] ( size_t b, size_t e ) {
+		for ( size_t t = b; t < e; ++t )
+			out[t] = nbrs(v[t], dir, limit_key, key);
+	});
+	return out;
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_many (
+	const std::vector<int>& v, const std::string& key,
+	ThreadPool& pool ) const
+{
+	return nbrs_many(v, key_id(key), pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_many (
+	const std::vector<int>& v, KeyID key, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::UNDIRECTED, true, key.id, pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_many (
+	const std::vector<int>& v, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::UNDIRECTED, false, 0, pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_to_many (
+	const std::vector<int>& v, const std::string& key,
+	ThreadPool& pool ) const
+{
+	return nbrs_to_many(v, key_id(key), pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_to_many (
+	const std::vector<int>& v, KeyID key, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::TO, true, key.id, pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_to_many (
+	const std::vector<int>& v, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::TO, false, 0, pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_from_many (
+	const std::vector<int>& v, const std::string& key,
+	ThreadPool& pool ) const
+{
+	return nbrs_from_many(v, key_id(key), pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_from_many (
+	const std::vector<int>& v, KeyID key, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::FROM, true, key.id, pool);
+}
+
+std::vector<std::set<int> > CsrGraph::nbrs_from_many (
+	const std::vector<int>& v, ThreadPool& pool ) const
+{
+	return nbrs_many(v, Graph::FROM, false, 0, pool);
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_CSRGRAPH_20261014
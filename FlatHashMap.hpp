@@ -0,0 +1,461 @@
+/////////////////////////////////////////////////////////////////////
+// Hash map with open addressing, kept in one flat array of slots  //
+// so that a lookup usually touches a single cache line. Has the   //
+// parts of the std::map interface that a graph uses, but visits   //
+// its entries in no particular order.                             //
+//                                                                 //
+// Entries move when the map grows, so inserting invalidates all   //
+// iterators and references; erasing only invalidates those to the //
+// erased entry. Keys need == and a Hash.                          //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// 10/15/2026                                                      //
+// - added prefetch, for batched lookups.                          //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_FLATHASHMAP_20261014
+#define YOUNG_GIS_FLATHASHMAP_20261014
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <tuple>
+#include <utility>
+
+namespace bygis { // Brennan Young GIS namespace
+
+template <class Key, class T, class Hash=std::hash<Key>,
+	class A=std::allocator<std::pair<const Key, T> > >
+class FlatHashMap {
+public:
+	typedef Key key_type;
+	typedef T mapped_type;
+	typedef std::pair<const Key, T> value_type;
+	typedef A allocator_type;
+private:
+	typedef std::allocator_traits<A> Traits;
+	typedef typename Traits::template rebind_alloc<unsigned char> Bytes;
+	
+	static const unsigned char EMPTY = 0;
+	static const unsigned char FULL = 1;
+	static const unsigned char GONE = 2;   // erased; probes continue
+	static const size_t MIN_SLOTS = 4;
+	
+	A alloc;
+	value_type* slots;
+	unsigned char* state;                  // after the slots
+	size_t cap;                            // 0 or a power of 2
+	size_t shift;                          // 64 - log2(cap)
+	size_t used, gone;
+	
+	template <class V> class Iter;
+	
+	static size_t fit ( size_t );
+	size_t home ( const Key& ) const;
+	size_t locate ( const Key& ) const;
+	size_t claim ( const Key& );
+	void allocate ( size_t );
+	void release ();
+	void rehash ( size_t );
+	void copy ( const FlatHashMap& );
+	void take ( FlatHashMap& );
+public:
+	typedef Iter<value_type> iterator;
+	typedef Iter<const value_type> const_iterator;
+	
+	// constructors, destructor
+	FlatHashMap ();
+	explicit FlatHashMap ( const A& );
+	FlatHashMap ( const FlatHashMap& );
+	FlatHashMap ( const FlatHashMap&, const A& );
+	FlatHashMap ( FlatHashMap&& ) noexcept;
+	FlatHashMap ( FlatHashMap&&, const A& );
+	~FlatHashMap ();
+	
+	// operators
+	FlatHashMap& operator= ( const FlatHashMap& );
+	FlatHashMap& operator= ( FlatHashMap&& ) noexcept;
+	void swap ( FlatHashMap& ) noexcept;
+	T& operator[] ( const Key& );
+	
+	// operations
+	A get_allocator () const { return alloc; }
+	size_t size () const { return used; }
+	bool empty () const { return used == 0; }
+	iterator begin () { return iterator(slots, state, state + cap); }
+	const_iterator begin () const
+	{ return const_iterator(slots, state, state + cap); }
+	iterator end () { return iterator(slots + cap, state + cap, state + cap); }
+	const_iterator end () const
+	{ return const_iterator(slots + cap, state + cap, state + cap); }
+	iterator find ( const Key& );
+	const_iterator find ( const Key& ) const;
+	void prefetch ( const Key& ) const;
+	template <class KT, class VT>
+	iterator emplace_hint ( const_iterator, std::piecewise_construct_t,
+		KT&&, VT&& );
+	iterator erase ( const_iterator );
+	iterator erase ( iterator );
+	size_t erase ( const Key& );
+	void clear ();
+}; // FlatHashMap
+
+// Iterates the full slots; V is value_type or const value_type.
+template <class Key, class T, class Hash, class A>
+template <class V>
+class FlatHashMap<Key,T,Hash,A>::Iter {
+	friend class FlatHashMap;
+	template <class U> friend class Iter;
+private:
+	V* slot;
+	const unsigned char* state;
+	const unsigned char* last;
+	void skip () { while ( state != last && *state != FULL ) ++slot, ++state; }
+public:
+	Iter () : slot(0), state(0), last(0) {}
+	Iter ( V* p, const unsigned char* s, const unsigned char* e )
+	: slot(p), state(s), last(e) { skip(); }
+	template <class U>
+	Iter ( const Iter<U>& i ) : slot(i.slot), state(i.state), last(i.last) {}
+	V& operator* () const { return *slot; }
+	V* operator-> () const { return slot; }
+	Iter& operator++ () { ++slot; ++state; skip(); return *this; }
+	Iter operator++ (int) { Iter t (*this); ++(*this); return t; }
+	template <class U>
+	bool operator== ( const Iter<U>& i ) const { return slot == i.slot; }
+	template <class U>
+	bool operator!= ( const Iter<U>& i ) const { return slot != i.slot; }
+}; // Iter
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ()
+: slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{}
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ( const A& a )
+: alloc(a), slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{}
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ( const FlatHashMap& m )
+: alloc(Traits::select_on_container_copy_construction(m.alloc)),
+  slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{
+	copy(m);
+}
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ( const FlatHashMap& m, const A& a )
+: alloc(a), slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{
+	copy(m);
+}
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ( FlatHashMap&& m ) noexcept
+: alloc(m.alloc), slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{
+	take(m);
+}
+
+// Take over m's slots if it uses an equal allocator, and otherwise
+// move its entries one at a time.
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::FlatHashMap ( FlatHashMap&& m, const A& a )
+: alloc(a), slots(0), state(0), cap(0), shift(64), used(0), gone(0)
+{
+	if ( alloc == m.alloc ) {
+		take(m);
+		return;
+	}
+	allocate(fit(m.used));
+	for ( size_t s = 0; s < m.cap; ++s ) {
+		if ( m.state[s] != FULL ) continue;
+		size_t t = claim(m.slots[s].first);
+		Traits::construct(alloc, slots + t, std::move(m.slots[s]));
+	}
+	m.clear();
+}
+
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>::~FlatHashMap ()
+{
+	release();
+}
+
+
+// OPERATORS ////////////////////////////////////////////////////////
+
+// Copy the entries of m. The map keeps its own allocator.
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>&
+FlatHashMap<Key,T,Hash,A>::operator= ( const FlatHashMap& m )
+{
+	if ( this == &m ) return *this;
+	release();
+	copy(m);
+	return *this;
+}
+
+// Take over m's entries and allocator.
+template <class Key, class T, class Hash, class A>
+FlatHashMap<Key,T,Hash,A>&
+FlatHashMap<Key,T,Hash,A>::operator= ( FlatHashMap&& m ) noexcept
+{
+	if ( this == &m ) return *this;
+	FlatHashMap t (std::move(m));
+	swap(t);
+	return *this;
+}
+
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::swap ( FlatHashMap& m ) noexcept
+{
+	std::swap(alloc, m.alloc);
+	std::swap(slots, m.slots);
+	std::swap(state, m.state);
+	std::swap(cap, m.cap);
+	std::swap(shift, m.shift);
+	std::swap(used, m.used);
+	std::swap(gone, m.gone);
+}
+
+// Get the value for the key, inserting a default one if it is new.
+template <class Key, class T, class Hash, class A>
+T& FlatHashMap<Key,T,Hash,A>::operator[] ( const Key& k )
+{
+	return emplace_hint(end(), std::piecewise_construct,
+		std::forward_as_tuple(k), std::forward_as_tuple())->second;
+}
+
+
+// SLOTS ////////////////////////////////////////////////////////////
+
+// Get the number of slots for n entries: at most half full, so that
+// a burst of inserts and erases does not rehash every time.
+template <class Key, class T, class Hash, class A>
+size_t FlatHashMap<Key,T,Hash,A>::fit ( size_t n )
+{
+	size_t c = MIN_SLOTS;
+	while ( n * 2 > c ) c *= 2;
+	return c;
+}
+
+// Get the slot where a search for the key starts. Multiplying by the
+// golden ratio spreads out hashes that are close together, such as
+// the identity hash of consecutive integers.
+template <class Key, class T, class Hash, class A>
+size_t FlatHashMap<Key,T,Hash,A>::home ( const Key& k ) const
+{
+	uint64_t h = (uint64_t)Hash()(k) * 0x9E3779B97F4A7C15ull;
+	return (size_t)(h >> shift);
+}
+
+// Get the slot holding the key, or cap if there is none.
+template <class Key, class T, class Hash, class A>
+size_t FlatHashMap<Key,T,Hash,A>::locate ( const Key& k ) const
+{
+	if ( used == 0 ) return cap;
+	for ( size_t s = home(k); ; s = (s + 1) & (cap - 1) ) {
+		if ( state[s] == EMPTY ) return cap;
+		if ( state[s] == FULL && slots[s].first == k ) return s;
+	}
+}
+
+// Mark a slot for a key that is not in the map, growing first if the
+// map would be more than 3/4 full, and get its index. The caller
+// constructs the entry there.
+template <class Key, class T, class Hash, class A>
+size_t FlatHashMap<Key,T,Hash,A>::claim ( const Key& k )
+{
+	if ( (used + gone + 1) * 4 > cap * 3 )
+		rehash(std::max(cap, fit(used + 1)));
+	size_t s = home(k);
+	while ( state[s] == FULL ) s = (s + 1) & (cap - 1);
+	if ( state[s] == GONE ) --gone;
+	state[s] = FULL;
+	++used;
+	return s;
+}
+
+// Get empty storage for c slots, with their states after them.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::allocate ( size_t c )
+{
+	Bytes b (alloc);
+	unsigned char* p = b.allocate(c * sizeof(value_type) + c);
+	slots = reinterpret_cast<value_type*>(p);
+	state = p + c * sizeof(value_type);
+	memset(state, EMPTY, c);
+	cap = c;
+	for ( shift = 64; c > 1; c /= 2 ) --shift;
+	used = gone = 0;
+}
+
+// Destroy every entry and return the storage.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::release ()
+{
+	if ( cap == 0 ) return;
+	for ( size_t s = 0; s < cap; ++s )
+		if ( state[s] == FULL ) Traits::destroy(alloc, slots + s);
+	Bytes b (alloc);
+	b.deallocate(reinterpret_cast<unsigned char*>(slots),
+		cap * sizeof(value_type) + cap);
+	slots = 0;
+	state = 0;
+	cap = 0;
+	shift = 64;
+	used = gone = 0;
+}
+
+// Move the entries into c slots, dropping the erased ones.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::rehash ( size_t c )
+{
+	FlatHashMap old (alloc);
+	old.swap(*this);
+	allocate(c);
+	for ( size_t s = 0; s < old.cap; ++s ) {
+		if ( old.state[s] != FULL ) continue;
+		size_t t = claim(old.slots[s].first);
+		Traits::construct(alloc, slots + t, std::move(old.slots[s]));
+	}
+}
+
+// Insert copies of m's entries into an empty map.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::copy ( const FlatHashMap& m )
+{
+	if ( m.used == 0 ) return;
+	allocate(fit(m.used));
+	for ( size_t s = 0; s < m.cap; ++s ) {
+		if ( m.state[s] != FULL ) continue;
+		size_t t = claim(m.slots[s].first);
+		Traits::construct(alloc, slots + t, m.slots[s]);
+	}
+}
+
+// Take over the storage of m, leaving it empty.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::take ( FlatHashMap& m )
+{
+	std::swap(slots, m.slots);
+	std::swap(state, m.state);
+	std::swap(cap, m.cap);
+	std::swap(shift, m.shift);
+	std::swap(used, m.used);
+	std::swap(gone, m.gone);
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+template <class Key, class T, class Hash, class A>
+typename FlatHashMap<Key,T,Hash,A>::iterator
+FlatHashMap<Key,T,Hash,A>::find ( const Key& k )
+{
+	size_t s = locate(k);
+	return iterator(slots + s, state + s, state + cap);
+}
+
+template <class Key, class T, class Hash, class A>
+typename FlatHashMap<Key,T,Hash,A>::const_iterator
+FlatHashMap<Key,T,Hash,A>::find ( const Key& k ) const
+{
+	size_t s = locate(k);
+	return const_iterator(slots + s, state + s, state + cap);
+}
+
+// Start loading the slot where a search for the key starts into the
+// cache, so that a find for it a little later does not wait for
+// memory. Does nothing without a compiler that can prefetch.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::prefetch ( const Key& k ) const
+{
+	if ( cap == 0 ) return;
+#if defined(__GNUC__) || defined(__clang__)
+	size_t s = home(k);
+	__builtin_prefetch(state + s);
+	__builtin_prefetch(slots + s);
+#else
+	(void)k;
+#endif
+}
+
+// Insert an entry constructed from the key and value arguments, as
+// std::map::emplace_hint(hint, std::piecewise_construct, key, value)
+// does. The hint is ignored. Returns the entry with the key, which is
+// left as it was if it already existed.
+template <class Key, class T, class Hash, class A>
+template <class KT, class VT>
+typename FlatHashMap<Key,T,Hash,A>::iterator
+FlatHashMap<Key,T,Hash,A>::emplace_hint ( const_iterator,
+	std::piecewise_construct_t p, KT&& key, VT&& value )
+{
+	const Key& k = std::get<0>(key);
+	size_t s = locate(k);
+	if ( s == cap ) {
+		s = claim(k);
+		Traits::construct(alloc, slots + s, p, std::forward<KT>(key),
+			std::forward<VT>(value));
+	}
+	return iterator(slots + s, state + s, state + cap);
+}
+
+// Erase an entry. Returns the entry after it.
+template <class Key, class T, class Hash, class A>
+typename FlatHashMap<Key,T,Hash,A>::iterator
+FlatHashMap<Key,T,Hash,A>::erase ( const_iterator it )
+{
+	size_t s = it.state - state;
+	Traits::destroy(alloc, slots + s);
+	state[s] = GONE;
+	--used;
+	++gone;
+	
+	// with nothing left, no probe needs the erased slots
+	if ( used == 0 ) {
+		memset(state, EMPTY, cap);
+		gone = 0;
+		return end();
+	}
+	return iterator(slots + s, state + s, state + cap);
+}
+
+template <class Key, class T, class Hash, class A>
+typename FlatHashMap<Key,T,Hash,A>::iterator
+FlatHashMap<Key,T,Hash,A>::erase ( iterator it )
+{
+	return erase(const_iterator(it));
+}
+
+template <class Key, class T, class Hash, class A>
+size_t FlatHashMap<Key,T,Hash,A>::erase ( const Key& k )
+{
+	size_t s = locate(k);
+	if ( s == cap ) return 0;
+	erase(const_iterator(slots + s, state + s, state + cap));
+	return 1;
+}
+
+// Erase every entry and return the storage.
+template <class Key, class T, class Hash, class A>
+void FlatHashMap<Key,T,Hash,A>::clear ()
+{
+	release();
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_FLATHASHMAP_20261014
@@ -6,710 +6,3827 @@
 // Does not assume undirected behavior -- need to assign (i,j)     //
 // as well as (j,i), or use the set method for undirected          //
 // relationships.                                                  //
+//                                                                 //
+// BasicGraph<Id, K, W> has vertex IDs of type Id, keys of type K, //
+// and values of type W; Graph is BasicGraph<int, string, float>.  //
+// With K = NoKey the graph is not a multigraph, and the maps of   //
+// keyed relationships are dropped. A fourth parameter, HashedMaps //
+// in place of OrderedMaps, keeps vertices and neighbors in hash   //
+// maps (HashGraph), which do not visit them in order.             //
+//                                                                 //
+// Every graph keeps a hash of its relationships (hash()), so      //
+// std::hash<Id>, std::hash<K>, and std::hash<W> must exist for    //
+// any Id, K, and W, whether or not hash() is called. Each set and //
+// clear updates it with a few hashes and multiplies, about 1% of  //
+// the time of a set or clear in a large graph.                    //
+//                                                                 //
+// Keyed queries and clear(key) look at every relationship (or,    //
+// for a vertex, every neighbor) unless index_keys() is called;    //
+// the index makes them take time in the number of relationships   //
+// with the key, for 44% to 68% more memory.                       //
 /////////////////////////////////////////////////////////////////////
 
 /////////////////////////////////////////////////////////////////////
 // -- HISTORY ---------------------------------------------------- //
 // 11/11-21/2022 - Brennan Young                                   //
 // - created.                                                      //
+// 10/14/2026                                                      //
+// - relationship keys are interned to KeyIDs; added KeyID         //
+//   overloads of the keyed methods.                               //
+// - CsrGraph (CsrGraph.hpp) may read the graph's internals.       //
+// - added vertex and relationship ranges and neighbor visitors.   //
+// - map nodes are drawn from a per-graph NodePool (NodePool.hpp); //
+//   now requires C++11.                                           //
+// - added assign_edges and from_edge_list bulk loading.           //
+// - added move construction and assignment, and swap; copies      //
+//   keep no_relationship.                                         //
+// - templated on vertex ID, key, and value types as BasicGraph;   //
+//   Graph is an alias. Added NoKey single-key graphs.             //
+// - added an optional index by key (index_keys), for clear(key),  //
+//   keyed neighbor queries, and the new for_each_edge.            //
+// - added num_edges and degree counts, kept as the graph changes. //
+// - added HashedMaps storage (HashGraph) and conversion between   //
+//   storage types.                                                //
+// - added apply_edges, for batches of changes (UpdateLog.hpp).    //
+// - added RelStore::MapOf, for UndirectedGraph.hpp.               //
+// - added optional dense vertex indices (number_vertices).        //
+// - neighbors toward a vertex are kept in its row, for nbrs_to    //
+//   without reverse lookups.                                      //
+// - added subgraph, filter_key, and filter.                       //
+// - added optional counts of operations (stats, GraphStats.hpp).  //
+// - added connected components kept as the graph changes          //
+//   (connected, component; UnionFind.hpp).                        //
+// - added number_vertices(order), for the vertex orders of        //
+//   GraphPartition.hpp.                                           //
+// - the relationships of a pair are kept in a SmallRelMap, in     //
+//   place of a std::map.                                          //
+// - added get_batch and contains_batch.                           //
+// - added hash, kept as the graph changes, operator==, and diff;  //
+//   Id, K, and W now need std::hash.                              //
+// - added const connected and component, which leave the tracked  //
+//   components as they are, for readers sharing a graph.          //
+// - set with a KeyID the graph did not issue does nothing.        //
+// - connected and component no longer start tracking components:  //
+//   until track_components(), connected searches and component    //
+//   returns NO_INDEX.                                             //
 /////////////////////////////////////////////////////////////////////
 
-#ifndef YOUNG_GIS_GRAPH_20221111
-#define YOUNG_GIS_GRAPH_20221111
+#ifndef YOUNG_GIS_GRAPH_20221111
+#define YOUNG_GIS_GRAPH_20221111
+
+#include <algorithm>
+#include <map>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <scoped_allocator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FlatHashMap.hpp"
+#include "GraphStats.hpp"
+#include "NodePool.hpp"
+#include "UnionFind.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+// Handle to a relationship key interned by a graph. Only meaningful
+// to the graph that issued it (and to its copies).
+struct KeyID {
+	unsigned int id;
+	
+	explicit KeyID ( unsigned int k=0 ) : id(k) {}
+	bool operator== ( const KeyID& k ) const { return id == k.id; }
+	bool operator!= ( const KeyID& k ) const { return id != k.id; }
+	bool operator< ( const KeyID& k ) const { return id < k.id; }
+}; // KeyID
+
+// Key type of a graph that is not a multigraph. Every relationship
+// has the one key NoKey(), so a BasicGraph with NoKey keys keeps a
+// single relationship per pair of vertices, in place of a map.
+struct NoKey {
+	bool operator== ( const NoKey& ) const { return true; }
+	bool operator!= ( const NoKey& ) const { return false; }
+	bool operator< ( const NoKey& ) const { return false; }
+}; // NoKey
+
+// The part of std::map that a graph uses for the relationships between
+// two vertices, holding at most one relationship under key ID 0 in
+// place. Used with NoKey keys, which only ever intern ID 0.
+template <class T>
+class SingleRelMap {
+public:
+	typedef unsigned int key_type;
+	typedef T mapped_type;
+	typedef std::pair<const unsigned int, T> value_type;
+	typedef value_type* iterator;
+	typedef const value_type* const_iterator;
+private:
+	value_type slot;
+	bool used;
+public:
+	SingleRelMap () : slot(0, T()), used(false) {}
+	SingleRelMap ( const SingleRelMap& m ) : slot(m.slot), used(m.used) {}
+	SingleRelMap& operator= ( const SingleRelMap& m )
+	{ slot.second = m.slot.second; used = m.used; return *this; }
+	
+	iterator begin () { return used ? &slot : &slot + 1; }
+	const_iterator begin () const { return used ? &slot : &slot + 1; }
+	iterator end () { return &slot + 1; }
+	const_iterator end () const { return &slot + 1; }
+	size_t size () const { return used ? 1 : 0; }
+	
+	iterator find ( unsigned int k )
+	{ return used && k == 0 ? &slot : end(); }
+	const_iterator find ( unsigned int k ) const
+	{ return used && k == 0 ? &slot : end(); }
+	T& operator[] ( unsigned int )
+	{
+		if ( !used ) slot.second = T();
+		used = true;
+		return slot.second;
+	}
+	iterator emplace_hint ( const_iterator, unsigned int, const T& x )
+	{
+		if ( !used ) slot.second = x;
+		used = true;
+		return &slot;
+	}
+	iterator upper_bound ( unsigned int ) { return end(); }
+	const_iterator upper_bound ( unsigned int ) const { return end(); }
+	iterator erase ( iterator ) { used = false; return end(); }
+	size_t erase ( unsigned int k )
+	{
+		if ( !used || k != 0 ) return 0;
+		used = false;
+		return 1;
+	}
+}; // SingleRelMap
+
+// The part of std::map that a graph uses for the relationships between
+// two vertices, as an array sorted by key ID that holds up to N of
+// them in place, and moves them to memory from its allocator only when
+// there are more. Most pairs of vertices have one or two, which are
+// then found without leaving the neighbor's node. Unlike std::map,
+// inserting and erasing invalidate iterators to the other entries.
+template <class T, size_t N, class A>
+class SmallRelMap {
+public:
+	typedef unsigned int key_type;
+	typedef T mapped_type;
+	typedef std::pair<unsigned int, T> value_type;
+	typedef value_type* iterator;
+	typedef const value_type* const_iterator;
+	typedef typename std::allocator_traits<A>::template
+		rebind_alloc<value_type> allocator_type;
+private:
+	typedef std::allocator_traits<allocator_type> Traits;
+	
+	allocator_type alloc;
+	unsigned int count, cap;            // cap == N while in place
+	union Store {
+		value_type* heap;
+		typename std::aligned_storage<sizeof(value_type),
+			alignof(value_type)>::type local[N];
+	} store;
+	
+	value_type* items ()
+	{ return cap > N ? store.heap : reinterpret_cast<value_type*>(store.local); }
+	const value_type* items () const
+	{ return cap > N ? store.heap
+		: reinterpret_cast<const value_type*>(store.local); }
+	void reserve ( size_t );
+	void release ();
+	void take ( SmallRelMap& );
+	iterator insert_at ( size_t, unsigned int, const T& );
+public:
+	// constructors, destructor
+	SmallRelMap () : count(0), cap(N) {}
+	explicit SmallRelMap ( const allocator_type& a )
+	: alloc(a), count(0), cap(N) {}
+	SmallRelMap ( const SmallRelMap& m )
+	: alloc(Traits::select_on_container_copy_construction(m.alloc)),
+	  count(0), cap(N)
+	{ *this = m; }
+	SmallRelMap ( const SmallRelMap& m, const allocator_type& a )
+	: alloc(a), count(0), cap(N)
+	{ *this = m; }
+	SmallRelMap ( SmallRelMap&& m ) : alloc(m.alloc), count(0), cap(N)
+	{ take(m); }
+	SmallRelMap ( SmallRelMap&& m, const allocator_type& a )
+	: alloc(a), count(0), cap(N)
+	{ take(m); }
+	~SmallRelMap () { release(); }
+	
+	SmallRelMap& operator= ( const SmallRelMap& );
+	SmallRelMap& operator= ( SmallRelMap&& );
+	
+	iterator begin () { return items(); }
+	const_iterator begin () const { return items(); }
+	iterator end () { return items() + count; }
+	const_iterator end () const { return items() + count; }
+	size_t size () const { return count; }
+	bool empty () const { return count == 0; }
+	allocator_type get_allocator () const { return alloc; }
+	
+	iterator lower_bound ( unsigned int k )
+	{
+		iterator it = begin();
+		while ( it != end() && it->first < k ) ++it;
+		return it;
+	}
+	const_iterator lower_bound ( unsigned int k ) const
+	{ return const_cast<SmallRelMap*>(this)->lower_bound(k); }
+	iterator upper_bound ( unsigned int k )
+	{
+		iterator it = lower_bound(k);
+		return it != end() && it->first == k ? it + 1 : it;
+	}
+	const_iterator upper_bound ( unsigned int k ) const
+	{ return const_cast<SmallRelMap*>(this)->upper_bound(k); }
+	iterator find ( unsigned int k )
+	{
+		iterator it = lower_bound(k);
+		return it != end() && it->first == k ? it : end();
+	}
+	const_iterator find ( unsigned int k ) const
+	{ return const_cast<SmallRelMap*>(this)->find(k); }
+	
+	T& operator[] ( unsigned int k )
+	{
+		iterator it = lower_bound(k);
+		if ( it != end() && it->first == k ) return it->second;
+		return insert_at(it - begin(), k, T())->second;
+	}
+	iterator emplace_hint ( const_iterator, unsigned int k, const T& x )
+	{
+		iterator it = lower_bound(k);
+		if ( it != end() && it->first == k ) return it;
+		return insert_at(it - begin(), k, x);
+	}
+	iterator erase ( iterator );
+	size_t erase ( unsigned int k )
+	{
+		iterator it = find(k);
+		if ( it == end() ) return 0;
+		erase(it);
+		return 1;
+	}
+	void clear ()
+	{
+		for ( size_t t = 0; t < count; ++t ) items()[t].~value_type();
+		count = 0;
+	}
+}; // SmallRelMap
+
+// Copy m's entries, keeping this map's allocator.
+template <class T, size_t N, class A>
+SmallRelMap<T,N,A>& SmallRelMap<T,N,A>::operator= ( const SmallRelMap& m )
+{
+	if ( this == &m ) return *this;
+	clear();
+	reserve(m.count);
+	for ( ; count < m.count; ++count )
+		::new (items() + count) value_type(m.items()[count]);
+	return *this;
+}
+
+// Take m's entries and its allocator, leaving m empty.
+template <class T, size_t N, class A>
+SmallRelMap<T,N,A>& SmallRelMap<T,N,A>::operator= ( SmallRelMap&& m )
+{
+	if ( this == &m ) return *this;
+	release();
+	count = 0;
+	cap = N;
+	alloc = m.alloc;
+	take(m);
+	return *this;
+}
+
+// Make room for n entries, moving to (larger) memory from the
+// allocator if need be.
+template <class T, size_t N, class A>
+void SmallRelMap<T,N,A>::reserve ( size_t n )
+{
+	if ( n <= cap ) return;
+	size_t c = std::max(n, (size_t)cap * 2);
+	value_type* to = Traits::allocate(alloc, c);
+	value_type* from = items();
+	for ( size_t t = 0; t < count; ++t ) {
+		::new (to + t) value_type(std::move(from[t]));
+		from[t].~value_type();
+	}
+	if ( cap > N ) Traits::deallocate(alloc, from, cap);
+	store.heap = to;
+	cap = c;
+}
+
+// Destroy the entries and give back any memory from the allocator.
+template <class T, size_t N, class A>
+void SmallRelMap<T,N,A>::release ()
+{
+	clear();
+	if ( cap > N ) Traits::deallocate(alloc, store.heap, cap);
+	cap = N;
+}
+
+// Take m's entries into this empty map: its memory, if it has the same
+// allocator, or else each entry.
+template <class T, size_t N, class A>
+void SmallRelMap<T,N,A>::take ( SmallRelMap& m )
+{
+	if ( m.cap > N && alloc == m.alloc ) {
+		store.heap = m.store.heap;
+		count = m.count;
+		cap = m.cap;
+		m.count = 0;
+		m.cap = N;
+		return;
+	}
+	reserve(m.count);
+	for ( ; count < m.count; ++count )
+		::new (items() + count) value_type(std::move(m.items()[count]));
+	m.release();
+}
+
+// Insert the entry (k, x) at position p, which keeps the keys sorted.
+template <class T, size_t N, class A>
+typename SmallRelMap<T,N,A>::iterator SmallRelMap<T,N,A>::insert_at (
+	size_t p, unsigned int k, const T& x )
+{
+	reserve(count + 1);
+	value_type* v = items();
+	if ( p == count ) ::new (v + count) value_type(k, x);
+	else {
+		::new (v + count) value_type(std::move(v[count - 1]));
+		for ( size_t t = count - 1; t > p; --t ) v[t] = std::move(v[t - 1]);
+		v[p] = value_type(k, x);
+	}
+	++count;
+	return v + p;
+}
+
+// Remove the entry at it, and get the entry that followed it.
+template <class T, size_t N, class A>
+typename SmallRelMap<T,N,A>::iterator SmallRelMap<T,N,A>::erase ( iterator it )
+{
+	size_t p = it - begin();
+	iterator last = end() - 1;
+	for ( ; it != last; ++it ) *it = std::move(*(it + 1));
+	last->~value_type();
+	--count;
+	return begin() + p;
+}
+
+// Storage for the relationships between two vertices: a small sorted
+// map from key ID, or a single relationship if the graph has no keys.
+// Only graphs with keys index their relationships by key. MapOf<T> is
+// the same storage for relationships of another type T.
+template <class K, class W>
+struct RelStore {
+	typedef std::pair<bool, W> Rel;
+	template <class T>
+	struct MapOf { typedef SmallRelMap<T, 2,
+		PoolAllocator<std::pair<unsigned int, T> > > type; };
+	typedef typename MapOf<Rel>::type Map;
+	static const bool INDEXED = true;
+};
+
+template <class W>
+struct RelStore<NoKey, W> {
+	typedef std::pair<bool, W> Rel;
+	template <class T>
+	struct MapOf { typedef SingleRelMap<T> type; };
+	typedef typename MapOf<Rel>::type Map;
+	static const bool INDEXED = false;
+};
+
+// Map types for the vertex and neighbor levels of a graph: ordered
+// std::maps, or FlatHashMaps (FlatHashMap.hpp), which find a vertex
+// or neighbor in about constant time but visit them in no particular
+// order. The keys of a pair of vertices stay in order either way.
+// prefetch(m, k) starts loading where m.find(k) will look, if it can.
+struct OrderedMaps {
+	static const bool ORDERED = true;
+	template <class Id, class T, class A>
+	struct Map { typedef std::map<Id, T, std::less<Id>, A> type; };
+	template <class M, class Id>
+	static void prefetch ( const M&, const Id& ) {}
+};
+
+struct HashedMaps {
+	static const bool ORDERED = false;
+	template <class Id, class T, class A>
+	struct Map { typedef FlatHashMap<Id, T, std::hash<Id>, A> type; };
+	template <class M, class Id>
+	static void prefetch ( const M& m, const Id& k ) { m.prefetch(k); }
+};
+
+class CsrGraph;
+
+template <class Id, class K, class W, class S=OrderedMaps>
+class BasicGraph {
+	friend class CsrGraph;
+private:
+	static const unsigned char UNDIRECTED;
+	static const unsigned char FROM;
+	static const unsigned char TO;
+	
+	// bool in pair is false if the relationship only exists *to*
+	// vertex i from vertex j
+	// All three levels draw their nodes from the graph's pool, except
+	// that the relationships of a pair are held in the neighbor's node
+	// (up to two of them, or the one with NoKey keys).
+	typedef typename RelStore<K, W>::Rel Rel;
+	typedef typename RelStore<K, W>::Map RelMap;   // key ID -> rel
+	typedef typename S::template Map<Id, RelMap,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, RelMap> > > >::type NbrMap; // j -> rels
+	
+	typedef std::set<Id, std::less<Id>, PoolAllocator<Id> > IdSet;
+	
+	// the neighbors of a vertex, with the numbers of them that it has
+	// relationships toward (out) and from (in), the neighbors it has
+	// relationships from, its dense index, and its slot in the
+	// connected components
+	struct Row : NbrMap {
+		typedef typename NbrMap::allocator_type allocator_type;
+		size_t out, in;
+		IdSet from;
+		size_t index, slot;
+		
+		explicit Row ( const allocator_type& a )
+		: NbrMap(a), out(0), in(0), from(a.outer_allocator()),
+		  index(NO_INDEX), slot(NO_INDEX) {}
+		Row ( const Row& r, const allocator_type& a )
+		: NbrMap(r, a), out(r.out), in(r.in),
+		  from(r.from, a.outer_allocator()), index(r.index),
+		  slot(r.slot) {}
+		Row ( Row&& r, const allocator_type& a )
+		: NbrMap(std::move(r), a), out(r.out), in(r.in),
+		  from(std::move(r.from), a.outer_allocator()), index(r.index),
+		  slot(r.slot) {}
+	};
+	typedef typename S::template Map<Id, Row,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, Row> > > >::type VertexMap;  // i -> nbrs
+	typedef typename VertexMap::allocator_type Alloc;
+	std::unique_ptr<NodePool> pool;                // before data
+	VertexMap data;
+	
+	// key dictionary; KeyID k names key_names[k.id]
+	std::vector<K> key_names;
+	std::map<K, unsigned int> key_ids;
+	
+	// key index, if kept: for each key ID, the (i, j) pairs whose
+	// relationship maps hold that key, back-links included. Never kept
+	// with NoKey keys.
+	typedef std::map<Id, IdSet, std::less<Id>,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, IdSet> > > > KeyIndex;       // i -> js
+	bool indexed;
+	std::vector<KeyIndex> key_index;                  // by key ID
+	
+	// relationships toward a neighbor, in all and by key ID
+	size_t edge_count;
+	std::vector<size_t> key_edges;
+	
+	// sum of rel_hash over the relationships toward a neighbor, and the
+	// hash of each key by ID, for hash(); kept by every set and clear
+	uint64_t rel_sum;
+	std::vector<uint64_t> key_hashes;
+	
+	// dense indices, if numbered: vertex ids[r] has index r
+	bool dense;
+	std::vector<Id> ids;
+	
+	// connected components of some of the relationships, with the
+	// pairs of slots that have lost a relationship since they were
+	// last checked
+	struct Part {
+		UnionFind sets;
+		bool made;
+		std::vector<std::pair<size_t, size_t> > cuts;
+		Part () : made(false) {}
+	};
+	
+	// connected components, if tracked: parts[0] joins the vertices of
+	// every relationship and parts[k + 1] those of key ID k, each made
+	// when it is first asked for; vertex slot_ids[s] has slot s in them,
+	// unless it has been removed (live[s] == 0)
+	bool tracked;
+	std::vector<Part> parts;
+	std::vector<Id> slot_ids;
+	std::vector<char> live;
+	size_t dead;
+	
+	// counts of the graph's operations (GraphStats.hpp)
+#ifdef YOUNG_GIS_GRAPH_STATS
+	mutable GraphStats counters;
+#endif
+
+	// visitor that collects neighbor IDs
+	struct Collect {
+		std::set<Id>* out;
+		explicit Collect ( std::set<Id>& s ) : out(&s) {}
+		void operator() ( Id j ) { out->insert(out->end(), j); }
+	};
+	
+	// visitor that passes the indices of vertex IDs on to f
+	template <class F>
+	struct ByIndex {
+		const BasicGraph* g;
+		F* f;
+		ByIndex ( const BasicGraph* a, F& b ) : g(a), f(&b) {}
+		void operator() ( Id j ) { (*f)(g->index(j)); }
+		void operator() ( Id i, Id j, W x )
+		{ (*f)(g->index(i), g->index(j), x); }
+	};
+	
+	static const NbrMap NO_NBRS;
+	
+	template <class F>
+	void visit ( Id, unsigned char, bool, unsigned int, F& ) const;
+	static bool visits ( unsigned char, const Rel& );
+	std::set<Id> nbrs ( Id, unsigned char, bool, unsigned int ) const;
+	void update (Id, Id, unsigned int, bool, W);
+	bool update ( RelMap&, Id, Id, unsigned int, bool, W );
+	void erase_rel ( Id, Id, unsigned int );
+	void erase_rel ( RelMap&, Id, Id, unsigned int );
+	void erase_nbr ( Id, Id );
+	void prune ( Id, Id );
+	static bool flags ( const RelMap& );
+	void count ( Id, Id, unsigned int, int, bool );
+	
+	typename KeyIndex::allocator_type index_alloc () const;
+	void index_add ( unsigned int, Id, Id );
+	void index_remove ( unsigned int, Id, Id );
+	void copy_index ( const BasicGraph& );
+	void build_index ();
+	void reindex ();
+	void number ( Id );
+	void number_all ();
+	void erase_vertex ( Id );
+	void erase_vertex ( typename VertexMap::iterator );
+	size_t part ( unsigned int ) const;
+	void place ( Id );
+	void slot_all ();
+	void join ( Id, Id, unsigned int );
+	void cut ( Id, Id, unsigned int, bool );
+	void note_cut ( size_t, size_t, size_t );
+	void join_row ( size_t, Id );
+	void build_part ( size_t );
+	int linked ( size_t, Id, Id, size_t, std::vector<Id>& ) const;
+	void detach ( size_t, const std::vector<Id>& );
+	void repair ( size_t, size_t );
+	size_t root ( Id, size_t );
+	size_t root ( Id, size_t ) const;
+	bool search ( size_t, Id, const Id*, size_t& ) const;
+	template <class F>
+	bool joins ( typename VertexMap::const_iterator, size_t, F ) const;
+	bool joined ( Id, Id, size_t ) const;
+	int compare ( const RelMap&, const BasicGraph&, const RelMap& ) const;
+	static uint64_t mix ( uint64_t );
+	template <class T> static uint64_t hash_of ( const T& );
+	static uint64_t hash_of ( const NoKey& );
+	uint64_t rel_hash ( Id, Id, unsigned int, W ) const;
+	template <class M, class F> static void merge ( const M*, const M*, F );
+	GraphStats* tally () const;
+	
+	// one relationship during bulk loading
+	struct Entry {
+		Id i, j;
+		unsigned int k;
+		bool out;
+		W x;
+		bool operator< ( const Entry& e ) const {
+			if ( i != e.i ) return i < e.i;
+			if ( j != e.j ) return j < e.j;
+			if ( k != e.k ) return k < e.k;
+			return out && !e.out;
+		}
+	};
+	static bool same_rel ( const Entry&, const Entry& );
+	static bool rel_less ( const Entry&, const Entry& );
+	template <class It> std::vector<Entry> arcs ( It, It );
+	void apply_pair ( const Entry*, const Entry* );
+	template <class P>
+	void take ( const BasicGraph&, Id, const NbrMap&, P& );
+	
+	// one query of a batch: the pair, key ID, and direction asked
+	// about, and the place n of its answer
+	struct Probe {
+		Id i, j;
+		unsigned int k;
+		bool undir;
+		size_t n;
+		bool operator< ( const Probe& q ) const {
+			if ( i != q.i ) return i < q.i;
+			if ( j != q.j ) return j < q.j;
+			return k < q.k;
+		}
+	};
+	template <class It, class F> void probe ( It, It, F& ) const;
+	
+	// selects the relationships with both ends in a set
+	struct InSet {
+		const std::set<Id>* in;
+		bool operator() ( Id i, Id j, KeyID, W ) const
+		{ return in->count(i) > 0 && in->count(j) > 0; }
+	};
+	
+	// selects the relationships with a key
+	struct HasKey {
+		KeyID key;
+		bool operator() ( Id, Id, KeyID k, W ) const { return k == key; }
+	};
+public:
+	static const KeyID NO_KEY;
+	static const size_t NO_INDEX;
+	
+	// One relationship to load in bulk, with the same meaning as the
+	// arguments to set(i, j, key, undir, x).
+	struct Edge {
+		Id i, j;
+		K key;
+		bool undir;
+		W x;
+		
+		Edge () : i(0), j(0), undir(false), x(0) {}
+		Edge ( Id a, Id b, const K& k, bool u, W v )
+		: i(a), j(b), key(k), undir(u), x(v) {}
+		Edge ( Id a, Id b, W v )
+		: i(a), j(b), undir(false), x(v) {}
+	};
+	
+	// A relationship as seen from one of its vertices: the other
+	// vertex, the key, the value as get() would return it, and whether
+	// the relationship points toward the other vertex.
+	struct Arc {
+		Id j;
+		KeyID key;
+		W x;
+		bool out;
+	};
+	
+	// Iterates the relationships of a vertex in (j, key) order (in key
+	// order for each j, with HashedMaps) without copying them.
+	// Invalidated by changes to the relationships.
+	class ArcIterator {
+	private:
+		typename NbrMap::const_iterator jt, jend;
+		typename RelMap::const_iterator kt;
+		bool out_only;
+		void skip ();
+	public:
+		ArcIterator ( typename NbrMap::const_iterator,
+			typename NbrMap::const_iterator, bool );
+		Arc operator* () const;
+		ArcIterator& operator++ ();
+		ArcIterator operator++ (int);
+		bool operator== ( const ArcIterator& ) const;
+		bool operator!= ( const ArcIterator& ) const;
+	}; // ArcIterator
+	
+	class ArcRange {
+	private:
+		ArcIterator first, last;
+	public:
+		ArcRange ( const ArcIterator& a, const ArcIterator& b )
+		: first(a), last(b) {}
+		ArcIterator begin () const { return first; }
+		ArcIterator end () const { return last; }
+	}; // ArcRange
+	
+	// Iterates the vertex IDs in increasing order (in no order, with
+	// HashedMaps) without copying them.
+	class VertexIterator {
+	private:
+		typename VertexMap::const_iterator it;
+	public:
+		explicit VertexIterator ( typename VertexMap::const_iterator i ) : it(i) {}
+		Id operator* () const { return it->first; }
+		VertexIterator& operator++ () { ++it; return *this; }
+		VertexIterator operator++ (int)
+		{ VertexIterator t (*this); ++it; return t; }
+		bool operator== ( const VertexIterator& v ) const
+		{ return it == v.it; }
+		bool operator!= ( const VertexIterator& v ) const
+		{ return it != v.it; }
+	}; // VertexIterator
+	
+	class VertexRange {
+	private:
+		VertexIterator first, last;
+	public:
+		VertexRange ( const VertexIterator& a, const VertexIterator& b )
+		: first(a), last(b) {}
+		VertexIterator begin () const { return first; }
+		VertexIterator end () const { return last; }
+	}; // VertexRange
+	
+	bool directed;
+	W no_relationship;
+	
+	// constructors, destructor
+	BasicGraph (bool dir=true, W x=0);
+	BasicGraph (const BasicGraph&);
+	BasicGraph (BasicGraph&&) noexcept;
+	template <class S2> explicit BasicGraph (const BasicGraph<Id,K,W,S2>&);
+	~BasicGraph ();
+	
+	// operators
+	BasicGraph& operator=(const BasicGraph&);
+	BasicGraph& operator=(BasicGraph&&) noexcept;
+	void swap (BasicGraph&) noexcept;
+	bool operator<(const BasicGraph&) const;
+	bool operator==(const BasicGraph&) const;
+	bool operator!=(const BasicGraph&) const;
+	
+	// bulk loading
+	template <class It> void assign_edges ( It, It );
+	template <class It> void apply_edges ( It, It );
+	template <class It>
+	static BasicGraph from_edge_list ( It, It, bool dir=true, W x=0 );
+	
+	// subgraphs
+	BasicGraph subgraph ( const std::set<Id>& ) const;
+	BasicGraph filter_key ( const K& ) const;
+	BasicGraph filter_key ( KeyID ) const;
+	template <class P> BasicGraph filter ( P ) const;
+	
+	// comparison
+	uint64_t hash () const;
+	std::vector<Edge> diff ( const BasicGraph& ) const;
+	
+	// statistics
+	GraphStats& stats () const;
+	
+	// keys
+	KeyID key_id (const K&) const;
+	KeyID intern (const K&);
+	const K& key_name (KeyID) const;
+	size_t num_keys () const;
+	void index_keys ( bool on=true );
+	bool indexes_keys () const;
+	
+	// operations
+	size_t size () const;
+	size_t num_edges () const;
+	size_t num_edges (const K&) const;
+	size_t num_edges (KeyID) const;
+	size_t degree (Id) const;
+	size_t degree (Id, const K&) const;
+	size_t degree (Id, KeyID) const;
+	size_t out_degree (Id) const;
+	size_t in_degree (Id) const;
+	std::set<Id> nbrs (Id, const K&) const;
+	std::set<Id> nbrs (Id, KeyID) const;
+	std::set<Id> nbrs (Id) const;
+	std::set<Id> nbrs_to (Id, const K&) const;
+	std::set<Id> nbrs_to (Id, KeyID) const;
+	std::set<Id> nbrs_to (Id) const;
+	std::set<Id> nbrs_from (Id, const K&) const;
+	std::set<Id> nbrs_from (Id, KeyID) const;
+	std::set<Id> nbrs_from (Id) const;
+	std::set<Id> vertices () const;
+	
+	// iteration
+	VertexRange vertex_range () const;
+	ArcRange out_edges ( Id ) const;
+	ArcRange edges ( Id ) const;
+	template <class F> F for_each_nbr ( Id, const K&, F ) const;
+	template <class F> F for_each_nbr ( Id, KeyID, F ) const;
+	template <class F> F for_each_nbr ( Id, F ) const;
+	template <class F>
+	F for_each_nbr_to ( Id, const K&, F ) const;
+	template <class F> F for_each_nbr_to ( Id, KeyID, F ) const;
+	template <class F> F for_each_nbr_to ( Id, F ) const;
+	template <class F>
+	F for_each_nbr_from ( Id, const K&, F ) const;
+	template <class F> F for_each_nbr_from ( Id, KeyID, F ) const;
+	template <class F> F for_each_nbr_from ( Id, F ) const;
+	template <class F> F for_each_edge ( const K&, F ) const;
+	template <class F> F for_each_edge ( KeyID, F ) const;
+	
+	// dense indices
+	void number_vertices ( bool on=true );
+	void number_vertices ( const std::vector<Id>& );
+	bool numbered () const;
+	size_t index ( Id ) const;
+	Id vertex ( size_t ) const;
+	template <class F> F for_each_nbr_index ( size_t, const K&, F ) const;
+	template <class F> F for_each_nbr_index ( size_t, KeyID, F ) const;
+	template <class F> F for_each_nbr_index ( size_t, F ) const;
+	template <class F>
+	F for_each_nbr_to_index ( size_t, const K&, F ) const;
+	template <class F> F for_each_nbr_to_index ( size_t, KeyID, F ) const;
+	template <class F> F for_each_nbr_to_index ( size_t, F ) const;
+	template <class F>
+	F for_each_nbr_from_index ( size_t, const K&, F ) const;
+	template <class F> F for_each_nbr_from_index ( size_t, KeyID, F ) const;
+	template <class F> F for_each_nbr_from_index ( size_t, F ) const;
+	template <class F> F for_each_edge_index ( const K&, F ) const;
+	template <class F> F for_each_edge_index ( KeyID, F ) const;
+	
+	// connected components; kept only after track_components(), and
+	// until then connected searches and component returns NO_INDEX
+	void track_components ( bool on=true );
+	bool tracks_components () const;
+	bool connected ( Id, Id, const K& );
+	bool connected ( Id, Id, KeyID );
+	bool connected ( Id, Id );
+	size_t component ( Id, const K& );
+	size_t component ( Id, KeyID );
+	size_t component ( Id );
+	bool connected ( Id, Id, const K& ) const;
+	bool connected ( Id, Id, KeyID ) const;
+	bool connected ( Id, Id ) const;
+	size_t component ( Id, const K& ) const;
+	size_t component ( Id, KeyID ) const;
+	size_t component ( Id ) const;
+	
+	std::set<K> keys () const;
+	std::set<K> keys (Id) const;
+	std::set<K> keys (Id, Id) const;
+	bool contains (Id, Id, const K&, bool) const;
+	bool contains (Id, Id, KeyID, bool) const;
+	bool contains_dir (Id, Id, const K&) const;
+	bool contains_dir (Id, Id, KeyID) const;
+	bool contains_undir (Id, Id, const K&) const;
+	bool contains_undir (Id, Id, KeyID) const;
+	bool contains (Id, Id, const K&) const;
+	bool contains (Id, Id, KeyID) const;
+	bool contains_dir (Id, Id) const;
+	bool contains_undir (Id, Id) const;
+	bool contains (Id, Id) const;
+	bool contains_dir (Id) const;
+	bool contains_undir (Id) const;
+	bool contains (Id) const;
+	W get (Id, Id, const K&) const;
+	W get (Id, Id, KeyID) const;
+	W get (Id, Id) const;
+	template <class It, class Out> void get_batch ( It, It, Out ) const;
+	template <class It, class Out>
+	void contains_batch ( It, It, Out ) const;
+	void set (Id, Id, const K&, bool, W);
+	void set (Id, Id, KeyID, bool, W);
+	void set (Id, Id, const K&, W);
+	void set (Id, Id, KeyID, W);
+	void set_dir (Id, Id, const K&, W);
+	void set_dir (Id, Id, KeyID, W);
+	void set_undir (Id, Id, const K&, W);
+	void set_undir (Id, Id, KeyID, W);
+	void set (Id, Id, W);
+	void set_dir (Id, Id, W);
+	void set_undir (Id, Id, W);
+	void clear_dir (Id, Id);
+	void clear_undir (Id, Id);
+	void clear (Id, Id);
+	void clear (Id, Id, const K&, bool);
+	void clear (Id, Id, KeyID, bool);
+	void clear_dir (Id, Id, const K&);
+	void clear_dir (Id, Id, KeyID);
+	void clear_undir (Id, Id, const K&);
+	void clear_undir (Id, Id, KeyID);
+	void clear (Id, Id, const K&);
+	void clear (Id, Id, KeyID);
+	void clear_dir (Id, const K&);
+	void clear_dir (Id, KeyID);
+	void clear_undir (Id, const K&);
+	void clear_undir (Id, KeyID);
+	void clear (Id, const K&);
+	void clear (Id, KeyID);
+	void clear (Id);
+	void clear (const K&);
+	void clear (KeyID);
+	void clear ();
+}; // BasicGraph
+
+// The original graph: int vertex IDs, string keys, float values.
+typedef BasicGraph<int, std::string, float> Graph;
+
+// The same, with its vertices and neighbors in hash maps.
+typedef BasicGraph<int, std::string, float, HashedMaps> HashGraph;
+
+template <class Id, class K, class W, class S>
+const unsigned char BasicGraph<Id,K,W,S>::UNDIRECTED = 0;
+template <class Id, class K, class W, class S>
+const unsigned char BasicGraph<Id,K,W,S>::FROM = 1;
+template <class Id, class K, class W, class S>
+const unsigned char BasicGraph<Id,K,W,S>::TO = 2;
+template <class Id, class K, class W, class S>
+const KeyID BasicGraph<Id,K,W,S>::NO_KEY = KeyID(~0u);
+template <class Id, class K, class W, class S>
+const size_t BasicGraph<Id,K,W,S>::NO_INDEX = ~(size_t)0;
+template <class Id, class K, class W, class S>
+const typename BasicGraph<Id,K,W,S>::NbrMap BasicGraph<Id,K,W,S>::NO_NBRS;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>::BasicGraph ( bool dir, W x )
+: pool(new NodePool),
+  data(Alloc(PoolAllocator<int>(pool.get()))), indexed(false),
+  edge_count(0), rel_sum(0), dense(false), tracked(false), dead(0),
+  directed(dir), no_relationship(x)
+{
+	intern(K());
+}
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>::BasicGraph ( const BasicGraph& g )
+: pool(new NodePool),
+  data(g.data, Alloc(PoolAllocator<int>(pool.get()))),
+  indexed(g.indexed), edge_count(g.edge_count), key_edges(g.key_edges),
+  rel_sum(g.rel_sum), key_hashes(g.key_hashes),
+  dense(g.dense), ids(g.ids), tracked(g.tracked), parts(g.parts),
+  slot_ids(g.slot_ids), live(g.live), dead(g.dead),
+  directed(g.directed), no_relationship(g.no_relationship)
+{
+	key_names = g.key_names;
+	key_ids = g.key_ids;
+	copy_index(g);
+}
+
+// Take over the contents of g, including its pool, without copying.
+// g is left empty and without a pool or keys; it may be assigned to,
+// swapped, cleared, or destroyed, and clear() makes it an ordinary
+// empty graph again.
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>::BasicGraph ( BasicGraph&& g ) noexcept
+: data(Alloc(PoolAllocator<int>())), indexed(false), edge_count(0),
+  rel_sum(0), dense(false), tracked(false), dead(0),
+  directed(g.directed), no_relationship(g.no_relationship)
+{
+	swap(g);
+}
+
+// Copy a graph that keeps its vertices in maps of another type, with
+// the same contents and KeyIDs; for example, to put a hashed graph in
+// order.
+template <class Id, class K, class W, class S>
+template <class S2>
+BasicGraph<Id,K,W,S>::BasicGraph ( const BasicGraph<Id,K,W,S2>& g )
+: pool(new NodePool),
+  data(Alloc(PoolAllocator<int>(pool.get()))), indexed(false),
+  edge_count(0), rel_sum(0), dense(false), tracked(false), dead(0),
+  directed(g.directed), no_relationship(g.no_relationship)
+{
+	for ( size_t k = 0; k < g.num_keys(); ++k ) intern(g.key_name(KeyID(k)));
+	
+	// every relationship, back-links included, as it is stored
+	typedef BasicGraph<Id,K,W,S2> G;
+	typename G::VertexRange R = g.vertex_range();
+	for ( typename G::VertexIterator it = R.begin(); it != R.end(); ++it ) {
+		NbrMap& V = data[*it];
+		typename G::ArcRange E = g.edges(*it);
+		for ( typename G::ArcIterator at = E.begin(); at != E.end(); ++at ) {
+			typename G::Arc a = *at;
+			V[a.j][a.key.id] = Rel(a.out, a.out ? a.x : -1 * a.x);
+		}
+	}
+	reindex();
+}
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>::~BasicGraph () {}
+
+
+// OPERATORS ////////////////////////////////////////////////////////
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>& BasicGraph<Id,K,W,S>::operator= ( const BasicGraph& g )
+{
+	if ( this == &g ) return *this;
+	if ( !pool ) {
+		// moved-from; take a pool along with the copy
+		BasicGraph t (g);
+		swap(t);
+		return *this;
+	}
+	directed = g.directed;
+	no_relationship = g.no_relationship;
+	data = g.data;
+	key_names = g.key_names;
+	key_ids = g.key_ids;
+	indexed = g.indexed;
+	copy_index(g);
+	edge_count = g.edge_count;
+	key_edges = g.key_edges;
+	rel_sum = g.rel_sum;
+	key_hashes = g.key_hashes;
+	dense = g.dense;
+	ids = g.ids;
+	tracked = g.tracked;
+	parts = g.parts;
+	slot_ids = g.slot_ids;
+	live = g.live;
+	dead = g.dead;
+	return *this;
+}
+
+// Release this graph's contents and take over those of g, as the
+// move constructor does.
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>&
+BasicGraph<Id,K,W,S>::operator= ( BasicGraph&& g ) noexcept
+{
+	if ( this == &g ) return *this;
+	BasicGraph t (std::move(g));
+	swap(t);
+	return *this;
+}
+
+// Exchange contents, pools, and settings with g in constant time.
+// KeyIDs and ranges follow the contents they were issued for.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::swap ( BasicGraph& g ) noexcept
+{
+	pool.swap(g.pool);
+	data.swap(g.data);
+	std::swap(directed, g.directed);
+	std::swap(no_relationship, g.no_relationship);
+	key_names.swap(g.key_names);
+	key_ids.swap(g.key_ids);
+	std::swap(indexed, g.indexed);
+	key_index.swap(g.key_index);
+	std::swap(edge_count, g.edge_count);
+	key_edges.swap(g.key_edges);
+	std::swap(rel_sum, g.rel_sum);
+	key_hashes.swap(g.key_hashes);
+	std::swap(dense, g.dense);
+	ids.swap(g.ids);
+	std::swap(tracked, g.tracked);
+	parts.swap(g.parts);
+	slot_ids.swap(g.slot_ids);
+	live.swap(g.live);
+	std::swap(dead, g.dead);
+}
+
+template <class Id, class K, class W, class S>
+void swap ( BasicGraph<Id,K,W,S>& a, BasicGraph<Id,K,W,S>& b ) noexcept
+{
+	a.swap(b);
+}
+
+// Three-way comparison of relationship sets, ordered by key name so
+// that graphs which interned their keys in different orders compare
+// the same way they did before keys were interned.
+template <class Id, class K, class W, class S>
+int BasicGraph<Id,K,W,S>::compare (
+	const RelMap& A, const BasicGraph& g, const RelMap& B ) const
+{
+	std::map<K, Rel> a, b;
+	typename RelMap::const_iterator kt;
+	for ( kt = A.begin(); kt != A.end(); ++kt )
+		a[key_names[kt->first]] = kt->second;
+	for ( kt = B.begin(); kt != B.end(); ++kt )
+		b[g.key_names[kt->first]] = kt->second;
+	if ( a < b ) return -1;
+	if ( b < a ) return 1;
+	return 0;
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::operator< ( const BasicGraph& g ) const
+{
+	// hashed maps have no order to walk; compare ordered copies
+	if ( !S::ORDERED ) {
+		return BasicGraph<Id,K,W,OrderedMaps>(*this)
+			< BasicGraph<Id,K,W,OrderedMaps>(g);
+	}
+	
+	// vertices
+	typename VertexMap::const_iterator it = data.begin();
+	typename VertexMap::const_iterator gt = g.data.begin();
+	for ( ; it != data.end() && gt != g.data.end(); ++it, ++gt ) {
+		if ( it->first != gt->first ) return it->first < gt->first;
+		
+		// neighbors
+		typename NbrMap::const_iterator jt = it->second.begin();
+		typename NbrMap::const_iterator ht = gt->second.begin();
+		for ( ; jt != it->second.end() && ht != gt->second.end();
+				++jt, ++ht ) {
+			if ( jt->first != ht->first ) return jt->first < ht->first;
+			int c = compare(jt->second, g, ht->second);
+			if ( c != 0 ) return c < 0;
+		}
+		if ( jt != it->second.end() ) return false;
+		if ( ht != gt->second.end() ) return true;
+	}
+	return it == data.end() && gt != g.data.end();
+}
+
+// True if the graphs have the same relationships, by key name, and the
+// same settings. Graphs that differ almost always differ in hash(), so
+// that is checked first; equal graphs are confirmed by diff.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::operator== ( const BasicGraph& g ) const
+{
+	if ( directed != g.directed || no_relationship != g.no_relationship )
+		return false;
+	if ( edge_count != g.edge_count || rel_sum != g.rel_sum ) return false;
+	return data.size() == g.data.size() && diff(g).empty();
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::operator!= ( const BasicGraph& g ) const
+{
+	return !(*this == g);
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of an interned key, or NO_KEY if the graph has never
+// seen the key.
+template <class Id, class K, class W, class S>
+KeyID BasicGraph<Id,K,W,S>::key_id ( const K& key ) const
+{
+	typename std::map<K, unsigned int>::const_iterator it =
+		key_ids.find(key);
+	if ( it == key_ids.end() ) return NO_KEY;
+	return KeyID(it->second);
+}
+
+// Get the ID of the key, interning it if it is new. IDs are never
+// reused or invalidated, even if every relationship with that key is
+// removed.
+template <class Id, class K, class W, class S>
+KeyID BasicGraph<Id,K,W,S>::intern ( const K& key )
+{
+	typename std::map<K, unsigned int>::const_iterator it =
+		key_ids.find(key);
+	if ( it != key_ids.end() ) return KeyID(it->second);
+	unsigned int k = key_names.size();
+	key_names.push_back(key);
+	key_ids[key] = k;
+	key_edges.push_back(0);
+	key_hashes.push_back(hash_of(key));
+	if ( indexed ) key_index.push_back(KeyIndex(index_alloc()));
+	return KeyID(k);
+}
+
+// Get the key named by the ID.
+template <class Id, class K, class W, class S>
+const K& BasicGraph<Id,K,W,S>::key_name ( KeyID k ) const
+{
+	return key_names[k.id];
+}
+
+// Get the number of keys interned by the graph (including "").
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::num_keys () const
+{
+	return key_names.size();
+}
+
+
+// KEY INDEX ////////////////////////////////////////////////////////
+
+// Keep (or stop keeping) an index from each key to the pairs of
+// vertices whose relationships have it, so that clear(key),
+// for_each_edge(key), filter_key, degree(i, key), the keyed neighbor
+// queries, and the components of a key take time in proportion to the
+// relationships with the key, not to all of them (or all of a
+// vertex's). Turning it on indexes every relationship; after that,
+// each set and clear keeps it. Copies keep it, and subgraphs start
+// without it. It costs a node per relationship and one per vertex and
+// key: on 400k random relationships between 100k vertices, 116 bytes
+// more per relationship with one key and 178 more with four, over the
+// 262 of the graph without it (44% and 68%). NoKey graphs, which have
+// one key, never keep it.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::index_keys ( bool on )
+{
+	indexed = on && RelStore<K, W>::INDEXED;
+	std::vector<KeyIndex>().swap(key_index);
+	if ( indexed ) build_index();
+}
+
+// True if the graph keeps an index by key.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::indexes_keys () const
+{
+	return indexed;
+}
+
+// Allocator that draws index nodes from the graph's pool.
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::KeyIndex::allocator_type
+BasicGraph<Id,K,W,S>::index_alloc () const
+{
+	return typename KeyIndex::allocator_type(PoolAllocator<int>(pool.get()));
+}
+
+// Record that the relationships from i to j now include key k.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::index_add ( unsigned int k, Id i, Id j )
+{
+	if ( indexed ) key_index[k][i].insert(j);
+}
+
+// Record that the relationships from i to j no longer include key k.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::index_remove ( unsigned int k, Id i, Id j )
+{
+	if ( !indexed ) return;
+	KeyIndex& X = key_index[k];
+	typename KeyIndex::iterator xt = X.find(i);
+	xt->second.erase(j);
+	if ( xt->second.size() == 0 ) X.erase(xt);
+}
+
+// Copy g's index into this graph's pool.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::copy_index ( const BasicGraph& g )
+{
+	key_index.clear();
+	key_index.reserve(g.key_index.size());
+	for ( size_t k = 0; k < g.key_index.size(); ++k )
+		key_index.push_back(KeyIndex(g.key_index[k], index_alloc()));
+}
+
+// Build the index from the maps, for every interned key, in one pass;
+// pairs arrive in order, so each insertion is hinted.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::build_index ()
+{
+	key_index.clear();
+	key_index.resize(key_names.size(), KeyIndex(index_alloc()));
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		typename NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) {
+			typename RelMap::const_iterator kt = jt->second.begin();
+			for ( ; kt != jt->second.end(); ++kt ) {
+				KeyIndex& X = key_index[kt->first];
+				typename KeyIndex::iterator xt = X.end();
+				if ( X.size() == 0 || (--xt)->first != it->first ) {
+					xt = X.emplace_hint(X.end(), std::piecewise_construct,
+						std::forward_as_tuple(it->first),
+						std::forward_as_tuple());
+				}
+				xt->second.insert(xt->second.end(), jt->first);
+			}
+		}
+	}
+}
+
+// Rebuild the counters from the maps, and the index if it is kept.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::reindex ()
+{
+	edge_count = 0;
+	key_edges.assign(key_names.size(), 0);
+	rel_sum = 0;
+	key_hashes.clear();
+	for ( size_t k = 0; k < key_names.size(); ++k )
+		key_hashes.push_back(hash_of(key_names[k]));
+	
+	typename VertexMap::iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		it->second.out = it->second.in = 0;
+		it->second.from.clear();
+	}
+	for ( it = data.begin(); it != data.end(); ++it ) {
+		typename NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) {
+			if ( flags(jt->second) ) {
+				Row& J = data.find(jt->first)->second;
+				++it->second.out;
+				++J.in;
+				J.from.insert(J.from.end(), it->first);
+			}
+			typename RelMap::const_iterator kt = jt->second.begin();
+			for ( ; kt != jt->second.end(); ++kt ) {
+				if ( kt->second.first ) {
+					++edge_count;
+					++key_edges[kt->first];
+					rel_sum += rel_hash(it->first, jt->first, kt->first,
+						kt->second.second);
+				}
+			}
+		}
+	}
+	if ( indexed ) build_index();
+	else key_index.clear();
+	if ( dense ) number_all();
+	if ( tracked ) slot_all();
+}
+
+
+// ITERATION ////////////////////////////////////////////////////////
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>::ArcIterator::ArcIterator (
+	typename NbrMap::const_iterator a, typename NbrMap::const_iterator b,
+	bool out )
+: jt(a), jend(b), out_only(out)
+{
+	if ( jt != jend ) kt = jt->second.begin();
+	skip();
+}
+
+// Advance to the next relationship that should be visited.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::ArcIterator::skip ()
+{
+	while ( jt != jend ) {
+		if ( kt == jt->second.end() ) {
+			if ( ++jt != jend ) kt = jt->second.begin();
+		}
+		else if ( out_only && !kt->second.first ) ++kt;
+		else return;
+	}
+}
+
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::Arc
+BasicGraph<Id,K,W,S>::ArcIterator::operator* () const
+{
+	Arc a;
+	a.j = jt->first;
+	a.key = KeyID(kt->first);
+	a.out = kt->second.first;
+	a.x = a.out ? kt->second.second : -1 * kt->second.second;
+	return a;
+}
+
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::ArcIterator&
+BasicGraph<Id,K,W,S>::ArcIterator::operator++ ()
+{
+	++kt;
+	skip();
+	return *this;
+}
+
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::ArcIterator
+BasicGraph<Id,K,W,S>::ArcIterator::operator++ (int)
+{
+	ArcIterator t (*this);
+	++(*this);
+	return t;
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::ArcIterator::operator== (
+	const ArcIterator& a ) const
+{
+	return jt == a.jt && (jt == jend || kt == a.kt);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::ArcIterator::operator!= (
+	const ArcIterator& a ) const
+{
+	return !(*this == a);
+}
+
+// Range of the vertex IDs, as vertices() without the copy.
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::VertexRange
+BasicGraph<Id,K,W,S>::vertex_range () const
+{
+	return VertexRange(VertexIterator(data.begin()),
+		VertexIterator(data.end()));
+}
+
+// Range of the relationships from i to other vertices.
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::ArcRange
+BasicGraph<Id,K,W,S>::out_edges ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	const NbrMap& V = it == data.end() ? NO_NBRS : it->second;
+	return ArcRange(ArcIterator(V.begin(), V.end(), true),
+		ArcIterator(V.end(), V.end(), true));
+}
+
+// Range of all of the relationships associated with i, in either
+// direction. Relationships only toward i have out == false.
+template <class Id, class K, class W, class S>
+typename BasicGraph<Id,K,W,S>::ArcRange
+BasicGraph<Id,K,W,S>::edges ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	const NbrMap& V = it == data.end() ? NO_NBRS : it->second;
+	return ArcRange(ArcIterator(V.begin(), V.end(), false),
+		ArcIterator(V.end(), V.end(), false));
+}
+
+// Call f(j) for each neighbor j, as nbrs() without the copy. Returns
+// f, as std::for_each does.
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr ( Id i, const K& key, F f ) const
+{
+	return for_each_nbr(i, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr ( Id i, KeyID key, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR, pool.get());
+	visit(i, UNDIRECTED, true, key.id, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr ( Id i, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR, pool.get());
+	visit(i, UNDIRECTED, false, 0, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to ( Id i, const K& key, F f ) const
+{
+	return for_each_nbr_to(i, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to ( Id i, KeyID key, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_TO, pool.get());
+	visit(i, TO, true, key.id, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to ( Id i, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_TO, pool.get());
+	visit(i, TO, false, 0, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from ( Id i, const K& key, F f ) const
+{
+	return for_each_nbr_from(i, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from ( Id i, KeyID key, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_FROM, pool.get());
+	visit(i, FROM, true, key.id, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from ( Id i, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_FROM, pool.get());
+	visit(i, FROM, false, 0, f);
+	return f;
+}
+
+// Call f(i, j, x) for each relationship from i toward j with the key,
+// in (i, j) order, where x is its value; an undirected relationship is
+// visited from both ends. With the key index, takes time in proportion
+// to the number of relationships with the key; otherwise visits every
+// relationship. Returns f.
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_edge ( const K& key, F f ) const
+{
+	return for_each_edge(key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_edge ( KeyID key, F f ) const
+{
+	if ( !indexed ) {
+		typename VertexMap::const_iterator it = data.begin();
+		for ( ; it != data.end(); ++it ) {
+			typename NbrMap::const_iterator jt = it->second.begin();
+			for ( ; jt != it->second.end(); ++jt ) {
+				typename RelMap::const_iterator kt = jt->second.find(key.id);
+				if ( kt == jt->second.end() || !kt->second.first ) continue;
+				f(it->first, jt->first, kt->second.second);
+			}
+		}
+		return f;
+	}
+	
+	if ( key.id >= key_index.size() ) return f;
+	const KeyIndex& X = key_index[key.id];
+	typename KeyIndex::const_iterator xt = X.begin();
+	for ( ; xt != X.end(); ++xt ) {
+		const NbrMap& V = data.find(xt->first)->second;
+		typename IdSet::const_iterator nt = xt->second.begin();
+		for ( ; nt != xt->second.end(); ++nt ) {
+			const Rel& R = V.find(*nt)->second.find(key.id)->second;
+			if ( R.first ) f(xt->first, *nt, R.second);
+		}
+	}
+	return f;
+}
+
+
+// DENSE INDICES ////////////////////////////////////////////////////
+
+// Give vertex v the next index, if it is in the graph and has none.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::number ( Id v )
+{
+	typename VertexMap::iterator it = data.find(v);
+	if ( it == data.end() || it->second.index != NO_INDEX ) return;
+	it->second.index = ids.size();
+	ids.push_back(v);
+}
+
+// Number every vertex again, in the order of the vertex map.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::number_all ()
+{
+	ids.clear();
+	ids.reserve(data.size());
+	typename VertexMap::iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		it->second.index = ids.size();
+		ids.push_back(it->first);
+	}
+}
+
+// Remove vertex v, which must have no neighbors left, from the map;
+// the last index moves into the place of v's so that the indices stay
+// dense.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::erase_vertex ( Id v )
+{
+	typename VertexMap::iterator it = data.find(v);
+	if ( it != data.end() ) erase_vertex(it);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::erase_vertex ( typename VertexMap::iterator it )
+{
+	size_t r = it->second.index;
+	if ( tracked && it->second.slot != NO_INDEX ) {
+		live[it->second.slot] = 0;
+		++dead;
+	}
+	data.erase(it);
+	if ( !dense || r == NO_INDEX ) return;
+	Id last = ids.back();
+	ids.pop_back();
+	if ( r == ids.size() ) return;
+	ids[r] = last;
+	data.find(last)->second.index = r;
+}
+
+// Keep (or stop keeping) a dense index 0..size()-1 for every vertex,
+// so that per-vertex state can be held in vectors. Turning it on
+// numbers the vertices in the order vertex_range() visits them; after
+// that, a new vertex takes the next index, and removing a vertex gives
+// its index to the vertex that had the last one. Loading in bulk
+// numbers the vertices afresh. Indices cost a word per vertex, and a
+// little time whenever a vertex is added or removed.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::number_vertices ( bool on )
+{
+	dense = on;
+	if ( on ) number_all();
+	else std::vector<Id>().swap(ids);
+}
+
+// Number the vertices in the given order, and keep them numbered as
+// number_vertices(true) does: the n-th vertex of order that is in the
+// graph gets index n, and the vertices order leaves out follow, in the
+// order vertex_range() visits them. IDs not in the graph, and repeats,
+// are skipped. GraphPartition.hpp makes orders that put neighbors at
+// nearby indices.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::number_vertices ( const std::vector<Id>& order )
+{
+	dense = true;
+	ids.clear();
+	ids.reserve(data.size());
+	typename VertexMap::iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) it->second.index = NO_INDEX;
+	for ( size_t n = 0; n < order.size(); ++n ) number(order[n]);
+	for ( it = data.begin(); it != data.end(); ++it ) number(it->first);
+}
+
+// True if the graph keeps dense indices.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::numbered () const
+{
+	return dense;
+}
+
+// Get the index of vertex i, or NO_INDEX if it is not in the graph or
+// the graph is not numbered. Takes a vertex lookup.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::index ( Id i ) const
+{
+	if ( !dense ) return NO_INDEX;
+	typename VertexMap::const_iterator it = data.find(i);
+	return it == data.end() ? NO_INDEX : it->second.index;
+}
+
+// Get the vertex with index r < size(), in constant time.
+template <class Id, class K, class W, class S>
+Id BasicGraph<Id,K,W,S>::vertex ( size_t r ) const
+{
+	return ids[r];
+}
+
+// Call f(s) for the index s of each neighbor of the vertex with index
+// r, as for_each_nbr does with IDs. Returns f.
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_index ( size_t r, const K& key,
+	F f ) const
+{
+	return for_each_nbr_index(r, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_index ( size_t r, KeyID key, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], UNDIRECTED, true, key.id, b);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_index ( size_t r, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], UNDIRECTED, false, 0, b);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to_index ( size_t r, const K& key,
+	F f ) const
+{
+	return for_each_nbr_to_index(r, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to_index ( size_t r, KeyID key,
+	F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_TO_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], TO, true, key.id, b);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_to_index ( size_t r, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_TO_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], TO, false, 0, b);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from_index ( size_t r, const K& key,
+	F f ) const
+{
+	return for_each_nbr_from_index(r, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from_index ( size_t r, KeyID key,
+	F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_FROM_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], FROM, true, key.id, b);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_nbr_from_index ( size_t r, F f ) const
+{
+	GraphProbe p (tally(), GraphStats::FOR_EACH_NBR_FROM_INDEX, pool.get());
+	ByIndex<F> b (this, f);
+	visit(ids[r], FROM, false, 0, b);
+	return f;
+}
+
+// Call f(r, s, x) for each relationship with the key, as for_each_edge
+// does, with the indices r and s of its vertices. Returns f.
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_edge_index ( const K& key, F f ) const
+{
+	return for_each_edge_index(key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicGraph<Id,K,W,S>::for_each_edge_index ( KeyID key, F f ) const
+{
+	for_each_edge(key, ByIndex<F>(this, f));
+	return f;
+}
+
+
+// CONNECTED COMPONENTS /////////////////////////////////////////////
+
+// Get the part that holds the components of key ID k. Without keys,
+// every relationship has key ID 0, and they are those of parts[0].
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::part ( unsigned int k ) const
+{
+	return RelStore<K, W>::INDEXED ? k + 1 : 0;
+}
+
+// Give vertex v the next slot, if it is in the graph and has none, as
+// a component of its own in every part that has been made.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::place ( Id v )
+{
+	typename VertexMap::iterator it = data.find(v);
+	if ( it == data.end() || it->second.slot != NO_INDEX ) return;
+	it->second.slot = slot_ids.size();
+	slot_ids.push_back(v);
+	live.push_back(1);
+	for ( size_t c = 0; c < parts.size(); ++c )
+		if ( parts[c].made ) parts[c].sets.add();
+}
+
+// Give every vertex a slot again, in the order of the vertex map, so
+// that the slots of removed vertices are dropped, and make every part
+// that has been made again.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::slot_all ()
+{
+	slot_ids.clear();
+	slot_ids.reserve(data.size());
+	typename VertexMap::iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		it->second.slot = slot_ids.size();
+		slot_ids.push_back(it->first);
+	}
+	live.assign(slot_ids.size(), 1);
+	dead = 0;
+	for ( size_t c = 0; c < parts.size(); ++c )
+		if ( parts[c].made ) build_part(c);
+}
+
+// Join the components of i and j, which have gained a relationship
+// with key ID k. Nothing is joined until both have rows; j's comes
+// with the back-link, which joins them.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::join ( Id i, Id j, unsigned int k )
+{
+	typename VertexMap::iterator it = data.find(i);
+	typename VertexMap::iterator jt = data.find(j);
+	if ( it == data.end() || jt == data.end() ) return;
+	size_t a = it->second.slot;
+	size_t b = jt->second.slot;
+	if ( a == NO_INDEX || b == NO_INDEX ) return;
+	if ( parts.size() > 0 && parts[0].made ) parts[0].sets.unite(a, b);
+	size_t c = part(k);
+	if ( c > 0 && c < parts.size() && parts[c].made )
+		parts[c].sets.unite(a, b);
+}
+
+// Note that i has lost a relationship with j with key ID k, and if
+// all, its last one with j, so that their components may have come
+// apart. They are checked when next asked for. Once most slots belong
+// to removed vertices (or to vertices moved out of a component), the
+// slots are given out again first; this waits for a change to the
+// graph so that component IDs do not change between queries.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::cut ( Id i, Id j, unsigned int k, bool all )
+{
+	if ( i == j ) return;
+	if ( dead > slot_ids.size() / 2 ) slot_all();
+	size_t a = data.find(i)->second.slot;
+	typename VertexMap::iterator jt = data.find(j);
+	size_t b = jt == data.end() ? NO_INDEX : jt->second.slot;
+	if ( a == NO_INDEX ) return;
+	if ( all ) note_cut(0, a, b);
+	size_t c = part(k);
+	if ( c > 0 ) note_cut(c, a, b);
+}
+
+// Mark slot a's component in part c as one that may have come apart,
+// keeping the pair (a, b) to check. With too many pairs to check (or
+// without b), the part is dropped, to be made again when asked for.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::note_cut ( size_t c, size_t a, size_t b )
+{
+	if ( c >= parts.size() || !parts[c].made ) return;
+	Part& P = parts[c];
+	if ( b == NO_INDEX || P.cuts.size() > slot_ids.size() ) {
+		P.made = false;
+		P.sets.reset(0);
+		std::vector<std::pair<size_t, size_t> >().swap(P.cuts);
+		return;
+	}
+	P.sets.invalidate(a);
+	if ( P.cuts.size() > 0 && (P.cuts.back() == std::make_pair(a, b)
+			|| P.cuts.back() == std::make_pair(b, a)) )
+		return;
+	P.cuts.push_back(std::make_pair(a, b));
+}
+
+// Join vertex v to each of its neighbors in part c.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::join_row ( size_t c, Id v )
+{
+	typename VertexMap::const_iterator it = data.find(v);
+	UnionFind& U = parts[c].sets;
+	size_t a = it->second.slot;
+	joins(it, c, [&] ( Id j ) -> bool {
+		U.unite(a, data.find(j)->second.slot);
+		return false;
+	});
+}
+
+// Make part c from the relationships, in time proportional to the
+// number of them it joins; for a key without the key index, to the
+// number of all of them.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::build_part ( size_t c )
+{
+	if ( parts.size() <= c ) parts.resize(c + 1);
+	Part& P = parts[c];
+	P.sets.reset(slot_ids.size());
+	P.cuts.clear();
+	P.made = true;
+	if ( c == 0 || !indexed ) {
+		typename VertexMap::const_iterator it = data.begin();
+		for ( ; it != data.end(); ++it ) join_row(c, it->first);
+		return;
+	}
+	const KeyIndex& X = key_index[c - 1];
+	typename KeyIndex::const_iterator xt = X.begin();
+	for ( ; xt != X.end(); ++xt ) join_row(c, xt->first);
+}
+
+// Search part c from both a and b, which have lost a relationship,
+// for a path between them, within limit vertices. Returns 1 if there
+// is one, or -1 if there is none, with the vertices of the side that
+// ran out (the whole component of its end) in piece; 0 if the search
+// stopped first.
+template <class Id, class K, class W, class S>
+int BasicGraph<Id,K,W,S>::linked ( size_t c, Id a, Id b, size_t limit,
+	std::vector<Id>& piece ) const
+{
+	typedef typename VertexMap::const_iterator Vit;
+	FlatHashMap<size_t, int> seen;        // slot -> side it was found from
+	std::vector<Vit> Q[2];
+	size_t head[2] = { 0, 0 };
+	Q[0].push_back(data.find(a));
+	Q[1].push_back(data.find(b));
+	seen[Q[0][0]->second.slot] = 0;
+	seen[Q[1][0]->second.slot] = 1;
+	
+	// true if j was found from the other side
+	auto meet = [&] ( int t, Vit jt ) -> bool {
+		FlatHashMap<size_t, int>::iterator st = seen.find(jt->second.slot);
+		if ( st != seen.end() ) return st->second != t;
+		seen[jt->second.slot] = t;
+		Q[t].push_back(jt);
+		return false;
+	};
+	
+	// grow the side with less left to search
+	while ( seen.size() < limit ) {
+		int t = Q[0].size() - head[0] <= Q[1].size() - head[1] ? 0 : 1;
+		if ( head[t] == Q[t].size() ) {
+			for ( size_t q = 0; q < Q[t].size(); ++q )
+				piece.push_back(Q[t][q]->first);
+			return -1;
+		}
+		Vit v = Q[t][head[t]++];
+		if ( joins(v, c, [&] ( Id j ) { return meet(t, data.find(j)); }) )
+			return 1;
+	}
+	return 0;
+}
+
+// Move the vertices of piece, a component of part c that has come
+// away from the rest of its set, to new slots, joined to each other
+// in part c. In the other parts each new slot is joined to the
+// vertex's old one, which stays behind in its set as a removed slot.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::detach ( size_t c, const std::vector<Id>& piece )
+{
+	for ( size_t v = 0; v < piece.size(); ++v ) {
+		size_t& slot = data.find(piece[v])->second.slot;
+		size_t old = slot;
+		live[old] = 0;
+		++dead;
+		slot = NO_INDEX;
+		place(piece[v]);
+		for ( size_t d = 0; d < parts.size(); ++d )
+			if ( d != c && parts[d].made ) parts[d].sets.unite(slot, old);
+	}
+	for ( size_t v = 0; v < piece.size(); ++v ) join_row(c, piece[v]);
+}
+
+// Check the component of slot a in part c, which may have come apart,
+// by searching between the vertices that lost relationships in it:
+// it is whole if they can all still reach one of them. Each search
+// that finds none moves the piece that came away out of it; if a
+// search stops short, the component is split into its vertices and
+// joined again from their relationships, in time proportional to its
+// size. Each search may visit about the square root of the size of
+// the component, which is about what it takes to find a path between
+// two vertices of a random graph from both ends.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::repair ( size_t c, size_t a )
+{
+	Part& P = parts[c];
+	size_t r = P.sets.find(a);
+	size_t limit = 256 + 16 * (size_t)std::sqrt((double)P.sets.set_size(r));
+	std::vector<size_t> ends;
+	size_t n = 0;
+	for ( size_t t = 0; t < P.cuts.size(); ++t ) {
+		if ( P.sets.find(P.cuts[t].first) != r )
+			P.cuts[n++] = P.cuts[t];      // another component's
+		
+		// a removed vertex lost all of its relationships, so only the
+		// ends that remain need to reach each other; an end that has
+		// been moved to another slot (by detach) is looked for there
+		else {
+			size_t e[2] = { P.cuts[t].first, P.cuts[t].second };
+			for ( size_t s = 0; s < 2; ++s ) {
+				if ( !live[e[s]] ) {
+					typename VertexMap::const_iterator it =
+						data.find(slot_ids[e[s]]);
+					if ( it == data.end() ) continue;
+					e[s] = it->second.slot;
+				}
+				if ( P.sets.find(e[s]) == r ) ends.push_back(e[s]);
+			}
+		}
+	}
+	P.cuts.resize(n);
+	std::sort(ends.begin(), ends.end());
+	ends.erase(std::unique(ends.begin(), ends.end()), ends.end());
+	
+	// search from ends[f] to each other end still in the component,
+	// going on from the next if ends[f] is in the piece that came away
+	bool whole = true;
+	size_t f = 0;
+	for ( size_t t = 1; whole && t < ends.size(); ++t ) {
+		Id i = slot_ids[ends[f]];
+		Id j = slot_ids[ends[t]];
+		if ( P.sets.find(data.find(j)->second.slot) != r ) continue;
+		std::vector<Id> piece;
+		int l = linked(c, i, j, limit, piece);
+		whole = l != 0;
+		if ( l > 0 ) continue;
+		detach(c, piece);
+		if ( P.sets.find(data.find(i)->second.slot) != r ) f = t;
+	}
+	if ( whole ) {
+		P.sets.validate(r);
+		return;
+	}
+	std::vector<size_t> M = P.sets.split(r);
+	for ( size_t m = 0; m < M.size(); ++m )
+		if ( live[M[m]] ) join_row(c, slot_ids[M[m]]);
+}
+
+// Get the root of i's component in part c, or NO_INDEX if i is not
+// in the graph or the graph does not track its components. Makes the
+// part if need be, and checks the component first if it may have
+// come apart.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::root ( Id i, size_t c )
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() || !tracked ) return NO_INDEX;
+	if ( c >= parts.size() || !parts[c].made ) build_part(c);
+	if ( parts[c].sets.is_stale(it->second.slot) )
+		repair(c, it->second.slot);
+	return parts[c].sets.find(it->second.slot);
+}
+
+// Get the root of i's component in part c as root does, but without
+// changing the graph: NO_INDEX if i is not in the graph or the graph
+// does not track its components. A component that may have come apart
+// (or that of a part not yet made) is searched instead, and named for
+// its least slot, which is not the root of any other component.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::root ( Id i, size_t c ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() || !tracked ) return NO_INDEX;
+	if ( c < parts.size() && parts[c].made ) {
+		const UnionFind& U = parts[c].sets;
+		size_t a = it->second.slot;
+		if ( !U.is_stale(a) ) return U.find(a);
+	}
+	size_t least;
+	search(c, i, 0, least);
+	return least;
+}
+
+// Search the relationships of part c, in either direction, from i
+// for *j, or through the whole of i's component if j is null. Returns
+// true if *j was found; least is set to the least slot searched, or
+// NO_INDEX if the components are not tracked. Takes time in the size
+// of the component.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::search ( size_t c, Id i, const Id* j,
+	size_t& least ) const
+{
+	std::set<Id> seen;
+	std::vector<typename VertexMap::const_iterator> Q (1, data.find(i));
+	seen.insert(i);
+	least = NO_INDEX;
+	for ( size_t h = 0; h < Q.size(); ++h ) {
+		typename VertexMap::const_iterator v = Q[h];
+		least = std::min(least, v->second.slot);
+		if ( j && v->first == *j ) return true;
+		joins(v, c, [&] ( Id n ) -> bool {
+			if ( seen.insert(n).second ) Q.push_back(data.find(n));
+			return false;
+		});
+	}
+	return false;
+}
+
+// Call f(j) for each neighbor j that v's relationships join it to in
+// part c: those with any key in part 0, and otherwise those with the
+// part's key, which the key index lists if it is kept. Stops, and
+// returns true, once f does.
+template <class Id, class K, class W, class S>
+template <class F>
+bool BasicGraph<Id,K,W,S>::joins ( typename VertexMap::const_iterator v,
+	size_t c, F f ) const
+{
+	if ( c > 0 && indexed ) {
+		const KeyIndex& X = key_index[c - 1];
+		typename KeyIndex::const_iterator xt = X.find(v->first);
+		if ( xt == X.end() ) return false;
+		typename IdSet::const_iterator nt = xt->second.begin();
+		for ( ; nt != xt->second.end(); ++nt )
+			if ( f(*nt) ) return true;
+		return false;
+	}
+	typename NbrMap::const_iterator jt = v->second.begin();
+	for ( ; jt != v->second.end(); ++jt ) {
+		const RelMap& N = jt->second;
+		if ( c == 0 ? N.size() == 0 : N.find(c - 1) == N.end() ) continue;
+		if ( f(jt->first) ) return true;
+	}
+	return false;
+}
+
+// True if i and j are connected in part c, without changing the
+// graph. Vertices in different sets are not; a set that is whole
+// answers at once, and otherwise the relationships are searched.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::joined ( Id i, Id j, size_t c ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	typename VertexMap::const_iterator jt = data.find(j);
+	if ( it == data.end() || jt == data.end() ) return false;
+	if ( c < parts.size() && parts[c].made ) {
+		const UnionFind& U = parts[c].sets;
+		size_t a = it->second.slot;
+		if ( U.find(a) != U.find(jt->second.slot) ) return false;
+		if ( !U.is_stale(a) ) return true;
+	}
+	size_t least;
+	return search(c, i, &j, least);
+}
+
+// Keep (or stop keeping) the connected components of the graph, as if
+// every relationship went both ways, so that connected and component
+// take nearly constant time as the graph changes. Turning it on finds
+// the components of all of the relationships; those of each key are
+// found when they are first asked for. After that, adding a
+// relationship joins two components in nearly constant time. Removing
+// one marks its component as one that may have come apart; when next
+// asked for, it is kept if a short search finds that the vertices
+// that lost relationships can still reach each other, and otherwise
+// rebuilt from its own vertices. Tracking costs about five words per
+// vertex, and four more for each key asked for.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::track_components ( bool on )
+{
+	tracked = on;
+	parts.clear();
+	if ( on ) {
+		slot_all();
+		build_part(0);
+		return;
+	}
+	std::vector<Id>().swap(slot_ids);
+	std::vector<char>().swap(live);
+	dead = 0;
+}
+
+// True if the graph keeps its connected components.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::tracks_components () const
+{
+	return tracked;
+}
+
+// True if i and j are joined by a path of relationships with the key,
+// in either direction; a key that was never interned joins nothing.
+// If the graph does not track its components, searches the
+// relationships, as the const overload does, in time in the size of
+// i's component. If it does, the query may shorten paths or check a
+// component, so it changes the graph: threads that share one use the
+// const overloads below.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j, const K& key )
+{
+	return connected(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j, KeyID key )
+{
+	if ( key.id >= key_names.size() ) return false;
+	if ( !tracked ) return joined(i, j, part(key.id));
+	size_t a = root(i, part(key.id));
+	return a != NO_INDEX && a == root(j, part(key.id));
+}
+
+// True if i and j are joined by a path of relationships of any keys.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j )
+{
+	if ( !tracked ) return joined(i, j, 0);
+	size_t a = root(i, 0);
+	return a != NO_INDEX && a == root(j, 0);
+}
+
+// Get an ID of i's connected component by relationships with the key,
+// or NO_INDEX if i is not in the graph, the key was never interned,
+// or the graph does not track its components.
+// Two vertices have the same ID exactly when they are connected; IDs
+// may change when the graph does, but not from one query to another.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i, const K& key )
+{
+	return component(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i, KeyID key )
+{
+	if ( key.id >= key_names.size() ) return NO_INDEX;
+	return root(i, part(key.id));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i )
+{
+	return root(i, 0);
+}
+
+// As connected and component, but for a const graph: they neither
+// start tracking nor shorten paths or check components, so threads
+// may share the graph while it does not change. connected searches
+// the relationships when the components it needs are not tracked or
+// may have come apart, and so does component, which returns NO_INDEX
+// if the graph does not track its components. The IDs of the const
+// component agree with each other, but may not with those of the
+// non-const one until the graph changes.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j, const K& key ) const
+{
+	return connected(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j, KeyID key ) const
+{
+	if ( key.id >= key_names.size() ) return false;
+	return joined(i, j, part(key.id));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::connected ( Id i, Id j ) const
+{
+	return joined(i, j, 0);
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i, const K& key ) const
+{
+	return component(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i, KeyID key ) const
+{
+	if ( key.id >= key_names.size() ) return NO_INDEX;
+	return root(i, part(key.id));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::component ( Id i ) const
+{
+	return root(i, 0);
+}
+
+
+// BULK LOADING /////////////////////////////////////////////////////
+
+// True if the entries describe the same (i, j, key) relationship.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::same_rel ( const Entry& a, const Entry& b )
+{
+	return a.i == b.i && a.j == b.j && a.k == b.k;
+}
+
+// Order entries by (i, j, key) only.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::rel_less ( const Entry& a, const Entry& b )
+{
+	if ( a.i != b.i ) return a.i < b.i;
+	if ( a.j != b.j ) return a.j < b.j;
+	return a.k < b.k;
+}
+
+// Get the arcs set by the Edge records in [first, last), sorted by
+// (i, j, key), keeping only the last record for each arc. An arc with
+// out == false is one the records remove.
+template <class Id, class K, class W, class S>
+template <class It>
+std::vector<typename BasicGraph<Id,K,W,S>::Entry>
+BasicGraph<Id,K,W,S>::arcs ( It first, It last )
+{
+	// expand records into arcs, in order: an undirected record sets
+	// both directions, and a no_relationship value removes the arc
+	std::vector<Entry> arcs;
+	for ( ; first != last; ++first ) {
+		const Edge& e = *first;
+		Entry a;
+		a.i = e.i;
+		a.j = e.j;
+		a.k = intern(e.key).id;
+		a.out = fabs(e.x - no_relationship) >= 0.0000001;
+		a.x = e.x;
+		arcs.push_back(a);
+		if ( e.undir && e.i != e.j ) {
+			a.i = e.j;
+			a.j = e.i;
+			arcs.push_back(a);
+		}
+	}
+	
+	// the last record for an arc wins
+	std::stable_sort(arcs.begin(), arcs.end(), rel_less);
+	size_t n = 0;
+	for ( size_t a = 0; a < arcs.size(); ++a ) {
+		if ( a + 1 < arcs.size() && same_rel(arcs[a], arcs[a + 1]) )
+			continue;
+		arcs[n++] = arcs[a];
+	}
+	arcs.resize(n);
+	return arcs;
+}
+
+// Replace the contents of the graph with the edges in [first, last),
+// which are Edge records. The result is the same as clearing the graph
+// and calling set(e.i, e.j, e.key, e.undir, e.x) for every record in
+// order, but the records are sorted and the maps are filled in a
+// single pass with hinted insertions.
+template <class Id, class K, class W, class S>
+template <class It>
+void BasicGraph<Id,K,W,S>::assign_edges ( It first, It last )
+{
+	GraphProbe p (tally(), GraphStats::ASSIGN_EDGES, pool.get());
+	if ( !pool ) clear(); // moved-from; needs its keys before interning
+	
+	// each arc also needs a back-link unless the reverse arc is set too
+	std::vector<Entry> A = arcs(first, last);
+	std::vector<Entry> rels;
+	rels.reserve(2 * A.size());
+	for ( size_t a = 0; a < A.size(); ++a ) {
+		if ( !A[a].out ) continue;
+		rels.push_back(A[a]);
+		Entry b = A[a];
+		b.i = A[a].j;
+		b.j = A[a].i;
+		b.out = false;
+		rels.push_back(b);
+	}
+	std::sort(rels.begin(), rels.end());
+	
+	// fill in order; an arc sorts ahead of a back-link it replaces
+	clear();
+	typename VertexMap::iterator it = data.end();
+	typename NbrMap::iterator jt;
+	for ( size_t r = 0; r < rels.size(); ++r ) {
+		const Entry& e = rels[r];
+		if ( r > 0 && same_rel(rels[r - 1], e) ) continue;
+		if ( it == data.end() || it->first != e.i ) {
+			it = data.emplace_hint(data.end(), std::piecewise_construct,
+				std::forward_as_tuple(e.i), std::forward_as_tuple());
+			jt = it->second.end();
+		}
+		if ( jt == it->second.end() || jt->first != e.j ) {
+			jt = it->second.emplace_hint(it->second.end(),
+				std::piecewise_construct, std::forward_as_tuple(e.j),
+				std::forward_as_tuple());
+		}
+		jt->second.emplace_hint(jt->second.end(), e.k, Rel(e.out, e.x));
+	}
+	reindex();
+}
+
+// Make the changes in [a, b), arcs that all run from i toward j, as
+// set_dir and clear_dir would. The maps of the pair, both ways, are
+// found once for all of them, the vertices are numbered and placed
+// once, and maps left empty are dropped once, at the end.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::apply_pair ( const Entry* a, const Entry* b )
+{
+	Id i = a->i, j = a->j;
+	
+	// removals alone change nothing unless the pair is related
+	bool adds = false;
+	for ( const Entry* e = a; e != b; ++e ) adds = adds || e->out;
+	typename VertexMap::iterator it = data.find(i);
+	if ( !adds && (it == data.end()
+			|| it->second.find(j) == it->second.end()) )
+		return;
+	
+	// the rows of i and j, added if new
+	size_t n = data.size();
+	Row* I = &data[i];
+	Row* J = &data[j];
+	if ( data.size() != n ) {
+		I = &data.find(i)->second;   // hashed maps may have moved it
+		if ( dense ) {
+			number(i);
+			number(j);
+		}
+		if ( tracked ) {
+			place(i);
+			place(j);
+		}
+	}
+	RelMap& N = (*I)[j];
+	RelMap& B = (*J)[i];    // N itself if i == j
+	
+	for ( const Entry* e = a; e != b; ++e ) {
+		unsigned int k = e->k;
+		if ( e->out ) {
+			if ( update(N, i, j, k, true, e->x) && tracked ) join(i, j, k);
+			if ( i == j ) continue;
+			typename RelMap::iterator bt = B.find(k);
+			if ( bt != B.end() && bt->second.first ) continue;
+			if ( update(B, j, i, k, false, e->x) && tracked ) join(j, i, k);
+			continue;
+		}
+		
+		// as clear: drop both ways unless j also points toward i, in
+		// which case i's side becomes a back-link
+		typename RelMap::iterator kt = N.find(k);
+		if ( kt == N.end() || !kt->second.first ) continue;
+		typename RelMap::iterator bt = B.find(k);
+		if ( i == j || !bt->second.first ) {
+			erase_rel(N, i, j, k);
+			if ( i != j ) erase_rel(B, j, i, k);
+		}
+		else update(N, i, j, k, false, bt->second.second);
+	}
+	
+	bool out = N.size() == 0, back = B.size() == 0;
+	if ( out ) I->erase(j);
+	if ( back && i != j ) J->erase(i);
+	bool lone_i = I->size() == 0, lone_j = i != j && J->size() == 0;
+	if ( lone_i ) erase_vertex(i);
+	if ( lone_j ) erase_vertex(j);
+}
+
+// Change the graph by the Edge records in [first, last), with the same
+// result as calling set(e.i, e.j, e.key, e.undir, e.x) for every record
+// in order (a no_relationship value clears). The records are reduced
+// to the last change to each arc, and sorted, so that each pair of
+// vertices is visited once: its maps are found once for all of its
+// changes, both ways, and pruned once at the end.
+template <class Id, class K, class W, class S>
+template <class It>
+void BasicGraph<Id,K,W,S>::apply_edges ( It first, It last )
+{
+	GraphProbe p (tally(), GraphStats::APPLY_EDGES, pool.get());
+	if ( !pool ) clear(); // moved-from; needs its keys before interning
+	std::vector<Entry> A = arcs(first, last);
+	size_t b;
+	for ( size_t a = 0; a < A.size(); a = b ) {
+		for ( b = a + 1; b < A.size() && A[b].i == A[a].i
+			&& A[b].j == A[a].j; ++b ) {}
+		apply_pair(&A[0] + a, &A[0] + b);
+	}
+}
+
+// Make a graph from the Edge records in [first, last).
+template <class Id, class K, class W, class S>
+template <class It>
+BasicGraph<Id,K,W,S>
+BasicGraph<Id,K,W,S>::from_edge_list ( It first, It last, bool dir, W x )
+{
+	BasicGraph g (dir, x);
+	g.assign_edges(first, last);
+	return g;
+}
+
+
+// SUBGRAPHS ////////////////////////////////////////////////////////
+
+// Add vertex i to this graph with those of its relationships V in g
+// that p selects: each relationship from i toward j for which
+// p(i, j, key, x) is true, and the back-link of each from j toward i
+// for which p(j, i, key, x) is. Vertex i must not be in this graph.
+template <class Id, class K, class W, class S>
+template <class P>
+void BasicGraph<Id,K,W,S>::take ( const BasicGraph& g, Id i,
+	const NbrMap& V, P& p )
+{
+	typename VertexMap::iterator it = data.end();
+	typename NbrMap::const_iterator jt = V.begin();
+	for ( ; jt != V.end(); ++jt ) {
+		Id j = jt->first;
+		typename NbrMap::iterator nt;
+		bool has_nbr = false;
+		typename RelMap::const_iterator kt = jt->second.begin();
+		for ( ; kt != jt->second.end(); ++kt ) {
+			KeyID k (kt->first);
+			Rel R = kt->second;
+			if ( !R.first ) {
+				if ( !p(j, i, k, R.second) ) continue;
+			}
+			else if ( !p(i, j, k, R.second) ) {
+				// the relationship back from j may still be selected
+				if ( i == j ) continue;
+				const Rel& B =
+					g.data.find(j)->second.find(i)->second.find(k.id)->second;
+				if ( !B.first || !p(j, i, k, B.second) ) continue;
+				R = Rel(false, B.second);
+			}
+			if ( it == data.end() ) {
+				it = data.emplace_hint(data.end(), std::piecewise_construct,
+					std::forward_as_tuple(i), std::forward_as_tuple());
+			}
+			if ( !has_nbr ) {
+				nt = it->second.emplace_hint(it->second.end(),
+					std::piecewise_construct, std::forward_as_tuple(j),
+					std::forward_as_tuple());
+				has_nbr = true;
+			}
+			nt->second.emplace_hint(nt->second.end(), k.id, R);
+		}
+	}
+}
+
+// Get the subgraph induced by the vertices in the set: the
+// relationships with both ends in it, with the same keys, KeyIDs, and
+// settings. Visits only the rows of the vertices in the set.
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S>
+BasicGraph<Id,K,W,S>::subgraph ( const std::set<Id>& vs ) const
+{
+	BasicGraph g (directed, no_relationship);
+	g.key_names = key_names;
+	g.key_ids = key_ids;
+	InSet p;
+	p.in = &vs;
+	typename std::set<Id>::const_iterator vt = vs.begin();
+	for ( ; vt != vs.end(); ++vt ) {
+		typename VertexMap::const_iterator it = data.find(*vt);
+		if ( it != data.end() ) g.take(*this, it->first, it->second, p);
+	}
+	g.reindex();
+	return g;
+}
+
+// Get the relationships with the key, as their own graph with the same
+// keys, KeyIDs, and settings. With the key index, takes time in
+// proportion to the number of relationships with the key.
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S> BasicGraph<Id,K,W,S>::filter_key ( const K& key ) const
+{
+	return filter_key(key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S> BasicGraph<Id,K,W,S>::filter_key ( KeyID key ) const
+{
+	if ( !RelStore<K, W>::INDEXED && key.id == 0 ) return *this;
+	if ( !indexed ) {
+		HasKey p;
+		p.key = key;
+		return filter(p);
+	}
+	BasicGraph g (directed, no_relationship);
+	g.key_names = key_names;
+	g.key_ids = key_ids;
+	if ( key.id >= key_index.size() ) {
+		g.reindex();
+		return g;
+	}
+	
+	// the index lists every pair with the key, back-links included
+	typename VertexMap::iterator it = g.data.end();
+	const KeyIndex& X = key_index[key.id];
+	typename KeyIndex::const_iterator xt = X.begin();
+	for ( ; xt != X.end(); ++xt ) {
+		const NbrMap& V = data.find(xt->first)->second;
+		it = g.data.emplace_hint(g.data.end(), std::piecewise_construct,
+			std::forward_as_tuple(xt->first), std::forward_as_tuple());
+		typename IdSet::const_iterator nt = xt->second.begin();
+		for ( ; nt != xt->second.end(); ++nt ) {
+			const Rel& R = V.find(*nt)->second.find(key.id)->second;
+			typename NbrMap::iterator jt = it->second.emplace_hint(
+				it->second.end(), std::piecewise_construct,
+				std::forward_as_tuple(*nt), std::forward_as_tuple());
+			jt->second.emplace_hint(jt->second.end(), key.id, R);
+		}
+	}
+	g.reindex();
+	return g;
+}
+
+// Get the relationships for which p(i, j, key, x) is true, as their
+// own graph with the same keys, KeyIDs, and settings; p is called with
+// each relationship from i toward j, key (a KeyID), and value x, as
+// for_each_edge and out_edges see them, in one pass over the graph. It
+// may be called more than once for a relationship, so it must give
+// the same answer each time.
+template <class Id, class K, class W, class S>
+template <class P>
+BasicGraph<Id,K,W,S> BasicGraph<Id,K,W,S>::filter ( P p ) const
+{
+	BasicGraph g (directed, no_relationship);
+	g.key_names = key_names;
+	g.key_ids = key_ids;
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) g.take(*this, it->first, it->second, p);
+	g.reindex();
+	return g;
+}
 
-#include <map>
-#include <cmath>
-#include <set>
-#include <string>
 
-namespace bygis { // Brennan Young GIS namespace
+// COMPARISON ///////////////////////////////////////////////////////
 
-class Graph {
-private:
-	static const unsigned char UNDIRECTED;
-	static const unsigned char FROM;
-	static const unsigned char TO;
-	
-	// bool in pair is false if the relationship only exists *to*
-	// vertex i from vertex j
-	std::map<int, std::map<int, std::map<std::string,
-		std::pair<bool, float> > > > data;
-	
-	std::set<int> nbrs (
-		int, unsigned char, bool, const std::string&) const;
-	void update (int, int, const std::string&, bool, float);
-public:
-	bool directed;
-	float no_relationship;
-	
-	// constructors, destructor
-	Graph (bool dir=true, float x=0);
-	Graph (const Graph&);
-	~Graph ();
-	
-	// operators
-	Graph& operator=(const Graph&);
-	bool operator<(const Graph&) const;
-	
-	// operations
-	size_t size () const;
-	std::set<int> nbrs (int, const std::string&) const;
-	std::set<int> nbrs (int) const;
-	std::set<int> nbrs_to (int, const std::string&) const;
-	std::set<int> nbrs_to (int) const;
-	std::set<int> nbrs_from (int, const std::string&) const;
-	std::set<int> nbrs_from (int) const;
-	std::set<int> vertices () const;
-	std::set<std::string> keys () const;
-	std::set<std::string> keys (int) const;
-	std::set<std::string> keys (int, int) const;
-	bool contains (int, int, const std::string&, bool) const;
-	bool contains_dir (int, int, const std::string&) const;
-	bool contains_undir (int, int, const std::string&) const;
-	bool contains (int, int, const std::string&) const;
-	bool contains_dir (int, int) const;
-	bool contains_undir (int, int) const;
-	bool contains (int, int) const;
-	bool contains_dir (int) const;
-	bool contains_undir (int) const;
-	bool contains (int) const;
-	float get (int, int, const std::string&) const;
-	float get (int, int) const;
-	void set (int, int, const std::string&, bool, float);
-	void set (int, int, const std::string&, float);
-	void set_dir (int, int, const std::string&, float);
-	void set_undir (int, int, const std::string&, float);
-	void set (int, int, float);
-	void set_dir (int, int, float);
-	void set_undir (int, int, float);
-	void clear_dir (int, int);
-	void clear_undir (int, int);
-	void clear (int, int);
-	void clear (int, int, const std::string&, bool);
-	void clear_dir (int, int, const std::string&);
-	void clear_undir (int, int, const std::string&);
-	void clear (int, int, const std::string&);
-	void clear_dir (int, const std::string&);
-	void clear_undir (int, const std::string&);
-	void clear (int, const std::string&);
-	void clear (int);
-	void clear (const std::string&);
-	void clear ();
-}; // Graph
+// Scramble the bits of h (the 64-bit finalizer of MurmurHash3).
+template <class Id, class K, class W, class S>
+uint64_t BasicGraph<Id,K,W,S>::mix ( uint64_t h )
+{
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+	return h;
+}
 
-const unsigned char Graph::UNDIRECTED = 0;
-const unsigned char Graph::FROM = 1;
-const unsigned char Graph::TO = 2;
+template <class Id, class K, class W, class S>
+template <class T>
+uint64_t BasicGraph<Id,K,W,S>::hash_of ( const T& x )
+{
+	return mix((uint64_t)std::hash<T>()(x));
+}
 
+template <class Id, class K, class W, class S>
+uint64_t BasicGraph<Id,K,W,S>::hash_of ( const NoKey& )
+{
+	return mix(0);
+}
 
-// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+// Hash of the relationship from i toward j with key ID k and value x.
+// It depends on the key's name rather than its ID, so graphs that
+// interned their keys in different orders hash the same.
+template <class Id, class K, class W, class S>
+uint64_t BasicGraph<Id,K,W,S>::rel_hash ( Id i, Id j, unsigned int k, W x )
+	const
+{
+	uint64_t h = mix(hash_of(i) + 0x9E3779B97F4A7C15ull * hash_of(j));
+	h = mix(h + key_hashes[k]);
+	return mix(h + hash_of(x));
+}
 
-Graph::Graph ( bool dir, float x )
-: directed(dir), no_relationship(x)
-{}
+// Call f(key, a, b) for each key of the maps A and B (either may be
+// null), with a and b pointing to its values in A and B, or null if it
+// is not in that one. Ordered maps are walked in lockstep, in order;
+// hashed maps look up each key of one map in the other.
+template <class Id, class K, class W, class S>
+template <class M, class F>
+void BasicGraph<Id,K,W,S>::merge ( const M* A, const M* B, F f )
+{
+	typedef typename M::mapped_type T;
+	typename M::const_iterator at, bt;
+	if ( S::ORDERED && A && B ) {
+		at = A->begin();
+		bt = B->begin();
+		while ( at != A->end() || bt != B->end() ) {
+			if ( bt == B->end() || (at != A->end() && at->first < bt->first) ) {
+				f(at->first, &at->second, (const T*)0);
+				++at;
+			}
+			else if ( at == A->end() || bt->first < at->first ) {
+				f(bt->first, (const T*)0, &bt->second);
+				++bt;
+			}
+			else {
+				f(at->first, &at->second, &bt->second);
+				++at;
+				++bt;
+			}
+		}
+		return;
+	}
+	if ( A ) for ( at = A->begin(); at != A->end(); ++at ) {
+		const T* b = 0;
+		if ( B && (bt = B->find(at->first)) != B->end() ) b = &bt->second;
+		f(at->first, &at->second, b);
+	}
+	if ( B ) for ( bt = B->begin(); bt != B->end(); ++bt ) {
+		if ( !A || A->find(bt->first) == A->end() )
+			f(bt->first, (const T*)0, &bt->second);
+	}
+}
 
-Graph::Graph ( const Graph& g )
-: directed(g.directed)
+// Hash of the graph's relationships, by key name, and its settings.
+// Kept as the graph changes, so it takes constant time. Equal graphs
+// (operator==) have equal hashes, whatever their storage or the order
+// in which they were built, on any platform with the same std::hash;
+// unequal graphs have equal hashes only by a rare chance.
+template <class Id, class K, class W, class S>
+uint64_t BasicGraph<Id,K,W,S>::hash () const
 {
-	data = g.data;
+	return mix(rel_sum + (directed ? 0x9E3779B97F4A7C15ull : 0)
+		+ hash_of(no_relationship));
 }
 
-Graph::~Graph () {}
+// Get the changes that make this graph's relationships those of g, as
+// Edge records for apply_edges: one from i toward j with g's value for
+// each relationship that g adds or changes, and one with this graph's
+// no_relationship for each that g does not have. Each is undir=false,
+// so a relationship in both directions is two records. Walks the two
+// graphs together, in (i, j, key) order with ordered maps; graphs that
+// are the same give no records and allocate nothing.
+template <class Id, class K, class W, class S>
+std::vector<typename BasicGraph<Id,K,W,S>::Edge>
+BasicGraph<Id,K,W,S>::diff ( const BasicGraph& g ) const
+{
+	std::vector<Edge> out;
+	
+	// each graph's key ID for each of the other's, or NO_KEY
+	std::vector<unsigned int> theirs (key_names.size()),
+		mine (g.key_names.size());
+	for ( size_t k = 0; k < theirs.size(); ++k )
+		theirs[k] = g.key_id(key_names[k]).id;
+	for ( size_t k = 0; k < mine.size(); ++k )
+		mine[k] = key_id(g.key_names[k]).id;
+	
+	// relationships from i toward j, here (a) and in g (b)
+	auto rels = [&] ( Id i, Id j, const RelMap* a, const RelMap* b ) {
+		typename RelMap::const_iterator kt, ht;
+		if ( a ) for ( kt = a->begin(); kt != a->end(); ++kt ) {
+			if ( !kt->second.first ) continue;
+			unsigned int t = theirs[kt->first];
+			if ( b && t != NO_KEY.id && (ht = b->find(t)) != b->end()
+					&& ht->second.first ) {
+				if ( ht->second.second != kt->second.second ) {
+					out.push_back(Edge(i, j, key_names[kt->first], false,
+						ht->second.second));
+				}
+			}
+			else {
+				out.push_back(Edge(i, j, key_names[kt->first], false,
+					no_relationship));
+			}
+		}
+		if ( b ) for ( ht = b->begin(); ht != b->end(); ++ht ) {
+			if ( !ht->second.first ) continue;
+			unsigned int k = mine[ht->first];
+			if ( a && k != NO_KEY.id && (kt = a->find(k)) != a->end()
+					&& kt->second.first ) continue;
+			out.push_back(Edge(i, j, g.key_names[ht->first], false,
+				ht->second.second));
+		}
+	};
+	auto nbrs = [&] ( Id i, const Row* A, const Row* B ) {
+		merge<NbrMap>(A, B, [&] ( Id j, const RelMap* a, const RelMap* b ) {
+			rels(i, j, a, b);
+		});
+	};
+	merge<VertexMap>(&data, &g.data, nbrs);
+	return out;
+}
 
 
-// OPERATORS ////////////////////////////////////////////////////////
+// STATISTICS ///////////////////////////////////////////////////////
 
-Graph& Graph::operator= ( const Graph& g )
+// Get the counts of the graph's operations since it was made or they
+// were reset, and set the hook they call. Without YOUNG_GIS_GRAPH_STATS
+// nothing is counted, and every count reads 0.
+template <class Id, class K, class W, class S>
+GraphStats& BasicGraph<Id,K,W,S>::stats () const
 {
-	if ( this == &g ) return *this;
-	directed = g.directed;
-	data = g.data;
-	return *this;
+#ifdef YOUNG_GIS_GRAPH_STATS
+	return counters;
+#else
+	static GraphStats none;
+	return none;
+#endif
 }
 
-bool Graph::operator< ( const Graph& g ) const
+// Get the counts to record operations in, or null if there are none.
+template <class Id, class K, class W, class S>
+GraphStats* BasicGraph<Id,K,W,S>::tally () const
 {
-	return data < g.data;
+#ifdef YOUNG_GIS_GRAPH_STATS
+	return &counters;
+#else
+	return 0;
+#endif
 }
 
 
 // OPERATIONS ///////////////////////////////////////////////////////
 
 // Get the number of vertices represented in the graph.
-size_t Graph::size () const
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::size () const
 {
 	return data.size();
 }
 
-// Get a set of neighbor IDs.
-std::set<int> Graph::nbrs ( int i, unsigned char dir,
-	bool limit_key, const std::string& key ) const
+// Get the number of relationships, in constant time. A relationship
+// set in both directions (as an undirected one) counts once for each.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::num_edges () const
 {
-	std::set<int> out;
-	
-	std::map<int, std::map<int, std::map<std::string,
-		std::pair<bool, float> > > >::const_iterator it = data.find(i);
-	if ( it == data.end() ) return out;
+	return edge_count;
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::num_edges ( const K& key ) const
+{
+	return num_edges(key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::num_edges ( KeyID key ) const
+{
+	if ( key.id >= key_edges.size() ) return 0;
+	return key_edges[key.id];
+}
+
+// Get the number of neighbors, as nbrs(i).size() without the copy;
+// with a key, and without the key index, this looks at each of them.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::degree ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	return it == data.end() ? 0 : it->second.size();
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::degree ( Id i, const K& key ) const
+{
+	return degree(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::degree ( Id i, KeyID key ) const
+{
+	if ( !RelStore<K, W>::INDEXED ) return key.id == 0 ? degree(i) : 0;
+	if ( indexed ) {
+		if ( key.id >= key_index.size() ) return 0;
+		typename KeyIndex::const_iterator xt = key_index[key.id].find(i);
+		return xt == key_index[key.id].end() ? 0 : xt->second.size();
+	}
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return 0;
+	size_t d = 0;
+	typename NbrMap::const_iterator jt = it->second.begin();
+	for ( ; jt != it->second.end(); ++jt )
+		if ( jt->second.find(key.id) != jt->second.end() ) ++d;
+	return d;
+}
+
+// Get the number of neighbors that i has relationships toward, as
+// nbrs_from(i).size(), in logarithmic time.
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::out_degree ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	return it == data.end() ? 0 : it->second.out;
+}
+
+// Get the number of neighbors that have relationships toward i, as
+// nbrs_to(i).size().
+template <class Id, class K, class W, class S>
+size_t BasicGraph<Id,K,W,S>::in_degree ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	return it == data.end() ? 0 : it->second.in;
+}
+
+// Call f(j) once for each neighbor j of i.
+template <class Id, class K, class W, class S>
+template <class F>
+void BasicGraph<Id,K,W,S>::visit ( Id i, unsigned char dir,
+	bool limit_key, unsigned int key, F& f ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return;
 	
 	// vertex
-	const std::map<int, std::map<
-			std::string, std::pair<bool, float> > >& V =
-		it->second;
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator jt = V.begin();
-	for ( ; jt != it->second.end(); ++jt ) {
+	const NbrMap& V = it->second;
+	
+	// the neighbors with relationships toward i are listed by its row;
+	// with a key, those whose relationships toward i include it. If
+	// i's own relationship with the key does not point toward j, it is
+	// a back-link, so only pairs that point both ways look up j's.
+	if ( dir == TO ) {
+		const IdSet& T = it->second.from;
+		typename IdSet::const_iterator nt = T.begin();
+		for ( ; nt != T.end(); ++nt ) {
+			if ( !limit_key ) {
+				f(*nt);
+				continue;
+			}
+			const RelMap& N = V.find(*nt)->second;
+			typename RelMap::const_iterator kt = N.find(key);
+			if ( kt == N.end() ) continue;
+			if ( !kt->second.first || data.find(*nt)->second.find(
+					i)->second.find(key)->second.first )
+				f(*nt);
+		}
+		return;
+	}
+	
+	// with a key, only the neighbors the index lists for it, if it is
+	// kept
+	if ( limit_key && indexed ) {
+		if ( key >= key_index.size() ) return;
+		typename KeyIndex::const_iterator xt = key_index[key].find(i);
+		if ( xt == key_index[key].end() ) return;
+		typename IdSet::const_iterator nt = xt->second.begin();
+		for ( ; nt != xt->second.end(); ++nt ) {
+			const Rel& R = V.find(*nt)->second.find(key)->second;
+			if ( visits(dir, R) ) f(*nt);
+		}
+		return;
+	}
+	
+	typename NbrMap::const_iterator jt = V.begin();
+	for ( ; jt != V.end(); ++jt ) {
 		// neighbor
-		int j = jt->first;
-		const std::map<std::string, std::pair<bool, float> >& N =
-			jt->second;
-		
-		if ( limit_key && N.find(key) == N.end() ) continue;
+		Id j = jt->first;
+		const RelMap& N = jt->second;
 		
 		// relationships
-		std::map<std::string,
-				std::pair<bool, float> >::const_iterator kt = N.begin();
-		for ( ; kt != N.end(); ++kt ) {
-			const std::string& k = kt->first;
-			const std::pair<bool, float>& R = kt->second;
-			if ( (!limit_key || k == key)
-					&& (dir == UNDIRECTED
-					|| (dir == FROM && R.first)
-					|| (dir == TO && (!R.first
-					|| data.find(j)->second.find(i)->second.find(k)->second.first))) )
-				out.insert(jt->first);
+		typename RelMap::const_iterator kt = N.begin();
+		typename RelMap::const_iterator kend = N.end();
+		if ( limit_key ) {
+			kt = N.find(key);
+			if ( kt == kend ) continue;
+			kend = kt;
+			++kend;
+		}
+		for ( ; kt != kend; ++kt ) {
+			if ( visits(dir, kt->second) ) {
+				f(j);
+				break;
+			}
 		}
 	}
+}
+
+// True if relationship R from i to j makes j a neighbor in the given
+// direction, UNDIRECTED or FROM.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::visits ( unsigned char dir, const Rel& R )
+{
+	return dir == UNDIRECTED || R.first;
+}
+
+// Get a set of neighbor IDs.
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs ( Id i, unsigned char dir,
+	bool limit_key, unsigned int key ) const
+{
+	std::set<Id> out;
+	Collect f (out);
+	visit(i, dir, limit_key, key, f);
 	return out;
 }
 
-std::set<int> Graph::nbrs ( int i, const std::string& key ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs ( Id i, const K& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs ( Id i, KeyID key ) const
+{
+	GraphProbe p (tally(), GraphStats::NBRS, pool.get());
+	return nbrs(i, UNDIRECTED, true, key.id);
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs ( Id i ) const
+{
+	GraphProbe p (tally(), GraphStats::NBRS, pool.get());
+	return nbrs(i, UNDIRECTED, false, 0);
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_to ( Id i, const K& key ) const
 {
-	return nbrs(i, UNDIRECTED, true, key);
+	return nbrs_to(i, key_id(key));
 }
 
-std::set<int> Graph::nbrs ( int i ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_to ( Id i, KeyID key ) const
 {
-	return nbrs(i, UNDIRECTED, false, "");
+	GraphProbe p (tally(), GraphStats::NBRS_TO, pool.get());
+	return nbrs(i, TO, true, key.id);
 }
 
-std::set<int> Graph::nbrs_to ( int i, const std::string& key ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_to ( Id i ) const
 {
-	return nbrs(i, TO, true, key);
+	GraphProbe p (tally(), GraphStats::NBRS_TO, pool.get());
+	return nbrs(i, TO, false, 0);
 }
 
-std::set<int> Graph::nbrs_to ( int i ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_from ( Id i , const K& key ) const
 {
-	return nbrs(i, TO, false, "");
+	return nbrs_from(i, key_id(key));
 }
 
-std::set<int> Graph::nbrs_from ( int i , const std::string& key ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_from ( Id i , KeyID key ) const
 {
-	return nbrs(i, FROM, true, key);
+	GraphProbe p (tally(), GraphStats::NBRS_FROM, pool.get());
+	return nbrs(i, FROM, true, key.id);
 }
 
-std::set<int> Graph::nbrs_from ( int i ) const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::nbrs_from ( Id i ) const
 {
-	return nbrs(i, FROM, false, "");
+	GraphProbe p (tally(), GraphStats::NBRS_FROM, pool.get());
+	return nbrs(i, FROM, false, 0);
 }
 
 // Returns a set of object IDs.
-std::set<int> Graph::vertices () const
+template <class Id, class K, class W, class S>
+std::set<Id> BasicGraph<Id,K,W,S>::vertices () const
 {
-	std::set<int> out;
-	std::map<int, std::map<int, std::map<std::string,
-		std::pair<bool, float> > > >::const_iterator it =
-		data.begin();
-	for ( ; it != data.end(); ++it ) out.insert(it->first);
+	std::set<Id> out;
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) out.insert(out.end(), it->first);
 	return out;
 }
 
-// Returns all of the keys in the graph.
-std::set<std::string> Graph::keys () const
+// Returns all of the keys in the graph, from the counts of
+// relationships by key, in time in the number of keys.
+template <class Id, class K, class W, class S>
+std::set<K> BasicGraph<Id,K,W,S>::keys () const
 {
-	std::set<std::string> out;
-	
-	// vertices
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.begin();
-	for ( ; it != data.end(); ++it ) {
-		const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = it->second;
-		
-		// neighbors
-		std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator jt = V.begin();
-		for ( ; jt != V.end(); ++jt ) {
-			const std::map<std::string, std::pair<bool, float> >& N =
-				jt->second;
-			
-			// relationships
-			std::map<std::string,
-				std::pair<bool, float> >::const_iterator kt = N.begin();
-			for ( ; kt != N.end(); ++kt ) out.insert(kt->first);
-		}
-	}
-	
+	std::set<K> out;
+	for ( size_t k = 0; k < key_edges.size(); ++k )
+		if ( key_edges[k] > 0 ) out.insert(key_names[k]);
 	return out;
 }
 
 // Returns all of the keys associated with the vertex.
-std::set<std::string> Graph::keys ( int i ) const
+template <class Id, class K, class W, class S>
+std::set<K> BasicGraph<Id,K,W,S>::keys ( Id i ) const
 {
-	std::set<std::string> out;
+	std::set<K> out;
 	
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.find(i);
-	const std::map<int, std::map<std::string,
-		std::pair<bool, float> > >& V = it->second;
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return out;
+	const NbrMap& V = it->second;
 	
 	// neighbors
-	std::map<int, std::map<std::string,
-		std::pair<bool, float> > >::const_iterator jt = V.begin();
+	typename NbrMap::const_iterator jt = V.begin();
 	for ( ; jt != V.end(); ++jt ) {
-		const std::map<std::string, std::pair<bool, float> >& N =
-			jt->second;
+		const RelMap& N = jt->second;
 		
 		// relationships
-		std::map<std::string,
-			std::pair<bool, float> >::const_iterator kt = N.begin();
-		for ( ; kt != N.end(); ++kt ) out.insert(kt->first);
+		typename RelMap::const_iterator kt = N.begin();
+		for ( ; kt != N.end(); ++kt ) out.insert(key_names[kt->first]);
 	}
 	
 	return out;
 }
 
 // Returns a set of the relationship's keys or properties.
-std::set<std::string> Graph::keys ( int i, int j ) const
+template <class Id, class K, class W, class S>
+std::set<K> BasicGraph<Id,K,W,S>::keys ( Id i, Id j ) const
 {
-	std::set<std::string> out;
+	std::set<K> out;
 	
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator t_i =
-		data.find(i);
+	typename VertexMap::const_iterator t_i = data.find(i);
 	if ( t_i == data.end() ) return out;
-	const std::map<int, std::map<std::string,
-		std::pair<bool, float> > >& V = t_i->second;
+	const NbrMap& V = t_i->second;
 	
 	// neighbor
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator t_j =
-		V.find(j);
+	typename NbrMap::const_iterator t_j = V.find(j);
 	if ( t_j == V.end() ) return out;
-	const std::map<std::string, std::pair<bool, float> >& N =
-		t_j->second;
+	const RelMap& N = t_j->second;
 	
 	// relationships
-	std::map<std::string, std::pair<bool, float> >::const_iterator
-		t_k = N.begin();
-	for ( ; t_k != N.end(); ++t_k ) out.insert(t_k->first);
+	typename RelMap::const_iterator t_k = N.begin();
+	for ( ; t_k != N.end(); ++t_k ) out.insert(key_names[t_k->first]);
 	
 	return out;
 }
 
 // Returns true if the relationship exists for the given key.
-bool Graph::contains (
-	int i, int j, const std::string& key, bool undir ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains (
+	Id i, Id j, const K& key, bool undir ) const
+{
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
+	return p.result(contains(i, j, key_id(key), undir));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains ( Id i, Id j, KeyID key, bool undir ) const
 {
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator t_i =
-		data.find(i);
-	if ( t_i == data.end() ) return false;
-	const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = t_i->second;
+	typename VertexMap::const_iterator t_i = data.find(i);
+	if ( t_i == data.end() ) return p.miss(false);
+	const NbrMap& V = t_i->second;
 	
 	// neighbor
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator t_j =
-		V.find(j);
-	if ( t_j == V.end() ) return false;
-	const std::map<std::string, std::pair<bool, float> >& N =
-		t_j->second;
+	typename NbrMap::const_iterator t_j = V.find(j);
+	if ( t_j == V.end() ) return p.miss(false);
+	const RelMap& N = t_j->second;
 	
 	// relationship
-	std::map<std::string,
-			std::pair<bool, float> >::const_iterator t_k =
-		N.find(key);
-	if ( t_k == N.end() ) return false;
-	const std::pair<bool, float>& R = t_k->second;
+	typename RelMap::const_iterator t_k = N.find(key.id);
+	if ( t_k == N.end() ) return p.miss(false);
+	const Rel& R = t_k->second;
 	
-	return undir || R.first;
+	return p.result(undir || R.first);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_dir (
+	Id i, Id j, const K& key ) const
+{
+	GraphProbe p (tally(), GraphStats::CONTAINS_DIR, pool.get());
+	return p.result(contains(i, j, key, false));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_dir ( Id i, Id j, KeyID key ) const
+{
+	GraphProbe p (tally(), GraphStats::CONTAINS_DIR, pool.get());
+	return p.result(contains(i, j, key, false));
 }
 
-bool Graph::contains_dir (
-	int i, int j, const std::string& key ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_undir (
+	Id i, Id j, const K& key ) const
 {
-	return contains(i, j, key, false);
+	GraphProbe p (tally(), GraphStats::CONTAINS_UNDIR, pool.get());
+	return p.result(contains(i, j, key, true));
 }
 
-bool Graph::contains_undir (
-	int i, int j, const std::string& key ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_undir ( Id i, Id j, KeyID key ) const
 {
-	return contains(i, j, key, true);
+	GraphProbe p (tally(), GraphStats::CONTAINS_UNDIR, pool.get());
+	return p.result(contains(i, j, key, true));
 }
 
-bool Graph::contains ( int i, int j, const std::string& key ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains ( Id i, Id j, const K& key ) const
 {
-	return contains(i, j, key, !directed);
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
+	return p.result(contains(i, j, key, !directed));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains ( Id i, Id j, KeyID key ) const
+{
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
+	return p.result(contains(i, j, key, !directed));
 }
 
 // Returns true if a relationship exists between the given vertices.
-bool Graph::contains_dir ( int i, int j ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_dir ( Id i, Id j ) const
 {
+	GraphProbe p (tally(), GraphStats::CONTAINS_DIR, pool.get());
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.find(i);
-	if ( it == data.end() ) return false;
-	const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = it->second;
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return p.miss(false);
+	const NbrMap& V = it->second;
 	
 	// neighbor
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator jt = V.find(j);
-	if ( jt == V.end() ) return false;
-	const std::map<std::string, std::pair<bool, float> >& N =
-		jt->second;
+	typename NbrMap::const_iterator jt = V.find(j);
+	if ( jt == V.end() ) return p.miss(false);
+	const RelMap& N = jt->second;
 	
 	// relationships
 	bool flag = false;
-	std::map<std::string,
-		std::pair<bool, float> >::const_iterator kt = N.begin();
+	typename RelMap::const_iterator kt = N.begin();
 	for ( ; !flag && kt != N.end(); ++kt ) flag = kt->second.first;
 	
-	return flag;
+	return p.result(flag);
 }
 
-bool Graph::contains_undir ( int i, int j ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_undir ( Id i, Id j ) const
 {
+	GraphProbe p (tally(), GraphStats::CONTAINS_UNDIR, pool.get());
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.find(i);
-	if ( it == data.end() ) return false;
-	const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = it->second;
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return p.miss(false);
+	const NbrMap& V = it->second;
 	
 	// neighbor
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator jt = V.find(j);
-	return jt != V.end() && jt->second.size() > 0;
+	typename NbrMap::const_iterator jt = V.find(j);
+	return p.result(jt != V.end() && jt->second.size() > 0);
 }
 
-bool Graph::contains ( int i, int j ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains ( Id i, Id j ) const
 {
-	if ( directed ) return contains_dir(i, j);
-	return contains_undir(i, j);
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
+	if ( directed ) return p.result(contains_dir(i, j));
+	return p.result(contains_undir(i, j));
 }
 
 // Returns true if the given vertex exists. If specifying directed
 // (undir=false), only returns true if the vertex has an outgoing
 // 'from' relationship.
-bool Graph::contains_dir ( int i ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_dir ( Id i ) const
 {
-	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.find(i);
-	if ( it == data.end() ) return false;
-	const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = it->second;
-	
-	// neighbors
-	bool flag = false;
-	std::map<int, std::map<std::string,
-		std::pair<bool, float> > >::const_iterator jt = V.begin();
-	for ( ; !flag && jt != V.end(); ++jt ) {
-		const std::map<std::string, std::pair<bool, float> >& N =
-			jt->second;
-		
-		// relationships
-		std::map<std::string,
-			std::pair<bool, float> >::const_iterator kt = N.begin();
-		for ( ; !flag && kt != N.end(); ++kt ) flag = kt->second.first;
-	}
-	
-	return flag;
+	GraphProbe p (tally(), GraphStats::CONTAINS_DIR, pool.get());
+	return p.result(out_degree(i) > 0);
 }
 
-bool Graph::contains_undir ( int i ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains_undir ( Id i ) const
 {
+	GraphProbe p (tally(), GraphStats::CONTAINS_UNDIR, pool.get());
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator it =
-		data.find(i);
-	return it != data.end() && it->second.size() > 0;
+	typename VertexMap::const_iterator it = data.find(i);
+	return p.result(it != data.end() && it->second.size() > 0);
 }
 
-bool Graph::contains ( int i ) const
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::contains ( Id i ) const
 {
-	if ( directed ) return contains_dir(i);
-	return contains_undir(i);
+	GraphProbe p (tally(), GraphStats::CONTAINS, pool.get());
+	if ( directed ) return p.result(contains_dir(i));
+	return p.result(contains_undir(i));
 }
 
 // Returns the value of the relationship. If the relationship does
 // not exist, returns the no_relationship value.
-float Graph::get ( int i, int j, const std::string& key ) const
+template <class Id, class K, class W, class S>
+W BasicGraph<Id,K,W,S>::get ( Id i, Id j, const K& key ) const
+{
+	GraphProbe p (tally(), GraphStats::GET, pool.get());
+	W x = get(i, j, key_id(key));
+	return x == no_relationship ? p.miss(x) : x;
+}
+
+template <class Id, class K, class W, class S>
+W BasicGraph<Id,K,W,S>::get ( Id i, Id j, KeyID key ) const
 {
+	GraphProbe p (tally(), GraphStats::GET, pool.get());
 	// vertex
-	std::map<int, std::map<int, std::map<std::string,
-			std::pair<bool, float> > > >::const_iterator t_i =
-		data.find(i);
-	if ( t_i == data.end() ) return no_relationship;
-	const std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = t_i->second;
+	typename VertexMap::const_iterator t_i = data.find(i);
+	if ( t_i == data.end() ) return p.miss(no_relationship);
+	const NbrMap& V = t_i->second;
 	
 	// neighbor
-	std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::const_iterator t_j =
-		V.find(j);
-	if ( t_j == V.end() ) return no_relationship;
-	const std::map<std::string, std::pair<bool, float> >& N =
-		t_j->second;
+	typename NbrMap::const_iterator t_j = V.find(j);
+	if ( t_j == V.end() ) return p.miss(no_relationship);
+	const RelMap& N = t_j->second;
 	
 	// relationship
-	std::map<std::string,
-			std::pair<bool, float> >::const_iterator t_k =
-		N.find(key);
-	if ( t_k == N.end() ) return no_relationship;
-	const std::pair<bool, float>& R = t_k->second;
+	typename RelMap::const_iterator t_k = N.find(key.id);
+	if ( t_k == N.end() ) return p.miss(no_relationship);
+	const Rel& R = t_k->second;
 	
 	if ( R.first == false ) return -1 * R.second;
 	return R.second;
 }
 
-float Graph::get ( int i, int j ) const
+template <class Id, class K, class W, class S>
+W BasicGraph<Id,K,W,S>::get ( Id i, Id j ) const
+{
+	GraphProbe p (tally(), GraphStats::GET, pool.get());
+	W x = get(i, j, KeyID());
+	return x == no_relationship ? p.miss(x) : x;
+}
+
+
+// BATCH QUERIES ////////////////////////////////////////////////////
+
+// Look up the relationship of each Edge record in [first, last), and
+// call f(q, R) for each with its Probe q and the relationship R (null
+// if there is none). Runs of records with the same i, or i and j, look
+// those up once. With ordered maps the records are taken in order of
+// (i, j, key), sorting them if they are not already, so each lookup
+// starts near the last. With hashed maps, whose order says nothing of
+// where a vertex lives, they are taken as given: each record's vertex
+// is found LAG records ahead of it, after its slot was prefetched LAG
+// records before that, and its neighbor's slot is prefetched then.
+template <class Id, class K, class W, class S>
+template <class It, class F>
+void BasicGraph<Id,K,W,S>::probe ( It first, It last, F& f ) const
+{
+	// the probes, looking up the key of each run of records with one key
+	std::vector<Probe> P;
+	KeyID k = key_id(K());
+	K key = K();
+	for ( It it = first; it != last; ++it ) {
+		if ( !(it->key == key) ) {
+			key = it->key;
+			k = key_id(key);
+		}
+		Probe q = { it->i, it->j, k.id, it->undir, P.size() };
+		P.push_back(q);
+	}
+	if ( S::ORDERED && !std::is_sorted(P.begin(), P.end()) )
+		std::sort(P.begin(), P.end());
+	
+	// the vertex of probe p, found LAG probes ahead, is in V[p % LAG]
+	const size_t LAG = 8;
+	typename VertexMap::const_iterator V[LAG];
+	auto look = [&] ( size_t p ) {
+		if ( p >= P.size() ) return;
+		typename VertexMap::const_iterator& vt = V[p % LAG];
+		if ( p > 0 && P[p].i == P[p - 1].i ) vt = V[(p - 1) % LAG];
+		else vt = data.find(P[p].i);
+		if ( vt != data.end() ) S::prefetch(vt->second, P[p].j);
+	};
+	for ( size_t p = LAG; p < 2 * LAG && p < P.size(); ++p )
+		S::prefetch(data, P[p].i);
+	for ( size_t p = 0; p < LAG; ++p ) look(p);
+	
+	typename NbrMap::const_iterator jt;
+	for ( size_t p = 0; p < P.size(); ++p ) {
+		const Probe& q = P[p];
+		if ( p + 2 * LAG < P.size() ) S::prefetch(data, P[p + 2 * LAG].i);
+		typename VertexMap::const_iterator vt = V[p % LAG];
+		look(p + LAG);
+		
+		const Rel* R = 0;
+		if ( vt != data.end() ) {
+			if ( p == 0 || q.i != P[p - 1].i || q.j != P[p - 1].j )
+				jt = vt->second.find(q.j);
+			if ( jt != vt->second.end() ) {
+				typename RelMap::const_iterator kt = jt->second.find(q.k);
+				if ( kt != jt->second.end() ) R = &kt->second;
+			}
+		}
+		f(q, R);
+	}
+}
+
+// Set out[n] to get(e.i, e.j, e.key) for the n-th Edge record e of
+// [first, last), as one pass that groups the records by vertex (see
+// probe). out is a random-access iterator, such as a W* or a
+// std::vector<W>::iterator, to room for every answer; each key is
+// looked up once for each run of records that have it.
+template <class Id, class K, class W, class S>
+template <class It, class Out>
+void BasicGraph<Id,K,W,S>::get_batch ( It first, It last, Out out ) const
+{
+	GraphProbe p (tally(), GraphStats::GET_BATCH, pool.get());
+	W none = no_relationship;
+	auto f = [&] ( const Probe& q, const Rel* R ) {
+		out[q.n] = R == 0 ? none : R->first ? R->second : -1 * R->second;
+	};
+	probe(first, last, f);
+}
+
+// Set out[n] to contains(e.i, e.j, e.key, e.undir) for the n-th Edge
+// record e of [first, last), as get_batch does; out holds bools.
+template <class Id, class K, class W, class S>
+template <class It, class Out>
+void BasicGraph<Id,K,W,S>::contains_batch ( It first, It last, Out out ) const
+{
+	GraphProbe p (tally(), GraphStats::CONTAINS_BATCH, pool.get());
+	auto f = [&] ( const Probe& q, const Rel* R ) {
+		out[q.n] = R != 0 && (q.undir || R->first);
+	};
+	probe(first, last, f);
+}
+
+// True if any of the relationships points toward the neighbor.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::flags ( const RelMap& N )
 {
-	return get(i, j, "");
+	typename RelMap::const_iterator kt = N.begin();
+	for ( ; kt != N.end(); ++kt ) if ( kt->second.first ) return true;
+	return false;
+}
+
+// Add d (1 or -1) to the counts of relationships from i toward j with
+// key k; if nbr, also to i's count of neighbors it points toward and
+// j's of neighbors pointing toward it, adding or removing i from j's
+// neighbors it has relationships from.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::count (
+	Id i, Id j, unsigned int k, int d, bool nbr )
+{
+	edge_count += d;
+	key_edges[k] += d;
+	if ( !nbr ) return;
+	data[i].out += d;
+	Row& J = data[j];
+	J.in += d;
+	if ( d > 0 ) J.from.insert(i);
+	else J.from.erase(i);
 }
 
 // Set the value of the given relationship. If it does not exist,
 // creates it. If it already exists, overwrites it.
-void Graph::update (
-	int i, int j, const std::string& key, bool outward, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::update (
+	Id i, Id j, unsigned int key, bool outward, W x )
 {
-	if ( data.find(i) == data.end() ) {
-		data[i] = std::map<int, std::map<std::string,
-			std::pair<bool, float> > > ();
+	size_t n = data.size();
+	bool added = update(data[i][j], i, j, key, outward, x);
+	if ( dense && data.size() != n ) {
+		number(i);
+		number(j);
+	}
+	if ( !tracked ) return;
+	if ( data.size() != n ) {
+		place(i);
+		place(j);
 	}
-	if ( data[i].find(j) == data[i].end() ) {
-		data[i][j] = std::map<std::string,
-			std::pair<bool, float> > ();
+	if ( added ) join(i, j, key);
+}
+
+// Set the relationship in N, the map of those from i toward j, and
+// keep the index, the counters, and the hash; vertices i and j must
+// be in the graph. Returns true if the key was new to N, for join.
+template <class Id, class K, class W, class S>
+bool BasicGraph<Id,K,W,S>::update (
+	RelMap& N, Id i, Id j, unsigned int key, bool outward, W x )
+{
+	typename RelMap::iterator kt = N.find(key);
+	bool was = kt != N.end() && kt->second.first;
+	bool added = kt == N.end();
+	if ( was ) rel_sum -= rel_hash(i, j, key, kt->second.second);
+	if ( outward ) rel_sum += rel_hash(i, j, key, x);
+	if ( outward && !was ) count(i, j, key, 1, !flags(N));
+	if ( !added ) kt->second = Rel(outward, x);
+	else {
+		N[key] = Rel(outward, x);
+		index_add(key, i, j);
 	}
-	data[i][j][key] = std::pair<bool, float> (outward, x);
+	if ( was && !outward ) count(i, j, key, -1, !flags(N));
+	return added;
+}
+
+// Remove the relationship from i to j with the given key, if there is
+// one, leaving any empty maps for prune.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::erase_rel ( Id i, Id j, unsigned int key )
+{
+	erase_rel(data[i][j], i, j, key);
+}
+
+// Remove the relationship with the given key from N, the map of those
+// from i toward j.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::erase_rel (
+	RelMap& N, Id i, Id j, unsigned int key )
+{
+	typename RelMap::iterator kt = N.find(key);
+	if ( kt == N.end() ) return;
+	bool was = kt->second.first;
+	if ( was ) rel_sum -= rel_hash(i, j, key, kt->second.second);
+	N.erase(kt);
+	index_remove(key, i, j);
+	if ( tracked ) cut(i, j, key, N.size() == 0);
+	if ( was ) count(i, j, key, -1, !flags(N));
+}
+
+// Remove all of the relationships from i to j, and j from i's
+// neighbors.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::erase_nbr ( Id i, Id j )
+{
+	typename VertexMap::iterator it = data.find(i);
+	if ( it == data.end() ) return;
+	typename NbrMap::iterator jt = it->second.find(j);
+	if ( jt == it->second.end() ) return;
+	while ( jt->second.size() > 0 ) erase_rel(i, j, jt->second.begin()->first);
+	it->second.erase(jt);
+}
+
+// Drop the relationships from i to j if there are none left, and
+// vertex i if it has no neighbors left.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::prune ( Id i, Id j )
+{
+	typename VertexMap::iterator it = data.find(i);
+	if ( it == data.end() ) return;
+	typename NbrMap::iterator jt = it->second.find(j);
+	if ( jt != it->second.end() && jt->second.size() == 0 )
+		it->second.erase(jt);
+	if ( it->second.size() == 0 ) erase_vertex(it);
 }
 
-// Undirected if undir == true
-void Graph::set (
-	int i, int j, const std::string& key, bool undir, float x )
+// Undirected if undir == true. A KeyID the graph did not issue, such
+// as NO_KEY, sets nothing, as clear ignores it.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set (
+	Id i, Id j, const K& key, bool undir, W x )
 {
+	GraphProbe p (tally(), GraphStats::SET, pool.get());
+	set(i, j, intern(key), undir, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set ( Id i, Id j, KeyID key, bool undir, W x )
+{
+	GraphProbe p (tally(), GraphStats::SET, pool.get());
+	if ( key.id >= key_names.size() ) return;
+	
 	// check for no-relationship value
 	if ( fabs(x - no_relationship) < 0.0000001 ) {
+		p.epsilon_clear();
 		if ( undir ) clear_undir(i, j, key);
 		else clear_dir(i, j, key);
 		return;
 	}
 	
 	// create or update relationships
-	update(i, j, key, true, x);
-	if ( undir ) update(j, i, key, true, x);
-	else if ( !contains(j, i, key) || !data[j][i][key].first )
-		update(j, i, key, false, x);
+	update(i, j, key.id, true, x);
+	if ( undir ) update(j, i, key.id, true, x);
+	else if ( !contains(j, i, key) || !data[j][i][key.id].first )
+	{
+		update(j, i, key.id, false, x);
+		p.back_link();
+	}
 }
 
-void Graph::set (
-	int i, int j, const std::string& key, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set (
+	Id i, Id j, const K& key, W x )
+{
+	set(i, j, key, !directed, x);
+}
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set ( Id i, Id j, KeyID key, W x )
 {
 	set(i, j, key, !directed, x);
 }
-void Graph::set_dir (
-	int i, int j, const std::string& key, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_dir (
+	Id i, Id j, const K& key, W x )
 {
+	GraphProbe p (tally(), GraphStats::SET_DIR, pool.get());
 	set(i, j, key, false, x);
 }
-void Graph::set_undir (
-	int i, int j, const std::string& key, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_dir ( Id i, Id j, KeyID key, W x )
+{
+	GraphProbe p (tally(), GraphStats::SET_DIR, pool.get());
+	set(i, j, key, false, x);
+}
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_undir (
+	Id i, Id j, const K& key, W x )
+{
+	GraphProbe p (tally(), GraphStats::SET_UNDIR, pool.get());
+	set(i, j, key, true, x);
+}
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_undir ( Id i, Id j, KeyID key, W x )
 {
+	GraphProbe p (tally(), GraphStats::SET_UNDIR, pool.get());
 	set(i, j, key, true, x);
 }
 
-void Graph::set ( int i, int j, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set ( Id i, Id j, W x )
 {
-	set(i, j, "", !directed, x);
+	set(i, j, KeyID(), !directed, x);
 }
-void Graph::set_dir ( int i, int j, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_dir ( Id i, Id j, W x )
 {
-	set(i, j, "", false, x);
+	GraphProbe p (tally(), GraphStats::SET_DIR, pool.get());
+	set(i, j, KeyID(), false, x);
 }
-void Graph::set_undir ( int i, int j, float x )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::set_undir ( Id i, Id j, W x )
 {
-	set(i, j, "", true, x);
+	GraphProbe p (tally(), GraphStats::SET_UNDIR, pool.get());
+	set(i, j, KeyID(), true, x);
 }
 
 // Remove the relationship(s) between the given vertices.
-void Graph::clear_dir ( int i, int j )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_dir ( Id i, Id j )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR_DIR, pool.get());
 	if ( !contains(i,j) ) return;
 	
-	std::map<std::string, std::pair<bool, float> >::iterator it;
-	for ( it = data[i][j].begin(); it != data[i][j].end(); ) {
-		if ( !it->second.first )
-			++it;
-		else if ( !data[j][i][it->first].first ) {
-			data[j][i].erase(it->first);
-			data[i][j].erase(it++);
-		}
-		else {
-			it->second.first = false;
-			it->second.second = data[j][i][it->first].second;
-			++it;
+	// the map changes as it is walked, so each step finds the next key
+	typename RelMap::iterator it = data[i][j].begin();
+	while ( it != data[i][j].end() ) {
+		unsigned int k = it->first;
+		bool out = it->second.first;
+		if ( !out ) {}
+		else if ( i == j ) erase_rel(i, j, k); // self-loop has no back-link
+		else if ( !data[j][i][k].first ) {
+			erase_rel(j, i, k);
+			erase_rel(i, j, k);
 		}
+		else update(i, j, k, false, data[j][i][k].second);
+		it = data[i][j].upper_bound(k);
 	}
 	
 	if ( data[i][j].size() == 0 ) data[i].erase(j);
 	if ( data[j][i].size() == 0 ) data[j].erase(i);
-	if ( data[i].size() == 0 ) data.erase(i);
-	if ( data[j].size() == 0 ) data.erase(j);
+	if ( data[i].size() == 0 ) erase_vertex(i);
+	if ( data[j].size() == 0 ) erase_vertex(j);
 }
 
-void Graph::clear_undir ( int i, int j )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_undir ( Id i, Id j )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR_UNDIR, pool.get());
 	if ( !contains_undir(i,j) ) return;
 	
-	data[i].erase(j);
-	data[j].erase(i);
-	if ( data[i].size() == 0 ) data.erase(i);
-	if ( data[j].size() == 0 ) data.erase(j);
+	erase_nbr(i, j);
+	erase_nbr(j, i);
+	if ( data[i].size() == 0 ) erase_vertex(i);
+	if ( data[j].size() == 0 ) erase_vertex(j);
 }
 
-void Graph::clear ( int i, int j )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, Id j )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
 	if ( directed ) clear_dir(i,j);
 	else clear_undir(i,j);
 }
 
-void Graph::clear (
-	int i, int j, const std::string& key, bool undir )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear (
+	Id i, Id j, const K& key, bool undir )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
+	clear(i, j, key_id(key), undir);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, Id j, KeyID key, bool undir )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
 	if ( !contains_undir(i,j,key) ) return;
+	unsigned int k = key.id;
 	
-	if ( undir ) {
-		data[i][j].erase(key);
-		data[j][i].erase(key);
+	if ( undir || (data[i][j][k].first
+			&& (i == j || !data[j][i][k].first)) ) {
+		erase_rel(i, j, k);
+		erase_rel(j, i, k);
 	}
 	
-	else if ( !data[i][j][key].first ) {}
-	else if ( !data[j][i][key].first ) {
-		data[j][i].erase(key);
-		data[i][j].erase(key);
-	}
-	else {
-		data[i][j][key].first = false;
-		data[i][j][key].second = data[j][i][key].second;
-	}
+	else if ( !data[i][j][k].first ) {}
+	else update(i, j, k, false, data[j][i][k].second);
 	
 	if ( data[i][j].size() == 0 ) data[i].erase(j);
 	if ( data[j][i].size() == 0 ) data[j].erase(i);
-	if ( data[i].size() == 0 ) data.erase(i);
-	if ( data[j].size() == 0 ) data.erase(j);
+	if ( data[i].size() == 0 ) erase_vertex(i);
+	if ( data[j].size() == 0 ) erase_vertex(j);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_dir ( Id i, Id j, const K& key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR_DIR, pool.get());
+	clear(i, j, key, false);
 }
 
-void Graph::clear_dir ( int i, int j, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_dir ( Id i, Id j, KeyID key )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR_DIR, pool.get());
 	clear(i, j, key, false);
 }
 
-void Graph::clear_undir ( int i, int j, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_undir ( Id i, Id j, const K& key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR_UNDIR, pool.get());
+	clear(i, j, key, true);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_undir ( Id i, Id j, KeyID key )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR_UNDIR, pool.get());
 	clear(i, j, key, true);
 }
 
-void Graph::clear ( int i, int j, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, Id j, const K& key )
+{
+	clear(i, j, key, !directed);
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, Id j, KeyID key )
 {
 	clear(i, j, key, !directed);
 }
 
 // Remove relationships from vertex.
-void Graph::clear_dir ( int i, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_dir ( Id i, const K& key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR_DIR, pool.get());
+	clear_dir(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_dir ( Id i, KeyID key )
 {
-	std::set<int> N = nbrs(i);
-	std::set<int>::iterator it = N.begin();
+	GraphProbe p (tally(), GraphStats::CLEAR_DIR, pool.get());
+	std::set<Id> N = nbrs(i, UNDIRECTED, true, key.id);
+	typename std::set<Id>::iterator it = N.begin();
 	for ( ; it != N.end(); ++it ) clear_dir(i, *it, key);
 }
 
-void Graph::clear_undir ( int i, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_undir ( Id i, const K& key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR_UNDIR, pool.get());
+	clear_undir(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear_undir ( Id i, KeyID key )
 {
-	std::set<int> N = nbrs(i, UNDIRECTED, true, key);
-	std::set<int>::iterator it = N.begin();
+	GraphProbe p (tally(), GraphStats::CLEAR_UNDIR, pool.get());
+	std::set<Id> N = nbrs(i, UNDIRECTED, true, key.id);
+	typename std::set<Id>::iterator it = N.begin();
 	for ( ; it != N.end(); ++it ) clear_undir(i, *it, key);
 }
 
-void Graph::clear ( int i, const std::string& key )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, const K& key )
 {
+	clear(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i, KeyID key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
 	if ( directed ) clear_dir(i, key);
 	else clear_undir(i, key);
 }
 
 // Remove vertex.
-void Graph::clear ( int i )
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( Id i )
 {
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
 	if ( !contains_undir(i) ) return;
 	
-	std::set<int> N = nbrs(i, UNDIRECTED, false, "");
-	data.erase(i);
-	std::set<int>::iterator it = N.begin();
+	std::set<Id> N = nbrs(i, UNDIRECTED, false, 0);
+	typename std::set<Id>::iterator it = N.begin();
 	for ( ; it != N.end(); ++it ) {
-		if ( data.find(*it) == data.end() ) continue;
-		data[*it].erase(i);
-		if ( data[*it].size() == 0 ) data.erase(*it);
+		erase_nbr(i, *it);
+		erase_nbr(*it, i);
+		if ( *it != i && data[*it].size() == 0 ) erase_vertex(*it);
 	}
+	erase_vertex(i);
 }
 
-// Remove key.
-void Graph::clear ( const std::string& key )
+// Remove key: with the key index, in time in the number of
+// relationships with the key; otherwise every pair is looked at.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( const K& key )
 {
-	// vertices
-	std::map<int, std::map<int, std::map<
-			std::string, std::pair<bool, float> > > >::iterator it =
-		data.begin();
-	for ( ; it != data.end(); ) {
-		std::map<int, std::map<std::string,
-			std::pair<bool, float> > >& V = it->second;
-		
-		// neighbors
-		std::map<int, std::map<std::string,
-			std::pair<bool, float> > >::iterator jt = V.begin();
-		for ( ; jt != V.end(); ) {
-			std::map<std::string, std::pair<bool, float> >& N =
-				jt->second;
-			
-			// relationships
-			std::map<std::string, std::pair<bool, float> >::iterator kt =
-				N.begin();
-			for ( ; kt != N.end(); ) {
-				if ( kt->first == key ) N.erase(kt++);
-				else ++kt;
-			}
-			
-			if ( N.size() == 0 ) V.erase(jt++);
-			else ++jt;
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
+	clear(key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ( KeyID key )
+{
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
+	// without an index, every relationship has the one key
+	if ( !RelStore<K, W>::INDEXED ) {
+		if ( key.id == 0 ) clear();
+		return;
+	}
+	if ( key.id >= key_names.size() || key_edges[key.id] == 0 ) return;
+	
+	// the (i, j) pairs with the key, from the index or from every pair;
+	// these include the back-links
+	std::vector<std::pair<Id, Id> > pairs;
+	if ( indexed ) {
+		const KeyIndex& X = key_index[key.id];
+		typename KeyIndex::const_iterator xt = X.begin();
+		for ( ; xt != X.end(); ++xt ) {
+			typename IdSet::const_iterator nt = xt->second.begin();
+			for ( ; nt != xt->second.end(); ++nt )
+				pairs.push_back(std::make_pair(xt->first, *nt));
+		}
+	}
+	else {
+		typename VertexMap::const_iterator it = data.begin();
+		for ( ; it != data.end(); ++it ) {
+			typename NbrMap::const_iterator jt = it->second.begin();
+			for ( ; jt != it->second.end(); ++jt )
+				if ( jt->second.find(key.id) != jt->second.end() )
+					pairs.push_back(std::make_pair(it->first, jt->first));
 		}
-		
-		if ( V.size() == 0 ) data.erase(it++);
-		else ++it;
 	}
+	
+	// remove them all before pruning, while every vertex is present
+	for ( size_t t = 0; t < pairs.size(); ++t )
+		erase_rel(pairs[t].first, pairs[t].second, key.id);
+	for ( size_t t = 0; t < pairs.size(); ++t )
+		prune(pairs[t].first, pairs[t].second);
 }
 
-// Remove all relationships.
-void Graph::clear ()
+// Remove all relationships. Interned keys remain valid.
+template <class Id, class K, class W, class S>
+void BasicGraph<Id,K,W,S>::clear ()
 {
+	GraphProbe p (tally(), GraphStats::CLEAR, pool.get());
 	data.clear();
+	ids.clear();
+	if ( tracked ) {
+		slot_ids.clear();
+		live.clear();
+		dead = 0;
+		for ( size_t c = 0; c < parts.size(); ++c ) {
+			parts[c].sets.reset(0);
+			parts[c].cuts.clear();
+		}
+	}
+	for ( size_t k = 0; k < key_index.size(); ++k ) key_index[k].clear();
+	edge_count = 0;
+	key_edges.assign(key_edges.size(), 0);
+	rel_sum = 0;
+	if ( pool ) pool->release();
+	else *this = BasicGraph(directed, no_relationship); // moved-from
 }
 
 } // namespace bygis
 
-#endif // YOUNG_GIS_GRAPH_20221111
\ No newline at end of file
+#endif // YOUNG_GIS_GRAPH_20221111
@@ -0,0 +1,451 @@
+/////////////////////////////////////////////////////////////////////
+// Traversal, shortest paths, and connected components over a      //
+// CsrGraph snapshot. Searches walk the snapshot's rows directly,  //
+// reading each relationship's value as its length, and keep their //
+// state in buffers that are reused from one search to the next.   //
+//                                                                 //
+// A search follows relationships from a vertex to its neighbors.  //
+// If the snapshot is undirected (directed == false) it also       //
+// follows relationships toward the vertex, in reverse, as nbrs()  //
+// does. Lengths must not be negative.                             //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_GRAPHALGORITHMS_20261014
+#define YOUNG_GIS_GRAPHALGORITHMS_20261014
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+#include "CsrGraph.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+// Breadth-first search and shortest paths from one source vertex. The
+// results of the last search can be read until the next one starts.
+// Not thread-safe; use one GraphSearch per thread.
+class GraphSearch {
+private:
+	// a vertex waiting in the heap, by estimated total length f
+	struct Open {
+		float f, d;
+		size_t r;
+		bool operator< ( const Open& o ) const { return f > o.f; }
+	};
+	
+	const CsrGraph* g;
+	std::vector<float> dist;
+	std::vector<size_t> parent;              // row reached from
+	std::vector<unsigned int> stamp;         // == run if reached
+	unsigned int run;
+	std::vector<size_t> order;               // rows, as reached
+	std::vector<Open> heap;
+	
+	void begin ( size_t );
+	bool reach ( size_t, size_t, float );
+	size_t bfs ( size_t, bool, unsigned int );
+	template <class H>
+	float search ( size_t, size_t, bool, unsigned int, H& );
+	
+	// heuristic of plain Dijkstra
+	struct Zero {
+		float operator() ( int ) const { return 0; }
+	};
+public:
+	static const float INFINITE;
+	
+	// constructors, destructor
+	explicit GraphSearch ( const CsrGraph& );
+	~GraphSearch ();
+	
+	// searches
+	size_t bfs ( int, const std::string& );
+	size_t bfs ( int, KeyID );
+	size_t bfs ( int );
+	size_t dijkstra ( int, const std::string& );
+	size_t dijkstra ( int, KeyID );
+	size_t dijkstra ( int );
+	float shortest_path ( int, int, const std::string& );
+	float shortest_path ( int, int, KeyID );
+	float shortest_path ( int, int );
+	template <class H> float astar ( int, int, const std::string&, H );
+	template <class H> float astar ( int, int, KeyID, H );
+	template <class H> float astar ( int, int, H );
+	
+	// results of the last search
+	size_t num_reached () const;
+	int reached_vertex ( size_t ) const;
+	bool reached ( int ) const;
+	float distance ( int ) const;
+	std::vector<int> path ( int ) const;
+}; // GraphSearch
+
+// connected components
+size_t weak_components ( const CsrGraph&, std::vector<size_t>& );
+size_t strong_components ( const CsrGraph&, std::vector<size_t>& );
+
+const float GraphSearch::INFINITE = std::numeric_limits<float>::infinity();
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Prepare to search the snapshot, which must outlive the search.
+GraphSearch::GraphSearch ( const CsrGraph& c )
+: g(&c), dist(c.size()), parent(c.size()), stamp(c.size(), 0), run(0)
+{}
+
+GraphSearch::~GraphSearch () {}
+
+
+// SEARCHES /////////////////////////////////////////////////////////
+
+// Forget the last search, in constant time, and start from row s (or
+// from nothing, if s is NO_INDEX).
+void GraphSearch::begin ( size_t s )
+{
+	if ( ++run == 0 ) {
+		std::fill(stamp.begin(), stamp.end(), 0);
+		run = 1;
+	}
+	order.clear();
+	heap.clear();
+	if ( s == CsrGraph::NO_INDEX ) return;
+	stamp[s] = run;
+	dist[s] = 0;
+	parent[s] = s;
+}
+
+// Record that row r can be reached from row p at distance d, if that
+// is shorter than any way found so far. Returns true if it is.
+bool GraphSearch::reach ( size_t r, size_t p, float d )
+{
+	if ( stamp[r] == run && dist[r] <= d ) return false;
+	stamp[r] = run;
+	dist[r] = d;
+	parent[r] = p;
+	return true;
+}
+
+// Visit the vertices reachable from row s in breadth-first order.
+size_t GraphSearch::bfs ( size_t s, bool limit_key, unsigned int key )
+{
+	begin(s);
+	if ( s == CsrGraph::NO_INDEX ) return 0;
+	
+	order.push_back(s);
+	for ( size_t n = 0; n < order.size(); ++n ) {
+		size_t r = order[n];
+		float d = dist[r] + 1;
+		size_t e;
+		for ( e = g->out_begin(r); e < g->out_end(r); ++e ) {
+			if ( limit_key && g->out_key(e).id != key ) continue;
+			size_t c = g->out_nbr(e);
+			if ( reach(c, r, d) ) order.push_back(c);
+		}
+		if ( g->directed ) continue;
+		for ( e = g->in_begin(r); e < g->in_end(r); ++e ) {
+			if ( limit_key && g->in_key(e).id != key ) continue;
+			size_t c = g->in_nbr(e);
+			if ( reach(c, r, d) ) order.push_back(c);
+		}
+	}
+	return order.size();
+}
+
+// Visit the vertices reachable from i in breadth-first order, counting
+// the relationships on the way as distances. Only follows
+// relationships with the key, if given. Returns the number of
+// vertices reached, including i.
+size_t GraphSearch::bfs ( int i, const std::string& key )
+{
+	return bfs(i, g->key_id(key));
+}
+
+size_t GraphSearch::bfs ( int i, KeyID key )
+{
+	return bfs(g->index(i), true, key.id);
+}
+
+size_t GraphSearch::bfs ( int i )
+{
+	return bfs(g->index(i), false, 0);
+}
+
+// Search from row s toward row target, or toward every row if target
+// is NO_INDEX, in order of distance plus h(vertex). Returns the
+// distance to target, or INFINITE. Relationships are only followed if
+// they have the key, when limit_key is true.
+template <class H>
+float GraphSearch::search ( size_t s, size_t target, bool limit_key,
+	unsigned int key, H& h )
+{
+	begin(s);
+	if ( s == CsrGraph::NO_INDEX ) return INFINITE;
+	
+	Open o;
+	o.r = s;
+	o.d = 0;
+	o.f = h(g->vertex(s));
+	heap.push_back(o);
+	while ( heap.size() > 0 ) {
+		std::pop_heap(heap.begin(), heap.end());
+		o = heap.back();
+		heap.pop_back();
+		size_t r = o.r;
+		if ( o.d > dist[r] ) continue; // settled already, shorter
+		order.push_back(r);
+		if ( r == target ) return o.d;
+		
+		for ( int side = 0; side < (g->directed ? 1 : 2); ++side ) {
+			size_t e = side == 0 ? g->out_begin(r) : g->in_begin(r);
+			size_t end = side == 0 ? g->out_end(r) : g->in_end(r);
+			for ( ; e < end; ++e ) {
+				KeyID k = side == 0 ? g->out_key(e) : g->in_key(e);
+				if ( limit_key && k.id != key ) continue;
+				size_t c = side == 0 ? g->out_nbr(e) : g->in_nbr(e);
+				float d = o.d + (side == 0 ? g->out_val(e) : g->in_val(e));
+				if ( !reach(c, r, d) ) continue;
+				Open n;
+				n.r = c;
+				n.d = d;
+				n.f = d + h(g->vertex(c));
+				heap.push_back(n);
+				std::push_heap(heap.begin(), heap.end());
+			}
+		}
+	}
+	return INFINITE;
+}
+
+// Find the shortest distances from i to every vertex it can reach,
+// with Dijkstra's algorithm. Only follows relationships with the key,
+// if given. Returns the number of vertices reached, including i.
+size_t GraphSearch::dijkstra ( int i, const std::string& key )
+{
+	return dijkstra(i, g->key_id(key));
+}
+
+size_t GraphSearch::dijkstra ( int i, KeyID key )
+{
+	Zero h;
+	search(g->index(i), CsrGraph::NO_INDEX, true, key.id, h);
+	return order.size();
+}
+
+size_t GraphSearch::dijkstra ( int i )
+{
+	Zero h;
+	search(g->index(i), CsrGraph::NO_INDEX, false, 0, h);
+	return order.size();
+}
+
+// Find the shortest distance from i to t, stopping once t is reached.
+// Returns INFINITE if t cannot be reached. Only follows relationships
+// with the key, if given.
+float GraphSearch::shortest_path ( int i, int t, const std::string& key )
+{
+	return shortest_path(i, t, g->key_id(key));
+}
+
+float GraphSearch::shortest_path ( int i, int t, KeyID key )
+{
+	Zero h;
+	size_t target = g->index(t);
+	if ( target == CsrGraph::NO_INDEX ) return INFINITE;
+	return search(g->index(i), target, true, key.id, h);
+}
+
+float GraphSearch::shortest_path ( int i, int t )
+{
+	Zero h;
+	size_t target = g->index(t);
+	if ( target == CsrGraph::NO_INDEX ) return INFINITE;
+	return search(g->index(i), target, false, 0, h);
+}
+
+// As shortest_path, guided by h(j), an estimate of the distance from
+// vertex j to t that is never too high and for which h(j) <= x + h(k)
+// for every relationship from j to k of length x (for example, the
+// straight-line distance between locations).
+template <class H>
+float GraphSearch::astar ( int i, int t, const std::string& key, H h )
+{
+	return astar(i, t, g->key_id(key), h);
+}
+
+template <class H>
+float GraphSearch::astar ( int i, int t, KeyID key, H h )
+{
+	size_t target = g->index(t);
+	if ( target == CsrGraph::NO_INDEX ) return INFINITE;
+	return search(g->index(i), target, true, key.id, h);
+}
+
+template <class H>
+float GraphSearch::astar ( int i, int t, H h )
+{
+	size_t target = g->index(t);
+	if ( target == CsrGraph::NO_INDEX ) return INFINITE;
+	return search(g->index(i), target, false, 0, h);
+}
+
+
+// RESULTS //////////////////////////////////////////////////////////
+
+// Get the number of vertices reached by the last search. For dijkstra
+// and shortest_path, these are the vertices whose distances are final.
+size_t GraphSearch::num_reached () const
+{
+	return order.size();
+}
+
+// Get the n-th vertex reached, in the order they were reached (which
+// is in order of distance).
+int GraphSearch::reached_vertex ( size_t n ) const
+{
+	return g->vertex(order[n]);
+}
+
+// True if the last search found a way to vertex j.
+bool GraphSearch::reached ( int j ) const
+{
+	size_t r = g->index(j);
+	return r != CsrGraph::NO_INDEX && stamp[r] == run;
+}
+
+// Get the distance to j found by the last search, or INFINITE. After
+// a search that stopped early, the distances of vertices that were
+// not yet settled may not be the shortest.
+float GraphSearch::distance ( int j ) const
+{
+	size_t r = g->index(j);
+	if ( r == CsrGraph::NO_INDEX || stamp[r] != run ) return INFINITE;
+	return dist[r];
+}
+
+// Get the vertices on the way to j found by the last search, from its
+// source to j, or an empty path if j was not reached.
+std::vector<int> GraphSearch::path ( int j ) const
+{
+	std::vector<int> out;
+	size_t r = g->index(j);
+	if ( r == CsrGraph::NO_INDEX || stamp[r] != run ) return out;
+	for ( ; parent[r] != r; r = parent[r] ) out.push_back(g->vertex(r));
+	out.push_back(g->vertex(r));
+	std::reverse(out.begin(), out.end());
+	return out;
+}
+
+
+
+// COMPONENTS ///////////////////////////////////////////////////////
+
+// Label each row of the snapshot with its weakly connected component:
+// two vertices are in the same component if a chain of relationships,
+// in either direction, joins them. Sets component[r] to the component
+// of row r (vertex c.vertex(r)); components are numbered from 0 in
+// order of their first rows. Returns the number of components.
+size_t weak_components ( const CsrGraph& c, std::vector<size_t>& component )
+{
+	// union-find over the relationships, halving paths on the way up
+	size_t n = c.size();
+	std::vector<size_t> up (n);
+	for ( size_t r = 0; r < n; ++r ) up[r] = r;
+	for ( size_t r = 0; r < n; ++r ) {
+		for ( size_t e = c.out_begin(r); e < c.out_end(r); ++e ) {
+			size_t a = r, b = c.out_nbr(e);
+			while ( up[a] != a ) a = up[a] = up[up[a]];
+			while ( up[b] != b ) b = up[b] = up[up[b]];
+			if ( a < b ) up[b] = a;
+			else up[a] = b;
+		}
+	}
+	
+	// the root of a set is its first row, so sets are numbered in order
+	component.assign(n, 0);
+	size_t count = 0;
+	for ( size_t r = 0; r < n; ++r ) {
+		size_t a = r;
+		while ( up[a] != a ) a = up[a];
+		component[r] = a == r ? count++ : component[a];
+	}
+	return count;
+}
+
+// Label each row of the snapshot with its strongly connected
+// component: two vertices are in the same component if each can be
+// reached from the other by following relationships (in either
+// direction, in an undirected snapshot). Sets component[r] to the
+// component of row r; components are numbered from 0 so that no
+// relationship leads from a component to a higher-numbered one.
+// Returns the number of components.
+size_t strong_components ( const CsrGraph& c, std::vector<size_t>& component )
+{
+	// Tarjan's algorithm, with an explicit stack of (row, next edge)
+	const size_t NONE = CsrGraph::NO_INDEX;
+	size_t n = c.size();
+	std::vector<size_t> num (n, NONE), low (n);
+	std::vector<bool> open (n, false);
+	std::vector<size_t> stack;
+	std::vector<std::pair<size_t, size_t> > calls;
+	size_t count = 0, next = 0;
+	component.assign(n, 0);
+	
+	for ( size_t s = 0; s < n; ++s ) {
+		if ( num[s] != NONE ) continue;
+		num[s] = low[s] = next++;
+		stack.push_back(s);
+		open[s] = true;
+		calls.push_back(std::make_pair(s, (size_t)0));
+		
+		while ( calls.size() > 0 ) {
+			size_t r = calls.back().first;
+			size_t e = calls.back().second;
+			size_t outs = c.out_end(r) - c.out_begin(r);
+			size_t degree = c.directed ? outs
+				: outs + c.in_end(r) - c.in_begin(r);
+			
+			// next neighbor
+			if ( e < degree ) {
+				++calls.back().second;
+				size_t j = e < outs ? c.out_nbr(c.out_begin(r) + e)
+					: c.in_nbr(c.in_begin(r) + e - outs);
+				if ( num[j] == NONE ) {
+					num[j] = low[j] = next++;
+					stack.push_back(j);
+					open[j] = true;
+					calls.push_back(std::make_pair(j, (size_t)0));
+				}
+				else if ( open[j] ) low[r] = std::min(low[r], num[j]);
+				continue;
+			}
+			
+			// done with r
+			calls.pop_back();
+			if ( calls.size() > 0 ) {
+				size_t p = calls.back().first;
+				low[p] = std::min(low[p], low[r]);
+			}
+			if ( low[r] != num[r] ) continue;
+			size_t j;
+			do {
+				j = stack.back();
+				stack.pop_back();
+				open[j] = false;
+				component[j] = count;
+			} while ( j != r );
+			++count;
+		}
+	}
+	return count;
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_GRAPHALGORITHMS_20261014
@@ -0,0 +1,300 @@
+/////////////////////////////////////////////////////////////////////
+// Benchmarks of the graph's hot operations on synthetic graphs:   //
+// random, grid (road-like), power-law, and multigraphs with k     //
+// keys. Each line reports the throughput of one operation, the    //
+// heap it needed at its peak, and the allocations it made per     //
+// operation. Run before and after a change to judge it.           //
+//                                                                 //
+//   g++ -std=c++11 -O2 GraphBenchmark.cpp -o GraphBenchmark       //
+//   ./GraphBenchmark [scale]                                      //
+//                                                                 //
+// scale (default 1) multiplies the sizes of the graphs. Counts    //
+// come from replacing the global operator new and delete, so the  //
+// program measures everything allocated on the heap, the graph's  //
+// pool blocks included.                                           //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+
+// HEAP COUNTS //////////////////////////////////////////////////////
+
+// GCC sees delete inlined into code that called new, and warns of the
+// free() that matches this file's malloc().
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+// heap in use, and its peak, in bytes; calls to operator new
+struct HeapCounts {
+	size_t live, peak, calls;
+};
+HeapCounts heap = { 0, 0, 0 };
+
+// each block starts with its size, so that delete can count it
+const size_t HEADER = 16;
+
+void* counted_new ( size_t n )
+{
+	char* p = static_cast<char*>(std::malloc(n + HEADER));
+	if ( !p ) return 0;
+	*reinterpret_cast<size_t*>(p) = n;
+	heap.live += n;
+	if ( heap.live > heap.peak ) heap.peak = heap.live;
+	++heap.calls;
+	return p + HEADER;
+}
+
+void counted_delete ( void* q )
+{
+	if ( !q ) return;
+	char* p = static_cast<char*>(q) - HEADER;
+	heap.live -= *reinterpret_cast<size_t*>(p);
+	std::free(p);
+}
+
+} // namespace
+
+void* operator new ( size_t n )
+{
+	void* p = counted_new(n);
+	if ( !p ) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new ( size_t n, const std::nothrow_t& ) noexcept
+{
+	return counted_new(n);
+}
+
+void operator delete ( void* p ) noexcept
+{
+	counted_delete(p);
+}
+
+void operator delete ( void* p, const std::nothrow_t& ) noexcept
+{
+	counted_delete(p);
+}
+
+
+// MEASUREMENT //////////////////////////////////////////////////////
+
+namespace {
+
+// Times one operation from construction to report(), and counts the
+// heap it used above what was in use when it started.
+class Meter {
+private:
+	std::chrono::steady_clock::time_point start;
+	size_t base, calls;
+public:
+	Meter ()
+	{
+		base = heap.peak = heap.live;
+		calls = heap.calls;
+		start = std::chrono::steady_clock::now();
+	}
+	
+	// Print a line for ops operations of the given name.
+	void report ( const char* graph, const char* name, size_t ops )
+	{
+		std::chrono::duration<double> t =
+			std::chrono::steady_clock::now() - start;
+		double s = t.count();
+		double n = ops > 0 ? ops : 1;
+		std::printf("%-10s %-14s %10zu %10.1f %10.3f %10.1f %8.2f\n",
+			graph, name, ops, 1000 * s, ops / s / 1e6,
+			(heap.peak - base) / 1048576.0, (heap.calls - calls) / n);
+	}
+}; // Meter
+
+// keeps results alive, so the work that makes them is not dropped
+volatile double sink;
+
+
+// GENERATORS ///////////////////////////////////////////////////////
+
+typedef std::vector<bygis::Graph::Edge> Edges;
+
+// m directed relationships between random pairs of n vertices.
+Edges random_graph ( int n, size_t m, std::mt19937& rng )
+{
+	std::uniform_int_distribution<int> v (0, n - 1);
+	std::uniform_real_distribution<float> x (1, 10);
+	Edges E;
+	E.reserve(m);
+	for ( size_t e = 0; e < m; ++e )
+		E.push_back(bygis::Graph::Edge(v(rng), v(rng), x(rng)));
+	return E;
+}
+
+// A w by h grid of "road" relationships in both directions between
+// each vertex and those to its east and south, as a road network.
+Edges grid_graph ( int w, int h, std::mt19937& rng )
+{
+	std::uniform_real_distribution<float> x (1, 10);
+	Edges E;
+	E.reserve(2 * (size_t)w * h);
+	for ( int r = 0; r < h; ++r ) {
+		for ( int c = 0; c < w; ++c ) {
+			int i = r * w + c;
+			if ( c + 1 < w ) E.push_back(
+				bygis::Graph::Edge(i, i + 1, "road", true, x(rng)));
+			if ( r + 1 < h ) E.push_back(
+				bygis::Graph::Edge(i, i + w, "road", true, x(rng)));
+		}
+	}
+	return E;
+}
+
+// n vertices, each with d relationships toward earlier vertices that
+// are chosen in proportion to their degrees (preferential attachment),
+// so that a few vertices have most of the neighbors.
+Edges power_law_graph ( int n, int d, std::mt19937& rng )
+{
+	std::uniform_real_distribution<float> x (1, 10);
+	std::vector<int> ends;                 // each vertex once per edge
+	Edges E;
+	E.reserve((size_t)n * d);
+	for ( int i = 0; i < n; ++i ) {
+		for ( int k = 0; k < d && i > 0; ++k ) {
+			int j = ends.empty() ? 0 :
+				ends[std::uniform_int_distribution<size_t>(
+				0, ends.size() - 1)(rng)];
+			E.push_back(bygis::Graph::Edge(i, j, x(rng)));
+			ends.push_back(j);
+		}
+		ends.push_back(i);
+	}
+	return E;
+}
+
+// m directed relationships between random pairs of n vertices, each
+// with one of k keys "k0".."k(k-1)".
+Edges multigraph ( int n, size_t m, int k, std::mt19937& rng )
+{
+	std::uniform_int_distribution<int> v (0, n - 1);
+	std::uniform_int_distribution<int> key (0, k - 1);
+	std::uniform_real_distribution<float> x (1, 10);
+	Edges E;
+	E.reserve(m);
+	for ( size_t e = 0; e < m; ++e ) {
+		E.push_back(bygis::Graph::Edge(v(rng), v(rng),
+			"k" + std::to_string(key(rng)), false, x(rng)));
+	}
+	return E;
+}
+
+
+// BENCHMARKS ///////////////////////////////////////////////////////
+
+// Run every benchmark on the graph made from E; key is the key that
+// clear(key) removes.
+void run ( const char* name, const Edges& E, const std::string& key,
+	std::mt19937& rng )
+{
+	// building
+	bygis::Graph G;
+	{
+		Meter m;
+		for ( size_t e = 0; e < E.size(); ++e )
+			G.set(E[e].i, E[e].j, E[e].key, E[e].undir, E[e].x);
+		m.report(name, "set", E.size());
+	}
+	{
+		bygis::Graph H;
+		Meter m;
+		H.assign_edges(E.begin(), E.end());
+		m.report(name, "assign_edges", E.size());
+	}
+	
+	// queries on pairs that were set, and on random pairs
+	std::vector<int> V;
+	bygis::Graph::VertexRange R = G.vertex_range();
+	for ( bygis::Graph::VertexIterator it = R.begin(); it != R.end(); ++it )
+		V.push_back(*it);
+	std::uniform_int_distribution<size_t> pick (0, V.size() - 1);
+	std::vector<int> Q;
+	for ( size_t q = 0; q < E.size(); ++q ) Q.push_back(V[pick(rng)]);
+	{
+		double s = 0;
+		Meter m;
+		for ( size_t e = 0; e < E.size(); ++e )
+			s += G.get(E[e].i, E[e].j, E[e].key);
+		m.report(name, "get (hit)", E.size());
+		sink = s;
+	}
+	{
+		double s = 0;
+		Meter m;
+		for ( size_t q = 0; q + 1 < Q.size(); ++q )
+			s += G.get(Q[q], Q[q + 1]);
+		m.report(name, "get (random)", Q.size() - 1);
+		sink = s;
+	}
+	{
+		size_t s = 0;
+		Meter m;
+		for ( size_t q = 0; q < Q.size(); ++q ) s += G.nbrs_from(Q[q]).size();
+		m.report(name, "nbrs_from", Q.size());
+		sink = s;
+	}
+	{
+		size_t s = 0;
+		Meter m;
+		for ( size_t q = 0; q < Q.size(); ++q ) s += G.nbrs_to(Q[q]).size();
+		m.report(name, "nbrs_to", Q.size());
+		sink = s;
+	}
+	
+	// copying, and removing a key from the copy
+	{
+		Meter m;
+		bygis::Graph H (G);
+		m.report(name, "copy", G.num_edges());
+		size_t n = H.num_edges(key);
+		Meter c;
+		H.clear(key);
+		c.report(name, "clear(key)", n);
+	}
+}
+
+} // namespace
+
+
+// MAIN /////////////////////////////////////////////////////////////
+
+int main ( int argc, char** argv )
+{
+	double scale = argc > 1 ? std::atof(argv[1]) : 1;
+	if ( scale <= 0 ) scale = 1;
+	int n = (int)(100000 * scale);
+	size_t m = (size_t)(400000 * scale);
+	int side = 1;
+	while ( side * side < n ) ++side;
+	std::mt19937 rng (1);
+	
+	std::printf("%-10s %-14s %10s %10s %10s %10s %8s\n", "graph",
+		"operation", "ops", "ms", "Mops/s", "peak MB", "allocs");
+	run("random", random_graph(n, m, rng), "", rng);
+	run("grid", grid_graph(side, side, rng), "road", rng);
+	run("power-law", power_law_graph(n, 4, rng), "", rng);
+	run("multi-4", multigraph(n, m, 4, rng), "k0", rng);
+	run("multi-16", multigraph(n, m, 16, rng), "k0", rng);
+	return 0;
+}
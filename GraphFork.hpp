@@ -0,0 +1,830 @@
+/////////////////////////////////////////////////////////////////////
+// Editable version of a frozen graph that shares the frozen       //
+// arrays instead of copying them. A GraphFork reads through to a  //
+// CsrGraph base, and keeps its own copy of the relationships of   //
+// only the vertices that it changes. Forking a fork shares those  //
+// copies too; a vertex is copied again only when one of the forks //
+// that share it changes it. Queries and changes have the same     //
+// meaning as on Graph.                                            //
+//                                                                 //
+// A fork is used like a Graph: any number of threads may read it  //
+// while none is changing it. Forks that share rows may be used by //
+// different threads, as a shared row is copied before it changes. //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// 10/15/2026                                                      //
+// - set with a KeyID the fork did not issue does nothing.         //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_GRAPHFORK_20261014
+#define YOUNG_GIS_GRAPHFORK_20261014
+
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+class GraphFork {
+private:
+	static const unsigned char UNDIRECTED;
+	static const unsigned char FROM;
+	static const unsigned char TO;
+	
+	// The relationships of a changed vertex, toward (out) and from (in)
+	// each neighbor, by (neighbor, key ID). A self-loop is in both.
+	typedef std::pair<int, unsigned int> Arc;
+	typedef std::map<Arc, float> Arcs;
+	struct Row {
+		Arcs out, in;
+		bool empty () const { return out.empty() && in.empty(); }
+	};
+	typedef std::map<int, std::shared_ptr<Row> > RowMap;
+	
+	std::shared_ptr<const CsrGraph> base;
+	RowMap rows;                     // vertices changed since the base
+	
+	// keys of the base, then those interned since
+	std::vector<std::string> key_names;
+	std::map<std::string, unsigned int> key_ids;
+	
+	size_t n, m;                     // vertices, relationships
+	
+	void init ();
+	const Row* row ( int ) const;
+	Row& own ( int );
+	std::vector<unsigned int> arc_keys ( int, int, bool ) const;
+	void add_arc ( int, int, unsigned int, float );
+	void remove_arc ( int, int, unsigned int );
+	std::set<int> nbrs ( int, unsigned char, bool, unsigned int ) const;
+public:
+	bool directed;
+	float no_relationship;
+	
+	// constructors, destructor
+	explicit GraphFork ( const std::shared_ptr<const CsrGraph>& );
+	explicit GraphFork ( const CsrGraph& );
+	explicit GraphFork ( const Graph& );
+	~GraphFork ();
+	
+	// versions
+	GraphFork fork () const;
+	size_t num_changed () const;
+	Graph thaw () const;
+	
+	// keys
+	KeyID key_id ( const std::string& ) const;
+	KeyID intern ( const std::string& );
+	const std::string& key_name ( KeyID ) const;
+	size_t num_keys () const;
+	
+	// operations, as on Graph
+	size_t size () const;
+	size_t num_edges () const;
+	std::set<int> nbrs ( int, const std::string& ) const;
+	std::set<int> nbrs ( int, KeyID ) const;
+	std::set<int> nbrs ( int ) const;
+	std::set<int> nbrs_to ( int, const std::string& ) const;
+	std::set<int> nbrs_to ( int, KeyID ) const;
+	std::set<int> nbrs_to ( int ) const;
+	std::set<int> nbrs_from ( int, const std::string& ) const;
+	std::set<int> nbrs_from ( int, KeyID ) const;
+	std::set<int> nbrs_from ( int ) const;
+	std::set<int> vertices () const;
+	std::set<std::string> keys () const;
+	std::set<std::string> keys ( int ) const;
+	std::set<std::string> keys ( int, int ) const;
+	bool contains ( int, int, const std::string&, bool ) const;
+	bool contains ( int, int, KeyID, bool ) const;
+	bool contains_dir ( int, int, const std::string& ) const;
+	bool contains_dir ( int, int, KeyID ) const;
+	bool contains_undir ( int, int, const std::string& ) const;
+	bool contains_undir ( int, int, KeyID ) const;
+	bool contains ( int, int, const std::string& ) const;
+	bool contains ( int, int, KeyID ) const;
+	bool contains_dir ( int, int ) const;
+	bool contains_undir ( int, int ) const;
+	bool contains ( int, int ) const;
+	bool contains_dir ( int ) const;
+	bool contains_undir ( int ) const;
+	bool contains ( int ) const;
+	float get ( int, int, const std::string& ) const;
+	float get ( int, int, KeyID ) const;
+	float get ( int, int ) const;
+	void set ( int, int, const std::string&, bool, float );
+	void set ( int, int, KeyID, bool, float );
+	void set ( int, int, const std::string&, float );
+	void set ( int, int, KeyID, float );
+	void set_dir ( int, int, const std::string&, float );
+	void set_dir ( int, int, KeyID, float );
+	void set_undir ( int, int, const std::string&, float );
+	void set_undir ( int, int, KeyID, float );
+	void set ( int, int, float );
+	void set_dir ( int, int, float );
+	void set_undir ( int, int, float );
+	void clear_dir ( int, int );
+	void clear_undir ( int, int );
+	void clear ( int, int );
+	void clear ( int, int, const std::string&, bool );
+	void clear ( int, int, KeyID, bool );
+	void clear_dir ( int, int, const std::string& );
+	void clear_dir ( int, int, KeyID );
+	void clear_undir ( int, int, const std::string& );
+	void clear_undir ( int, int, KeyID );
+	void clear ( int, int, const std::string& );
+	void clear ( int, int, KeyID );
+	void clear_dir ( int, const std::string& );
+	void clear_dir ( int, KeyID );
+	void clear_undir ( int, const std::string& );
+	void clear_undir ( int, KeyID );
+	void clear ( int, const std::string& );
+	void clear ( int, KeyID );
+	void clear ( int );
+}; // GraphFork
+
+const unsigned char GraphFork::UNDIRECTED = 0;
+const unsigned char GraphFork::FROM = 1;
+const unsigned char GraphFork::TO = 2;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Fork a snapshot that is shared, such as one published by
+// UpdateLog::commit. The snapshot must not be null.
+GraphFork::GraphFork ( const std::shared_ptr<const CsrGraph>& c )
+: base(c)
+{
+	init();
+}
+
+// Fork a snapshot; the fork shares its arrays, as a copy would.
+GraphFork::GraphFork ( const CsrGraph& c )
+: base(new CsrGraph(c))
+{
+	init();
+}
+
+// Fork a graph, by freezing it.
+GraphFork::GraphFork ( const Graph& g )
+: base(new CsrGraph(g))
+{
+	init();
+}
+
+GraphFork::~GraphFork () {}
+
+// Take the keys, counts, and settings of the base.
+void GraphFork::init ()
+{
+	for ( size_t k = 0; k < base->num_keys(); ++k ) {
+		key_names.push_back(base->key_name(KeyID(k)));
+		key_ids.insert(std::make_pair(key_names[k], (unsigned int)k));
+	}
+	intern(std::string());
+	n = base->size();
+	m = base->num_out();
+	directed = base->directed;
+	no_relationship = base->no_relationship;
+}
+
+
+// VERSIONS /////////////////////////////////////////////////////////
+
+// Get a fork of this version, which starts out the same and then
+// changes separately. Takes time in the number of changed vertices,
+// and copies none of their relationships until one of the two forks
+// changes them. The same as a copy.
+GraphFork GraphFork::fork () const
+{
+	return *this;
+}
+
+// Get the number of vertices whose relationships this fork holds
+// rather than reading them from the base.
+size_t GraphFork::num_changed () const
+{
+	return rows.size();
+}
+
+// Get an ordinary graph with the contents and KeyIDs of this version.
+Graph GraphFork::thaw () const
+{
+	Graph g (directed, no_relationship);
+	for ( size_t k = 0; k < key_names.size(); ++k ) g.intern(key_names[k]);
+	
+	std::vector<Graph::Edge> E;
+	E.reserve(m);
+	for ( size_t r = 0; r < base->size(); ++r ) {
+		int i = base->vertex(r);
+		if ( rows.count(i) > 0 ) continue;
+		for ( size_t e = base->out_begin(r); e < base->out_end(r); ++e ) {
+			E.push_back(Graph::Edge(i, base->vertex(base->out_nbr(e)),
+				key_names[base->out_key(e).id], false, base->out_val(e)));
+		}
+	}
+	RowMap::const_iterator it = rows.begin();
+	for ( ; it != rows.end(); ++it ) {
+		const Arcs& A = it->second->out;
+		for ( Arcs::const_iterator at = A.begin(); at != A.end(); ++at ) {
+			E.push_back(Graph::Edge(it->first, at->first.first,
+				key_names[at->first.second], false, at->second));
+		}
+	}
+	g.assign_edges(E.begin(), E.end());
+	return g;
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of a key, or Graph::NO_KEY if the fork does not have it.
+// Keys of the base keep their IDs.
+KeyID GraphFork::key_id ( const std::string& key ) const
+{
+	std::map<std::string, unsigned int>::const_iterator it =
+		key_ids.find(key);
+	if ( it == key_ids.end() ) return Graph::NO_KEY;
+	return KeyID(it->second);
+}
+
+KeyID GraphFork::intern ( const std::string& key )
+{
+	std::map<std::string, unsigned int>::iterator it = key_ids.find(key);
+	if ( it != key_ids.end() ) return KeyID(it->second);
+	unsigned int k = key_names.size();
+	key_names.push_back(key);
+	key_ids.insert(std::make_pair(key, k));
+	return KeyID(k);
+}
+
+const std::string& GraphFork::key_name ( KeyID k ) const
+{
+	return key_names[k.id];
+}
+
+size_t GraphFork::num_keys () const
+{
+	return key_names.size();
+}
+
+
+// ROWS /////////////////////////////////////////////////////////////
+
+// Get the relationships of vertex i, or null if they are unchanged
+// and in the base.
+const GraphFork::Row* GraphFork::row ( int i ) const
+{
+	RowMap::const_iterator it = rows.find(i);
+	return it == rows.end() ? 0 : it->second.get();
+}
+
+// Get the relationships of vertex i to change, first copying them
+// from the base, or from the forks this one shares them with.
+GraphFork::Row& GraphFork::own ( int i )
+{
+	RowMap::iterator it = rows.find(i);
+	if ( it == rows.end() ) {
+		std::shared_ptr<Row> R (new Row);
+		size_t r = base->index(i);
+		if ( r != CsrGraph::NO_INDEX ) {
+			size_t e;
+			for ( e = base->out_begin(r); e < base->out_end(r); ++e ) {
+				Arc a (base->vertex(base->out_nbr(e)), base->out_key(e).id);
+				R->out.emplace_hint(R->out.end(), a, base->out_val(e));
+			}
+			for ( e = base->in_begin(r); e < base->in_end(r); ++e ) {
+				Arc a (base->vertex(base->in_nbr(e)), base->in_key(e).id);
+				R->in.emplace_hint(R->in.end(), a, base->in_val(e));
+			}
+		}
+		it = rows.insert(std::make_pair(i, R)).first;
+	}
+	else if ( it->second.use_count() > 1 ) {
+		it->second = std::make_shared<Row>(*it->second);
+	}
+	else {
+		// the other forks have let go of it; see their last reads
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+	return *it->second;
+}
+
+// Get the keys of the relationships from i toward j (out), or from j
+// toward i.
+std::vector<unsigned int> GraphFork::arc_keys ( int i, int j,
+	bool out ) const
+{
+	std::vector<unsigned int> ks;
+	const Row* R = row(i);
+	if ( R ) {
+		const Arcs& A = out ? R->out : R->in;
+		Arcs::const_iterator at = A.lower_bound(Arc(j, 0));
+		for ( ; at != A.end() && at->first.first == j; ++at )
+			ks.push_back(at->first.second);
+		return ks;
+	}
+	
+	size_t r = base->index(i);
+	size_t c = base->index(j);
+	if ( r == CsrGraph::NO_INDEX || c == CsrGraph::NO_INDEX ) return ks;
+	size_t e = out ? base->out_begin(r) : base->in_begin(r);
+	size_t end = out ? base->out_end(r) : base->in_end(r);
+	for ( ; e < end; ++e ) {
+		size_t d = out ? base->out_nbr(e) : base->in_nbr(e);
+		KeyID k = out ? base->out_key(e) : base->in_key(e);
+		if ( d == c ) ks.push_back(k.id);
+	}
+	return ks;
+}
+
+// Set the relationship from i toward j with key k.
+void GraphFork::add_arc ( int i, int j, unsigned int k, float x )
+{
+	Row& a = own(i);
+	Row& b = own(j);
+	if ( a.empty() ) ++n;
+	if ( &b != &a && b.empty() ) ++n;
+	
+	std::pair<Arcs::iterator, bool> t =
+		a.out.insert(std::make_pair(Arc(j, k), x));
+	if ( t.second ) ++m;
+	else t.first->second = x;
+	b.in[Arc(i, k)] = x;
+}
+
+// Remove the relationship from i toward j with key k, if there is one.
+void GraphFork::remove_arc ( int i, int j, unsigned int k )
+{
+	if ( !contains(i, j, KeyID(k), false) ) return;
+	Row& a = own(i);
+	Row& b = own(j);
+	a.out.erase(Arc(j, k));
+	b.in.erase(Arc(i, k));
+	--m;
+	if ( a.empty() ) --n;
+	if ( &b != &a && b.empty() ) --n;
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of vertices represented in the graph.
+size_t GraphFork::size () const
+{
+	return n;
+}
+
+// Get the number of relationships, as Graph::num_edges.
+size_t GraphFork::num_edges () const
+{
+	return m;
+}
+
+// Get a set of neighbor IDs.
+std::set<int> GraphFork::nbrs ( int i, unsigned char dir,
+	bool limit_key, unsigned int key ) const
+{
+	const Row* R = row(i);
+	if ( !R ) {
+		if ( dir == FROM ) {
+			return limit_key ? base->nbrs_from(i, KeyID(key))
+				: base->nbrs_from(i);
+		}
+		if ( dir == TO ) {
+			return limit_key ? base->nbrs_to(i, KeyID(key))
+				: base->nbrs_to(i);
+		}
+		return limit_key ? base->nbrs(i, KeyID(key)) : base->nbrs(i);
+	}
+	
+	std::set<int> out;
+	Arcs::const_iterator at;
+	if ( dir != TO ) {
+		for ( at = R->out.begin(); at != R->out.end(); ++at )
+			if ( !limit_key || at->first.second == key )
+				out.insert(out.end(), at->first.first);
+	}
+	if ( dir != FROM ) {
+		for ( at = R->in.begin(); at != R->in.end(); ++at )
+			if ( !limit_key || at->first.second == key )
+				out.insert(at->first.first);
+	}
+	return out;
+}
+
+std::set<int> GraphFork::nbrs ( int i, const std::string& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+std::set<int> GraphFork::nbrs ( int i, KeyID key ) const
+{
+	return nbrs(i, UNDIRECTED, true, key.id);
+}
+
+std::set<int> GraphFork::nbrs ( int i ) const
+{
+	return nbrs(i, UNDIRECTED, false, 0);
+}
+
+std::set<int> GraphFork::nbrs_to ( int i, const std::string& key ) const
+{
+	return nbrs_to(i, key_id(key));
+}
+
+std::set<int> GraphFork::nbrs_to ( int i, KeyID key ) const
+{
+	return nbrs(i, TO, true, key.id);
+}
+
+std::set<int> GraphFork::nbrs_to ( int i ) const
+{
+	return nbrs(i, TO, false, 0);
+}
+
+std::set<int> GraphFork::nbrs_from (
+	int i, const std::string& key ) const
+{
+	return nbrs_from(i, key_id(key));
+}
+
+std::set<int> GraphFork::nbrs_from ( int i, KeyID key ) const
+{
+	return nbrs(i, FROM, true, key.id);
+}
+
+std::set<int> GraphFork::nbrs_from ( int i ) const
+{
+	return nbrs(i, FROM, false, 0);
+}
+
+// Returns a set of object IDs.
+std::set<int> GraphFork::vertices () const
+{
+	std::set<int> out;
+	for ( size_t r = 0; r < base->size(); ++r ) {
+		int i = base->vertex(r);
+		if ( rows.count(i) == 0 ) out.insert(out.end(), i);
+	}
+	RowMap::const_iterator it = rows.begin();
+	for ( ; it != rows.end(); ++it )
+		if ( !it->second->empty() ) out.insert(it->first);
+	return out;
+}
+
+// Returns all of the keys in the graph.
+std::set<std::string> GraphFork::keys () const
+{
+	std::vector<bool> used (key_names.size(), false);
+	for ( size_t r = 0; r < base->size(); ++r ) {
+		if ( rows.count(base->vertex(r)) > 0 ) continue;
+		for ( size_t e = base->out_begin(r); e < base->out_end(r); ++e )
+			used[base->out_key(e).id] = true;
+	}
+	RowMap::const_iterator it = rows.begin();
+	for ( ; it != rows.end(); ++it ) {
+		const Arcs& A = it->second->out;
+		for ( Arcs::const_iterator at = A.begin(); at != A.end(); ++at )
+			used[at->first.second] = true;
+	}
+	
+	std::set<std::string> out;
+	for ( size_t k = 0; k < used.size(); ++k )
+		if ( used[k] ) out.insert(key_names[k]);
+	return out;
+}
+
+// Returns all of the keys associated with the vertex.
+std::set<std::string> GraphFork::keys ( int i ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->keys(i);
+	
+	std::set<std::string> out;
+	Arcs::const_iterator at;
+	for ( at = R->out.begin(); at != R->out.end(); ++at )
+		out.insert(key_names[at->first.second]);
+	for ( at = R->in.begin(); at != R->in.end(); ++at )
+		out.insert(key_names[at->first.second]);
+	return out;
+}
+
+// Returns a set of the relationship's keys or properties.
+std::set<std::string> GraphFork::keys ( int i, int j ) const
+{
+	if ( !row(i) ) return base->keys(i, j);
+	
+	std::set<std::string> out;
+	std::vector<unsigned int> ks = arc_keys(i, j, true);
+	for ( size_t k = 0; k < ks.size(); ++k ) out.insert(key_names[ks[k]]);
+	ks = arc_keys(i, j, false);
+	for ( size_t k = 0; k < ks.size(); ++k ) out.insert(key_names[ks[k]]);
+	return out;
+}
+
+// Returns true if the relationship exists for the given key.
+bool GraphFork::contains (
+	int i, int j, const std::string& key, bool undir ) const
+{
+	return contains(i, j, key_id(key), undir);
+}
+
+bool GraphFork::contains ( int i, int j, KeyID key, bool undir ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->contains(i, j, key, undir);
+	if ( R->out.count(Arc(j, key.id)) > 0 ) return true;
+	return undir && R->in.count(Arc(j, key.id)) > 0;
+}
+
+bool GraphFork::contains_dir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool GraphFork::contains_dir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool GraphFork::contains_undir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool GraphFork::contains_undir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool GraphFork::contains ( int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+bool GraphFork::contains ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+// Returns true if a relationship exists between the given vertices.
+bool GraphFork::contains_dir ( int i, int j ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->contains_dir(i, j);
+	Arcs::const_iterator at = R->out.lower_bound(Arc(j, 0));
+	return at != R->out.end() && at->first.first == j;
+}
+
+bool GraphFork::contains_undir ( int i, int j ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->contains_undir(i, j);
+	Arcs::const_iterator at = R->in.lower_bound(Arc(j, 0));
+	return contains_dir(i, j) || (at != R->in.end() && at->first.first == j);
+}
+
+bool GraphFork::contains ( int i, int j ) const
+{
+	if ( directed ) return contains_dir(i, j);
+	return contains_undir(i, j);
+}
+
+// Returns true if the given vertex exists. If specifying directed
+// (undir=false), only returns true if the vertex has an outgoing
+// 'from' relationship.
+bool GraphFork::contains_dir ( int i ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->contains_dir(i);
+	return !R->out.empty();
+}
+
+bool GraphFork::contains_undir ( int i ) const
+{
+	const Row* R = row(i);
+	if ( !R ) return base->contains_undir(i);
+	return !R->empty();
+}
+
+bool GraphFork::contains ( int i ) const
+{
+	if ( directed ) return contains_dir(i);
+	return contains_undir(i);
+}
+
+// Returns the value of the relationship. If the relationship does
+// not exist, returns the no_relationship value. As on Graph, if the
+// relationship only exists from j to i, returns its value negated.
+float GraphFork::get ( int i, int j, const std::string& key ) const
+{
+	return get(i, j, key_id(key));
+}
+
+float GraphFork::get ( int i, int j, KeyID key ) const
+{
+	const Row* R = row(i);
+	if ( !R ) {
+		if ( !base->contains_undir(i, j, key) ) return no_relationship;
+		return base->get(i, j, key);
+	}
+	
+	Arcs::const_iterator at = R->out.find(Arc(j, key.id));
+	if ( at != R->out.end() ) return at->second;
+	at = R->in.find(Arc(j, key.id));
+	if ( at != R->in.end() ) return -1 * at->second;
+	return no_relationship;
+}
+
+float GraphFork::get ( int i, int j ) const
+{
+	return get(i, j, KeyID());
+}
+
+// Undirected if undir == true. A KeyID the fork did not issue, such as
+// Graph::NO_KEY, sets nothing.
+void GraphFork::set ( int i, int j, const std::string& key, bool undir,
+	float x )
+{
+	set(i, j, intern(key), undir, x);
+}
+
+void GraphFork::set ( int i, int j, KeyID key, bool undir, float x )
+{
+	if ( key.id >= key_names.size() ) return;
+	
+	// check for no-relationship value
+	if ( fabs(x - no_relationship) < 0.0000001 ) {
+		clear(i, j, key, undir);
+		return;
+	}
+	
+	add_arc(i, j, key.id, x);
+	if ( undir ) add_arc(j, i, key.id, x);
+}
+
+void GraphFork::set ( int i, int j, const std::string& key, float x )
+{
+	set(i, j, key, !directed, x);
+}
+
+void GraphFork::set ( int i, int j, KeyID key, float x )
+{
+	set(i, j, key, !directed, x);
+}
+
+void GraphFork::set_dir ( int i, int j, const std::string& key, float x )
+{
+	set(i, j, key, false, x);
+}
+
+void GraphFork::set_dir ( int i, int j, KeyID key, float x )
+{
+	set(i, j, key, false, x);
+}
+
+void GraphFork::set_undir ( int i, int j, const std::string& key, float x )
+{
+	set(i, j, key, true, x);
+}
+
+void GraphFork::set_undir ( int i, int j, KeyID key, float x )
+{
+	set(i, j, key, true, x);
+}
+
+void GraphFork::set ( int i, int j, float x )
+{
+	set(i, j, KeyID(), !directed, x);
+}
+
+void GraphFork::set_dir ( int i, int j, float x )
+{
+	set(i, j, KeyID(), false, x);
+}
+
+void GraphFork::set_undir ( int i, int j, float x )
+{
+	set(i, j, KeyID(), true, x);
+}
+
+// Remove the relationship(s) between the given vertices.
+void GraphFork::clear_dir ( int i, int j )
+{
+	std::vector<unsigned int> ks = arc_keys(i, j, true);
+	for ( size_t k = 0; k < ks.size(); ++k ) remove_arc(i, j, ks[k]);
+}
+
+void GraphFork::clear_undir ( int i, int j )
+{
+	clear_dir(i, j);
+	clear_dir(j, i);
+}
+
+void GraphFork::clear ( int i, int j )
+{
+	if ( directed ) clear_dir(i, j);
+	else clear_undir(i, j);
+}
+
+void GraphFork::clear ( int i, int j, const std::string& key, bool undir )
+{
+	clear(i, j, key_id(key), undir);
+}
+
+void GraphFork::clear ( int i, int j, KeyID key, bool undir )
+{
+	remove_arc(i, j, key.id);
+	if ( undir ) remove_arc(j, i, key.id);
+}
+
+void GraphFork::clear_dir ( int i, int j, const std::string& key )
+{
+	clear(i, j, key, false);
+}
+
+void GraphFork::clear_dir ( int i, int j, KeyID key )
+{
+	clear(i, j, key, false);
+}
+
+void GraphFork::clear_undir ( int i, int j, const std::string& key )
+{
+	clear(i, j, key, true);
+}
+
+void GraphFork::clear_undir ( int i, int j, KeyID key )
+{
+	clear(i, j, key, true);
+}
+
+void GraphFork::clear ( int i, int j, const std::string& key )
+{
+	clear(i, j, key, !directed);
+}
+
+void GraphFork::clear ( int i, int j, KeyID key )
+{
+	clear(i, j, key, !directed);
+}
+
+// Remove relationships from vertex.
+void GraphFork::clear_dir ( int i, const std::string& key )
+{
+	clear_dir(i, key_id(key));
+}
+
+void GraphFork::clear_dir ( int i, KeyID key )
+{
+	std::set<int> N = nbrs(i, FROM, true, key.id);
+	std::set<int>::iterator it = N.begin();
+	for ( ; it != N.end(); ++it ) remove_arc(i, *it, key.id);
+}
+
+void GraphFork::clear_undir ( int i, const std::string& key )
+{
+	clear_undir(i, key_id(key));
+}
+
+void GraphFork::clear_undir ( int i, KeyID key )
+{
+	std::set<int> N = nbrs(i, UNDIRECTED, true, key.id);
+	std::set<int>::iterator it = N.begin();
+	for ( ; it != N.end(); ++it ) clear(i, *it, key, true);
+}
+
+void GraphFork::clear ( int i, const std::string& key )
+{
+	clear(i, key_id(key));
+}
+
+void GraphFork::clear ( int i, KeyID key )
+{
+	if ( directed ) clear_dir(i, key);
+	else clear_undir(i, key);
+}
+
+// Remove vertex.
+void GraphFork::clear ( int i )
+{
+	std::set<int> N = nbrs(i);
+	std::set<int>::iterator it = N.begin();
+	for ( ; it != N.end(); ++it ) clear_undir(i, *it);
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_GRAPHFORK_20261014
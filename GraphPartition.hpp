@@ -0,0 +1,444 @@
+/////////////////////////////////////////////////////////////////////
+// Vertex orders that keep neighbors close together, and k-way     //
+// partitions of a graph into shards for distributing it.          //
+//                                                                 //
+// An order lists every vertex of a graph once. Give it to         //
+// number_vertices(order) so that vectors indexed by the graph's   //
+// dense indices hold neighbors near each other. Orders and        //
+// partitions treat every relationship as going both ways, as      //
+// nbrs() does, and count a pair of neighbors once however many    //
+// keys join them.                                                 //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_GRAPHPARTITION_20261015
+#define YOUNG_GIS_GRAPHPARTITION_20261015
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+// The neighbors of every vertex of a graph, in CSR form: row r is the
+// r-th vertex in increasing order of ID, and its neighbors are rows
+// nbr[off[r]] .. nbr[off[r+1]-1], in increasing order.
+template <class Id>
+class Adjacency {
+public:
+	static const size_t NONE;
+	
+	std::vector<Id> ids;
+	std::vector<size_t> off;
+	std::vector<size_t> nbr;
+	
+	// constructors, destructor
+	template <class K, class W, class S>
+	explicit Adjacency ( const BasicGraph<Id,K,W,S>& );
+	~Adjacency ();
+	
+	// rows
+	size_t size () const;
+	size_t row ( Id ) const;
+	size_t degree ( size_t ) const;
+}; // Adjacency
+
+// One part of a partitioned graph: its vertices, those of them with a
+// neighbor in another shard, and the relationships with a vertex in
+// the shard (so a relationship the partition cuts is in both shards).
+template <class Id, class K, class W, class S>
+struct GraphShard {
+	std::vector<Id> vertices;
+	std::vector<Id> boundary;
+	BasicGraph<Id,K,W,S> graph;
+};
+
+// orders
+template <class Id, class K, class W, class S>
+std::vector<Id> degree_order ( const BasicGraph<Id,K,W,S>& );
+template <class Id, class K, class W, class S>
+std::vector<Id> bfs_order ( const BasicGraph<Id,K,W,S>& );
+template <class Id, class K, class W, class S>
+std::vector<Id> rcm_order ( const BasicGraph<Id,K,W,S>& );
+template <class Id, class K, class W, class S, class F>
+std::vector<Id> hilbert_order ( const BasicGraph<Id,K,W,S>&, F );
+
+// partitions
+template <class Id>
+std::vector<size_t> partition ( const Adjacency<Id>&, size_t,
+	double imbalance=0.03 );
+template <class Id, class K, class W, class S>
+std::vector<GraphShard<Id,K,W,S> > partition (
+	const BasicGraph<Id,K,W,S>&, size_t, double imbalance=0.03 );
+
+template <class Id>
+const size_t Adjacency<Id>::NONE = ~(size_t)0;
+
+
+// ADJACENCY ////////////////////////////////////////////////////////
+
+// List the neighbors of each vertex of g, other than itself.
+template <class Id>
+template <class K, class W, class S>
+Adjacency<Id>::Adjacency ( const BasicGraph<Id,K,W,S>& g )
+{
+	ids.reserve(g.size());
+	typename BasicGraph<Id,K,W,S>::VertexRange V = g.vertex_range();
+	typename BasicGraph<Id,K,W,S>::VertexIterator it = V.begin();
+	for ( ; it != V.end(); ++it ) ids.push_back(*it);
+	std::sort(ids.begin(), ids.end());     // HashedMaps have no order
+	
+	off.reserve(ids.size() + 1);
+	off.push_back(0);
+	for ( size_t r = 0; r < ids.size(); ++r ) {
+		size_t first = nbr.size();
+		g.for_each_nbr(ids[r], [&] ( Id j ) {
+			if ( j != ids[r] ) nbr.push_back(row(j));
+		});
+		std::sort(nbr.begin() + first, nbr.end());
+		off.push_back(nbr.size());
+	}
+}
+
+template <class Id>
+Adjacency<Id>::~Adjacency () {}
+
+// Get the number of rows (vertices).
+template <class Id>
+size_t Adjacency<Id>::size () const
+{
+	return ids.size();
+}
+
+// Get the row of vertex i, which must be in the graph.
+template <class Id>
+size_t Adjacency<Id>::row ( Id i ) const
+{
+	return std::lower_bound(ids.begin(), ids.end(), i) - ids.begin();
+}
+
+// Get the number of neighbors of row r.
+template <class Id>
+size_t Adjacency<Id>::degree ( size_t r ) const
+{
+	return off[r + 1] - off[r];
+}
+
+
+// ORDERS ///////////////////////////////////////////////////////////
+
+// Get the rows of A in breadth-first order, starting each component
+// from the first of starts that has not been reached, and taking the
+// new neighbors of each row in increasing order of degree if
+// by_degree (Cuthill-McKee order), or of ID otherwise.
+template <class Id>
+std::vector<size_t> breadth_first ( const Adjacency<Id>& A,
+	const std::vector<size_t>& starts, bool by_degree )
+{
+	std::vector<size_t> order;
+	order.reserve(A.size());
+	std::vector<bool> seen (A.size(), false);
+	for ( size_t s = 0; s < starts.size(); ++s ) {
+		if ( seen[starts[s]] ) continue;
+		seen[starts[s]] = true;
+		order.push_back(starts[s]);
+		for ( size_t h = order.size() - 1; h < order.size(); ++h ) {
+			size_t r = order[h];
+			size_t first = order.size();
+			for ( size_t e = A.off[r]; e < A.off[r + 1]; ++e ) {
+				if ( seen[A.nbr[e]] ) continue;
+				seen[A.nbr[e]] = true;
+				order.push_back(A.nbr[e]);
+			}
+			if ( by_degree )
+				std::stable_sort(order.begin() + first, order.end(),
+					[&] ( size_t a, size_t b )
+					{ return A.degree(a) < A.degree(b); });
+		}
+	}
+	return order;
+}
+
+// Get a row of s's component that is about as far from the rest as
+// any (a pseudo-peripheral row): search from s, move to the row of
+// least degree in the last level, and repeat while the levels grow
+// deeper. Marks the rows of the component done. level must be NONE
+// for every row, and is left so.
+template <class Id>
+size_t peripheral ( const Adjacency<Id>& A, size_t s,
+	std::vector<size_t>& level, std::vector<bool>& done )
+{
+	const size_t NONE = Adjacency<Id>::NONE;
+	std::vector<size_t> Q;
+	size_t depth = 0;
+	for ( size_t tries = 0; tries < 8; ++tries ) {
+		Q.assign(1, s);
+		level[s] = 0;
+		for ( size_t h = 0; h < Q.size(); ++h ) {
+			size_t r = Q[h];
+			for ( size_t e = A.off[r]; e < A.off[r + 1]; ++e ) {
+				if ( level[A.nbr[e]] != NONE ) continue;
+				level[A.nbr[e]] = level[r] + 1;
+				Q.push_back(A.nbr[e]);
+			}
+		}
+		
+		// the row of least degree in the last level
+		size_t d = level[Q.back()];
+		size_t far = Q.back();
+		for ( size_t q = Q.size(); q-- > 0 && level[Q[q]] == d; )
+			if ( A.degree(Q[q]) < A.degree(far) ) far = Q[q];
+		for ( size_t q = 0; q < Q.size(); ++q ) {
+			level[Q[q]] = NONE;
+			done[Q[q]] = true;
+		}
+		if ( tries > 0 && d <= depth ) break;
+		depth = d;
+		s = far;
+	}
+	return s;
+}
+
+// Get the rows of A in Cuthill-McKee order, each component starting
+// from a pseudo-peripheral row.
+template <class Id>
+std::vector<size_t> cuthill_mckee ( const Adjacency<Id>& A )
+{
+	std::vector<size_t> rows (A.size());
+	for ( size_t r = 0; r < rows.size(); ++r ) rows[r] = r;
+	std::stable_sort(rows.begin(), rows.end(), [&] ( size_t a, size_t b )
+		{ return A.degree(a) < A.degree(b); });
+	
+	std::vector<size_t> level (A.size(), Adjacency<Id>::NONE);
+	std::vector<bool> done (A.size(), false);
+	std::vector<size_t> starts;
+	for ( size_t n = 0; n < rows.size(); ++n )
+		if ( !done[rows[n]] )
+			starts.push_back(peripheral(A, rows[n], level, done));
+	return breadth_first(A, starts, true);
+}
+
+// Get the vertices of A, in the order of rows.
+template <class Id>
+std::vector<Id> vertices_of ( const Adjacency<Id>& A,
+	const std::vector<size_t>& rows )
+{
+	std::vector<Id> out (rows.size());
+	for ( size_t n = 0; n < rows.size(); ++n ) out[n] = A.ids[rows[n]];
+	return out;
+}
+
+// Get the vertices of g from most neighbors to fewest (by ID, among
+// vertices with as many), so that the hubs, which most searches
+// touch, share the first cache lines.
+template <class Id, class K, class W, class S>
+std::vector<Id> degree_order ( const BasicGraph<Id,K,W,S>& g )
+{
+	Adjacency<Id> A (g);
+	std::vector<size_t> rows (A.size());
+	for ( size_t r = 0; r < rows.size(); ++r ) rows[r] = r;
+	std::stable_sort(rows.begin(), rows.end(), [&] ( size_t a, size_t b )
+		{ return A.degree(a) > A.degree(b); });
+	return vertices_of(A, rows);
+}
+
+// Get the vertices of g in breadth-first order, starting each
+// component from its least vertex and taking neighbors by ID.
+template <class Id, class K, class W, class S>
+std::vector<Id> bfs_order ( const BasicGraph<Id,K,W,S>& g )
+{
+	Adjacency<Id> A (g);
+	std::vector<size_t> rows (A.size());
+	for ( size_t r = 0; r < rows.size(); ++r ) rows[r] = r;
+	return vertices_of(A, breadth_first(A, rows, false));
+}
+
+// Get the vertices of g in reverse Cuthill-McKee order, which keeps
+// the indices of neighbors close (a narrow band about the diagonal of
+// the adjacency matrix).
+template <class Id, class K, class W, class S>
+std::vector<Id> rcm_order ( const BasicGraph<Id,K,W,S>& g )
+{
+	Adjacency<Id> A (g);
+	std::vector<size_t> rows = cuthill_mckee(A);
+	std::reverse(rows.begin(), rows.end());
+	return vertices_of(A, rows);
+}
+
+// Get the distance of cell (x, y) along the Hilbert curve that fills
+// a grid of 2^16 by 2^16 cells.
+inline uint64_t hilbert_distance ( uint32_t x, uint32_t y )
+{
+	const uint32_t N = 1u << 16;
+	uint64_t d = 0;
+	for ( uint32_t s = N / 2; s > 0; s /= 2 ) {
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		d += (uint64_t)s * s * ((3 * rx) ^ ry);
+		
+		// rotate the quadrant so that the curve enters it at (0, 0)
+		if ( ry == 0 ) {
+			if ( rx == 1 ) {
+				x = N - 1 - x;
+				y = N - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+// Get the vertices of g along a Hilbert curve through their
+// locations, so that vertices near each other on the ground are near
+// each other in the order. xy(i) returns the location of vertex i as
+// a std::pair of coordinates; the curve is laid over their bounding
+// box on a grid of 2^16 by 2^16 cells, and vertices in one cell are
+// taken by ID.
+template <class Id, class K, class W, class S, class F>
+std::vector<Id> hilbert_order ( const BasicGraph<Id,K,W,S>& g, F xy )
+{
+	std::vector<Id> ids;
+	std::vector<std::pair<double, double> > p;
+	ids.reserve(g.size());
+	p.reserve(g.size());
+	typename BasicGraph<Id,K,W,S>::VertexRange V = g.vertex_range();
+	typename BasicGraph<Id,K,W,S>::VertexIterator it = V.begin();
+	for ( ; it != V.end(); ++it ) {
+		ids.push_back(*it);
+		p.push_back(xy(*it));
+	}
+	if ( ids.size() == 0 ) return ids;
+	
+	// bounding box
+	double x0 = p[0].first, x1 = x0, y0 = p[0].second, y1 = y0;
+	for ( size_t n = 1; n < p.size(); ++n ) {
+		x0 = std::min(x0, p[n].first);
+		x1 = std::max(x1, p[n].first);
+		y0 = std::min(y0, p[n].second);
+		y1 = std::max(y1, p[n].second);
+	}
+	
+	// cells, on one scale for both axes so that the curve is not
+	// stretched, and the vertices sorted by distance along it
+	double side = std::max(x1 - x0, y1 - y0);
+	double scale = side > 0 ? 65535 / side : 0;
+	std::vector<std::pair<uint64_t, Id> > D (ids.size());
+	for ( size_t n = 0; n < ids.size(); ++n ) {
+		uint32_t cx = (uint32_t)((p[n].first - x0) * scale);
+		uint32_t cy = (uint32_t)((p[n].second - y0) * scale);
+		D[n] = std::make_pair(hilbert_distance(cx, cy), ids[n]);
+	}
+	std::sort(D.begin(), D.end());
+	for ( size_t n = 0; n < D.size(); ++n ) ids[n] = D[n].second;
+	return ids;
+}
+
+
+// PARTITIONS ///////////////////////////////////////////////////////
+
+// Split the rows of A into k parts of about the same size, with few
+// pairs of neighbors in different parts, and return the part of each
+// row. No part has more than (1 + imbalance) times its share of the
+// rows. The parts start as runs of the Cuthill-McKee order, which
+// grows each part outward from the last; then each row on the edge of
+// a part moves to the neighboring part with the most of its
+// neighbors, if that cuts fewer pairs and the sizes allow it, until
+// no row moves (or for at most 16 passes).
+template <class Id>
+std::vector<size_t> partition ( const Adjacency<Id>& A, size_t k,
+	double imbalance )
+{
+	size_t n = A.size();
+	std::vector<size_t> part (n, 0);
+	if ( k <= 1 || n == 0 ) return part;
+	
+	std::vector<size_t> order = cuthill_mckee(A);
+	std::vector<size_t> size (k, 0);
+	for ( size_t p = 0; p < n; ++p ) {
+		part[order[p]] = p * k / n;
+		++size[p * k / n];
+	}
+	
+	// limits on the sizes of the parts
+	double share = (double)n / k;
+	size_t hi = std::max((size_t)std::ceil(share),
+		(size_t)(share * (1 + imbalance)));
+	size_t lo = std::min((size_t)share,
+		(size_t)std::ceil(share * (1 - imbalance)));
+	
+	// neighbors of a row in each part; only the parts in touched are
+	// nonzero
+	std::vector<size_t> near (k, 0);
+	std::vector<size_t> touched;
+	for ( size_t pass = 0; pass < 16; ++pass ) {
+		size_t moved = 0;
+		for ( size_t t = 0; t < n; ++t ) {
+			size_t r = order[t];
+			size_t p = part[r];
+			for ( size_t e = A.off[r]; e < A.off[r + 1]; ++e ) {
+				size_t q = part[A.nbr[e]];
+				if ( near[q]++ == 0 ) touched.push_back(q);
+			}
+			size_t best = p;
+			if ( size[p] > lo ) {
+				for ( size_t u = 0; u < touched.size(); ++u ) {
+					size_t q = touched[u];
+					if ( size[q] < hi && near[q] > near[best] ) best = q;
+				}
+			}
+			for ( size_t u = 0; u < touched.size(); ++u ) near[touched[u]] = 0;
+			touched.clear();
+			if ( best == p ) continue;
+			part[r] = best;
+			--size[p];
+			++size[best];
+			++moved;
+		}
+		if ( moved == 0 ) break;
+	}
+	return part;
+}
+
+// Split g into k shards of about the same number of vertices, with few
+// relationships between shards, as partition(Adjacency) does. Shard s
+// lists its vertices and its boundary vertices (those with a neighbor
+// in another shard) in increasing order, and holds the relationships
+// of g with a vertex in it, with g's keys, KeyIDs, and settings.
+// Copying the relationships takes a pass over g for each shard.
+template <class Id, class K, class W, class S>
+std::vector<GraphShard<Id,K,W,S> > partition (
+	const BasicGraph<Id,K,W,S>& g, size_t k, double imbalance )
+{
+	if ( k == 0 ) k = 1;
+	Adjacency<Id> A (g);
+	std::vector<size_t> part = partition(A, k, imbalance);
+	
+	std::vector<GraphShard<Id,K,W,S> > shards (k);
+	for ( size_t r = 0; r < A.size(); ++r ) {
+		GraphShard<Id,K,W,S>& H = shards[part[r]];
+		H.vertices.push_back(A.ids[r]);
+		for ( size_t e = A.off[r]; e < A.off[r + 1]; ++e ) {
+			if ( part[A.nbr[e]] == part[r] ) continue;
+			H.boundary.push_back(A.ids[r]);
+			break;
+		}
+	}
+	for ( size_t s = 0; s < k; ++s ) {
+		shards[s].graph = g.filter([&] ( Id i, Id j, KeyID, W ) {
+			return part[A.row(i)] == s || part[A.row(j)] == s;
+		});
+	}
+	return shards;
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_GRAPHPARTITION_20261015
@@ -0,0 +1,347 @@
+/////////////////////////////////////////////////////////////////////
+// Counters of a graph's hot operations, for finding out which of  //
+// them a program spends its time in: calls, misses, map nodes     //
+// allocated, and time, by public method (the overloads of a       //
+// method share its counts), and a hook that is called after each  //
+// operation to pass it on to a metrics or tracing system.         //
+//                                                                 //
+// Only compiled in when YOUNG_GIS_GRAPH_STATS is defined before   //
+// Graph.hpp is included (the same way in every file of a          //
+// program). Otherwise GraphStats holds nothing, always reads 0,   //
+// and the probes in the graph's methods are empty inline calls    //
+// that the compiler drops.                                        //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// 10/15/2026                                                      //
+// - counts by method, not by kind: nbrs, nbrs_to, and nbrs_from   //
+//   (and the contains, set, and clear variants) no longer share a //
+//   count. LOAD is now ASSIGN_EDGES and APPLY_EDGES.              //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_GRAPHSTATS_20261014
+#define YOUNG_GIS_GRAPHSTATS_20261014
+
+#include <functional>
+#include <stdint.h>
+#include "NodePool.hpp"
+
+#ifdef YOUNG_GIS_GRAPH_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace bygis { // Brennan Young GIS namespace
+
+class GraphStats {
+public:
+	// the counted methods, each named for the method of the graph
+	enum Op {
+		GET,
+		GET_BATCH,
+		CONTAINS,
+		CONTAINS_DIR,
+		CONTAINS_UNDIR,
+		CONTAINS_BATCH,
+		SET,
+		SET_DIR,
+		SET_UNDIR,
+		CLEAR,
+		CLEAR_DIR,
+		CLEAR_UNDIR,
+		NBRS,
+		NBRS_TO,
+		NBRS_FROM,
+		FOR_EACH_NBR,
+		FOR_EACH_NBR_TO,
+		FOR_EACH_NBR_FROM,
+		FOR_EACH_NBR_INDEX,
+		FOR_EACH_NBR_TO_INDEX,
+		FOR_EACH_NBR_FROM_INDEX,
+		ASSIGN_EDGES,
+		APPLY_EDGES,
+		NUM_OPS
+	};
+	
+	// called with the method, whether it missed, and the
+	// time it took in nanoseconds
+	typedef std::function<void (Op, bool, uint64_t)> Hook;
+	
+	static const bool ENABLED;
+	static const char* name ( Op );
+private:
+#ifdef YOUNG_GIS_GRAPH_STATS
+	typedef std::atomic<uint64_t> Counter;
+	Counter n_calls[NUM_OPS], n_misses[NUM_OPS];
+	Counter n_nodes[NUM_OPS], n_nanos[NUM_OPS];
+	Counter n_epsilon_clears, n_back_links;
+	Hook hook_f;
+#endif
+	friend class GraphProbe;
+	void record ( Op, bool, uint64_t, uint64_t );
+	void count_epsilon_clear ();
+	void count_back_link ();
+public:
+	// constructors, destructor
+	GraphStats ();
+	GraphStats ( const GraphStats& );
+	GraphStats& operator= ( const GraphStats& );
+	~GraphStats ();
+	
+	// counts, by method
+	uint64_t calls ( Op ) const;
+	uint64_t misses ( Op ) const;
+	uint64_t nodes ( Op ) const;
+	uint64_t nanoseconds ( Op ) const;
+	
+	// events within set
+	uint64_t epsilon_clears () const;
+	uint64_t back_links () const;
+	
+	// operations
+	void reset ();
+	void hook ( Hook );
+}; // GraphStats
+
+// Records one operation of a graph from its construction to its
+// destruction. Only the outermost operation of a thread is recorded,
+// so a method that calls others (set calling clear_dir, say) counts
+// once, with all of its time, under the method that was called.
+class GraphProbe {
+#ifdef YOUNG_GIS_GRAPH_STATS
+private:
+	GraphStats* s;
+	const NodePool* pool;
+	GraphStats::Op op;
+	bool outer, missed;
+	size_t nodes;
+	std::chrono::steady_clock::time_point start;
+	
+	static int& depth ();
+	
+	GraphProbe ( const GraphProbe& );
+	GraphProbe& operator= ( const GraphProbe& );
+public:
+	GraphProbe ( GraphStats*, GraphStats::Op, const NodePool* );
+	~GraphProbe ();
+	
+	template <class T> T miss ( T );
+	bool result ( bool );
+	void epsilon_clear ();
+	void back_link ();
+#else
+public:
+	GraphProbe ( GraphStats*, GraphStats::Op, const NodePool* ) {}
+	
+	template <class T> T miss ( T x ) { return x; }
+	bool result ( bool b ) { return b; }
+	void epsilon_clear () {}
+	void back_link () {}
+#endif
+}; // GraphProbe
+
+
+// GRAPHSTATS ///////////////////////////////////////////////////////
+
+#ifdef YOUNG_GIS_GRAPH_STATS
+const bool GraphStats::ENABLED = true;
+#else
+const bool GraphStats::ENABLED = false;
+#endif
+
+// Get the name of the method counted by op, as "nbrs_to".
+const char* GraphStats::name ( Op op )
+{
+	static const char* names[NUM_OPS + 1] = {
+		"get", "get_batch",
+		"contains", "contains_dir", "contains_undir", "contains_batch",
+		"set", "set_dir", "set_undir",
+		"clear", "clear_dir", "clear_undir",
+		"nbrs", "nbrs_to", "nbrs_from",
+		"for_each_nbr", "for_each_nbr_to", "for_each_nbr_from",
+		"for_each_nbr_index", "for_each_nbr_to_index",
+		"for_each_nbr_from_index",
+		"assign_edges", "apply_edges", "" };
+	return names[op < NUM_OPS ? op : NUM_OPS];
+}
+
+GraphStats::GraphStats ()
+{
+	reset();
+}
+
+// A copy starts with no counts and no hook: they describe what was
+// done to a graph, not its contents.
+GraphStats::GraphStats ( const GraphStats& )
+{
+	reset();
+}
+
+GraphStats& GraphStats::operator= ( const GraphStats& )
+{
+	return *this;
+}
+
+GraphStats::~GraphStats () {}
+
+#ifdef YOUNG_GIS_GRAPH_STATS
+
+uint64_t GraphStats::calls ( Op op ) const
+{
+	return n_calls[op].load(std::memory_order_relaxed);
+}
+
+// Calls that found no relationship or vertex: a get that returned
+// no_relationship, or a contains that returned false.
+uint64_t GraphStats::misses ( Op op ) const
+{
+	return n_misses[op].load(std::memory_order_relaxed);
+}
+
+// Map nodes drawn from the graph's pool.
+uint64_t GraphStats::nodes ( Op op ) const
+{
+	return n_nodes[op].load(std::memory_order_relaxed);
+}
+
+uint64_t GraphStats::nanoseconds ( Op op ) const
+{
+	return n_nanos[op].load(std::memory_order_relaxed);
+}
+
+// Calls to set with a value within 0.0000001 of no_relationship, which
+// clear the relationship instead.
+uint64_t GraphStats::epsilon_clears () const
+{
+	return n_epsilon_clears.load(std::memory_order_relaxed);
+}
+
+// Back-links written by directed calls to set.
+uint64_t GraphStats::back_links () const
+{
+	return n_back_links.load(std::memory_order_relaxed);
+}
+
+// Set every count to 0. The hook is kept.
+void GraphStats::reset ()
+{
+	for ( int op = 0; op < NUM_OPS; ++op ) {
+		n_calls[op].store(0, std::memory_order_relaxed);
+		n_misses[op].store(0, std::memory_order_relaxed);
+		n_nodes[op].store(0, std::memory_order_relaxed);
+		n_nanos[op].store(0, std::memory_order_relaxed);
+	}
+	n_epsilon_clears.store(0, std::memory_order_relaxed);
+	n_back_links.store(0, std::memory_order_relaxed);
+}
+
+// Call f after each operation that is recorded, or no function if f
+// is empty. f is called in the thread of the operation, so it must be
+// safe to call from every thread that reads the graph. Not to be
+// changed while the graph is in use.
+void GraphStats::hook ( Hook f )
+{
+	hook_f = f;
+}
+
+void GraphStats::record ( Op op, bool missed, uint64_t nodes,
+	uint64_t nanos )
+{
+	n_calls[op].fetch_add(1, std::memory_order_relaxed);
+	if ( missed ) n_misses[op].fetch_add(1, std::memory_order_relaxed);
+	n_nodes[op].fetch_add(nodes, std::memory_order_relaxed);
+	n_nanos[op].fetch_add(nanos, std::memory_order_relaxed);
+	if ( hook_f ) hook_f(op, missed, nanos);
+}
+
+void GraphStats::count_epsilon_clear ()
+{
+	n_epsilon_clears.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GraphStats::count_back_link ()
+{
+	n_back_links.fetch_add(1, std::memory_order_relaxed);
+}
+
+#else
+
+uint64_t GraphStats::calls ( Op ) const { return 0; }
+uint64_t GraphStats::misses ( Op ) const { return 0; }
+uint64_t GraphStats::nodes ( Op ) const { return 0; }
+uint64_t GraphStats::nanoseconds ( Op ) const { return 0; }
+uint64_t GraphStats::epsilon_clears () const { return 0; }
+uint64_t GraphStats::back_links () const { return 0; }
+void GraphStats::reset () {}
+void GraphStats::hook ( Hook ) {}
+void GraphStats::record ( Op, bool, uint64_t, uint64_t ) {}
+void GraphStats::count_epsilon_clear () {}
+void GraphStats::count_back_link () {}
+
+#endif
+
+
+// GRAPHPROBE ///////////////////////////////////////////////////////
+
+#ifdef YOUNG_GIS_GRAPH_STATS
+
+// Number of operations under way in this thread.
+int& GraphProbe::depth ()
+{
+	static thread_local int d = 0;
+	return d;
+}
+
+// Start recording an operation into stats, which may be null, counting
+// the nodes drawn from pool, which may also be null.
+GraphProbe::GraphProbe ( GraphStats* stats, GraphStats::Op o,
+	const NodePool* p )
+: s(stats), pool(p), op(o), outer(depth()++ == 0), missed(false),
+  nodes(p ? p->allocations() : 0)
+{
+	if ( outer && s ) start = std::chrono::steady_clock::now();
+}
+
+GraphProbe::~GraphProbe ()
+{
+	--depth();
+	if ( !outer || !s ) return;
+	std::chrono::nanoseconds t = std::chrono::duration_cast<
+		std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	size_t n = pool ? pool->allocations() - nodes : 0;
+	s->record(op, missed, n, t.count());
+}
+
+// Mark the operation as a miss, returning x.
+template <class T>
+T GraphProbe::miss ( T x )
+{
+	missed = true;
+	return x;
+}
+
+// Mark the operation as a miss if b is false, returning b.
+bool GraphProbe::result ( bool b )
+{
+	if ( !b ) missed = true;
+	return b;
+}
+
+void GraphProbe::epsilon_clear ()
+{
+	if ( s ) s->count_epsilon_clear();
+}
+
+void GraphProbe::back_link ()
+{
+	if ( s ) s->count_back_link();
+}
+
+#endif
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_GRAPHSTATS_20261014
@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////////////
+// Memory pool for the nodes of node-based containers, and an      //
+// allocator that draws from it. Nodes are carved from large       //
+// blocks by bumping a pointer, freed nodes are kept on per-size   //
+// free lists for reuse, and the blocks are only returned to the   //
+// system when the pool is released or destroyed.                  //
+//                                                                 //
+// A pool is not thread-safe; share one only between containers    //
+// that are used from one thread at a time.                        //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// - counts allocations for GraphStats (GraphStats.hpp).           //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_NODEPOOL_20261014
+#define YOUNG_GIS_NODEPOOL_20261014
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace bygis { // Brennan Young GIS namespace
+
+class NodePool {
+private:
+	static const size_t ALIGN;        // alignment of every node
+	static const size_t MAX_NODE;     // larger requests use new
+	static const size_t FIRST_BLOCK;  // bytes in the first block
+	static const size_t MAX_BLOCK;    // blocks stop growing here
+	
+	struct Free { Free* next; };
+	
+	std::vector<char*> blocks;
+	std::vector<Free*> free_lists;    // by size class
+	char* cursor;                     // unused part of the last block
+	char* limit;
+	size_t next_block;
+	size_t reserved;                  // bytes held in blocks
+	size_t live;                      // nodes handed out
+#ifdef YOUNG_GIS_GRAPH_STATS
+	size_t made;                      // nodes ever handed out
+#endif
+
+	NodePool ( const NodePool& );
+	NodePool& operator= ( const NodePool& );
+	
+	void grow ();
+public:
+	// constructors, destructor
+	NodePool ();
+	~NodePool ();
+	
+	// operations
+	void* allocate ( size_t );
+	void deallocate ( void*, size_t );
+	bool release ();
+	size_t capacity () const;
+	size_t size () const;
+#ifdef YOUNG_GIS_GRAPH_STATS
+	size_t allocations () const;
+#endif
+}; // NodePool
+
+const size_t NodePool::ALIGN = 16;
+const size_t NodePool::MAX_NODE = 256;
+const size_t NodePool::FIRST_BLOCK = 1 << 16;
+const size_t NodePool::MAX_BLOCK = 1 << 22;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+NodePool::NodePool ()
+: free_lists(MAX_NODE / ALIGN + 1, 0), cursor(0), limit(0),
+  next_block(FIRST_BLOCK), reserved(0), live(0)
+#ifdef YOUNG_GIS_GRAPH_STATS
+  , made(0)
+#endif
+{}
+
+NodePool::~NodePool ()
+{
+	for ( size_t b = 0; b < blocks.size(); ++b )
+		::operator delete(blocks[b]);
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Start a new block, twice the size of the last one up to MAX_BLOCK.
+// Whatever was left of the last block is abandoned.
+void NodePool::grow ()
+{
+	char* b = static_cast<char*>(::operator new(next_block));
+	blocks.push_back(b);
+	cursor = b;
+	limit = b + next_block;
+	reserved += next_block;
+	if ( next_block < MAX_BLOCK ) next_block *= 2;
+}
+
+// Get memory for a node of the given size.
+void* NodePool::allocate ( size_t bytes )
+{
+	if ( bytes > MAX_NODE ) return ::operator new(bytes);
+	size_t c = (bytes + ALIGN - 1) / ALIGN;
+	++live;
+#ifdef YOUNG_GIS_GRAPH_STATS
+	++made;
+#endif
+
+	// reuse a freed node
+	Free* f = free_lists[c];
+	if ( f != 0 ) {
+		free_lists[c] = f->next;
+		return f;
+	}
+	
+	// or carve out a new one
+	size_t n = c * ALIGN;
+	if ( cursor == 0 || (size_t)(limit - cursor) < n ) grow();
+	void* p = cursor;
+	cursor += n;
+	return p;
+}
+
+// Return a node to the pool; bytes must be as given to allocate.
+void NodePool::deallocate ( void* p, size_t bytes )
+{
+	if ( bytes > MAX_NODE ) {
+		::operator delete(p);
+		return;
+	}
+	size_t c = (bytes + ALIGN - 1) / ALIGN;
+	Free* f = static_cast<Free*>(p);
+	f->next = free_lists[c];
+	free_lists[c] = f;
+	--live;
+}
+
+// Return every block to the system. Only possible when no node is in
+// use; returns false (and does nothing) otherwise.
+bool NodePool::release ()
+{
+	if ( live > 0 ) return false;
+	for ( size_t b = 0; b < blocks.size(); ++b )
+		::operator delete(blocks[b]);
+	blocks.clear();
+	free_lists.assign(free_lists.size(), 0);
+	cursor = limit = 0;
+	next_block = FIRST_BLOCK;
+	reserved = 0;
+	return true;
+}
+
+// Get the number of bytes the pool holds in blocks.
+size_t NodePool::capacity () const
+{
+	return reserved;
+}
+
+// Get the number of nodes in use.
+size_t NodePool::size () const
+{
+	return live;
+}
+
+#ifdef YOUNG_GIS_GRAPH_STATS
+// Get the number of nodes handed out since the pool was made, for
+// GraphStats (GraphStats.hpp). Not reset by release.
+size_t NodePool::allocations () const
+{
+	return made;
+}
+#endif
+
+
+// ALLOCATOR ////////////////////////////////////////////////////////
+
+// Allocator drawing from a NodePool, or from new/delete if it has no
+// pool. Containers keep their pool when copy-assigned and take the
+// other's when move-assigned or swapped.
+template <class T>
+class PoolAllocator {
+public:
+	typedef T value_type;
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+	
+	NodePool* pool;
+	
+	PoolAllocator () : pool(0) {}
+	explicit PoolAllocator ( NodePool* p ) : pool(p) {}
+	template <class U>
+	PoolAllocator ( const PoolAllocator<U>& a ) : pool(a.pool) {}
+	
+	T* allocate ( size_t n )
+	{
+		if ( pool == 0 )
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		return static_cast<T*>(pool->allocate(n * sizeof(T)));
+	}
+	
+	void deallocate ( T* p, size_t n )
+	{
+		if ( pool == 0 ) ::operator delete(p);
+		else pool->deallocate(p, n * sizeof(T));
+	}
+}; // PoolAllocator
+
+template <class T, class U>
+bool operator== ( const PoolAllocator<T>& a, const PoolAllocator<U>& b )
+{
+	return a.pool == b.pool;
+}
+
+template <class T, class U>
+bool operator!= ( const PoolAllocator<T>& a, const PoolAllocator<U>& b )
+{
+	return a.pool != b.pool;
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_NODEPOOL_20261014
@@ -0,0 +1,962 @@
+/////////////////////////////////////////////////////////////////////
+// Read-only graph served from a file too large to hold in memory. //
+// The file is split into blocks of consecutive vertices, each a   //
+// small CSR image of the relationships of its vertices, and a     //
+// query reads the one block that holds its vertex. Blocks that    //
+// have been read are kept in a cache of bounded size, and the     //
+// least recently used ones are dropped to make room. Queries have //
+// the same meaning as on the Graph the file was written from.     //
+//                                                                 //
+// The streaming visitors read every block in order without going  //
+// through the cache, so a pass over the whole graph takes the     //
+// memory of one block.                                            //
+//                                                                 //
+// Files are written from a CsrGraph, which may itself be mapped   //
+// from its own file. Any number of threads may query a PagedGraph //
+// at once; they take turns reading blocks.                        //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - each block is checked when it is read, and not used if it     //
+//   does not hold what its index entry says.                      //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- FILE FORMAT (VERSION 1) ------------------------------------ //
+// Values are in the writer's byte order, which is recorded so     //
+// that a reader with another order rejects the file. Sections     //
+// and blocks start on 8-byte boundaries.                          //
+//                                                                 //
+//   header     Header, below                                      //
+//   blocks     one after another, at the offsets in the index     //
+//   index      Entry[blocks], in increasing order of first vertex //
+//   key_off    uint64[keys+1], key k is chars [off[k], off[k+1])  //
+//   key_chars  char[key_off[keys]]                                //
+//                                                                 //
+// A block of r rows, o relationships from them, and q toward      //
+// them, with section offsets from the start of the block:         //
+//                                                                 //
+//   ids        int32[r], sorted vertex IDs                        //
+//   out_off    uint64[r+1], row s is [out_off[s], out_off[s+1])   //
+//   out_nbr    int32[o], vertex the relationship points toward    //
+//   out_key    uint32[o], key ID                                  //
+//   out_val    float[o], value                                    //
+//   in_off     uint64[r+1]                                        //
+//   in_nbr     int32[q], vertex the relationship points from      //
+//   in_key     uint32[q]                                          //
+//   in_val     float[q]                                           //
+//                                                                 //
+// As in a CsrGraph file, but neighbors are vertex IDs, so that a  //
+// row is read without reading the block of each neighbor. Rows    //
+// are sorted by (nbr, key).                                       //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_PAGEDGRAPH_20261015
+#define YOUNG_GIS_PAGEDGRAPH_20261015
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+class PagedGraph {
+private:
+	static const char MAGIC[8];
+	static const uint32_t VERSION;
+	static const uint32_t ORDER;
+	static const unsigned char UNDIRECTED;
+	static const unsigned char FROM;
+	static const unsigned char TO;
+	static const size_t NO_BLOCK;
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t order;             // ORDER, as written
+		uint32_t directed;
+		float no_relationship;
+		uint64_t n, m, keys, blocks;
+		uint64_t index, key_off, key_chars;
+		uint64_t bytes;             // size of the whole file
+	};
+
+	// where a block is: its first vertex, its number of rows and of
+	// relationships from (out) and toward (in) them, and its offset
+	struct Entry {
+		int32_t first;
+		uint32_t rows;
+		uint64_t out, in;
+		uint64_t at;
+	};
+
+	// a block read into memory, with views into it
+	struct Block {
+		std::vector<uint64_t> words;
+		size_t rows;
+		const int32_t* ids;
+		const uint64_t* out_off;
+		const int32_t* out_nbr;
+		const uint32_t* out_key;
+		const float* out_val;
+		const uint64_t* in_off;
+		const int32_t* in_nbr;
+		const uint32_t* in_key;
+		const float* in_val;
+
+		size_t bytes () const { return 8 * words.size(); }
+	};
+	typedef std::shared_ptr<const Block> Page;
+
+	// a cached block, and its place in the order of use
+	struct Cached {
+		Page page;
+		std::list<size_t>::iterator use;
+	};
+
+	PagedGraph ( const PagedGraph& );
+	PagedGraph& operator= ( const PagedGraph& );
+
+	FILE* file;
+	std::vector<Entry> index;
+	std::vector<std::string> key_names;
+	size_t n, m;
+
+	// the cache, and the file, are only used with the lock held
+	mutable std::mutex lock;
+	mutable std::map<size_t, Cached> cache;
+	mutable std::list<size_t> uses;  // blocks, most recently used first
+	mutable size_t cached;           // bytes in the cache
+	mutable size_t reads;            // blocks read from the file
+	size_t budget;                   // bytes the cache may hold
+
+	static uint64_t layout ( uint64_t, uint64_t, uint64_t, uint64_t* );
+	static bool seek ( FILE*, uint64_t );
+	Page read ( size_t ) const;
+	bool valid ( size_t, const Block& ) const;
+	bool valid ( size_t, uint64_t, const uint64_t*, const int32_t*,
+		const uint32_t* ) const;
+	Page page ( size_t ) const;
+	size_t block_of ( int ) const;
+	Page row ( int, size_t& ) const;
+	static size_t find ( const int32_t*, const uint32_t*, size_t, size_t,
+		int32_t, uint32_t );
+	std::set<int> nbrs ( int, unsigned char, bool, unsigned int ) const;
+public:
+	bool directed;
+	float no_relationship;
+
+	// constructors, destructor
+	PagedGraph ();
+	~PagedGraph ();
+
+	// files and cache
+	static bool write ( const CsrGraph&, const std::string&,
+		size_t block_rows=256 );
+	bool open ( const std::string& );
+	void set_cache_bytes ( size_t );
+	size_t cache_bytes () const;
+	size_t cached_bytes () const;
+	size_t num_blocks () const;
+	size_t blocks_read () const;
+
+	// keys
+	KeyID key_id ( const std::string& ) const;
+	const std::string& key_name ( KeyID ) const;
+	size_t num_keys () const;
+
+	// operations, as on Graph
+	size_t size () const;
+	size_t num_edges () const;
+	std::set<int> nbrs ( int, const std::string& ) const;
+	std::set<int> nbrs ( int, KeyID ) const;
+	std::set<int> nbrs ( int ) const;
+	std::set<int> nbrs_to ( int, const std::string& ) const;
+	std::set<int> nbrs_to ( int, KeyID ) const;
+	std::set<int> nbrs_to ( int ) const;
+	std::set<int> nbrs_from ( int, const std::string& ) const;
+	std::set<int> nbrs_from ( int, KeyID ) const;
+	std::set<int> nbrs_from ( int ) const;
+	std::set<int> vertices () const;
+	std::set<std::string> keys () const;
+	std::set<std::string> keys ( int ) const;
+	std::set<std::string> keys ( int, int ) const;
+	bool contains ( int, int, const std::string&, bool ) const;
+	bool contains ( int, int, KeyID, bool ) const;
+	bool contains_dir ( int, int, const std::string& ) const;
+	bool contains_dir ( int, int, KeyID ) const;
+	bool contains_undir ( int, int, const std::string& ) const;
+	bool contains_undir ( int, int, KeyID ) const;
+	bool contains ( int, int, const std::string& ) const;
+	bool contains ( int, int, KeyID ) const;
+	bool contains_dir ( int, int ) const;
+	bool contains_undir ( int, int ) const;
+	bool contains ( int, int ) const;
+	bool contains_dir ( int ) const;
+	bool contains_undir ( int ) const;
+	bool contains ( int ) const;
+	float get ( int, int, const std::string& ) const;
+	float get ( int, int, KeyID ) const;
+	float get ( int, int ) const;
+
+	// streaming
+	template <class F> F for_each_edge ( F ) const;
+	template <class F> F for_each_edge ( const std::string&, F ) const;
+	template <class F> F for_each_edge ( KeyID, F ) const;
+}; // PagedGraph
+
+const char PagedGraph::MAGIC[8] = { 'B','Y','G','I','S','P','A','G' };
+const uint32_t PagedGraph::VERSION = 1;
+const uint32_t PagedGraph::ORDER = 0x01020304;
+const unsigned char PagedGraph::UNDIRECTED = 0;
+const unsigned char PagedGraph::FROM = 1;
+const unsigned char PagedGraph::TO = 2;
+const size_t PagedGraph::NO_BLOCK = ~(size_t)0;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Start with an empty graph and a cache of 64 MB.
+PagedGraph::PagedGraph ()
+: file(0), n(0), m(0), cached(0), reads(0), budget(64 << 20),
+  directed(true), no_relationship(0)
+{
+	key_names.push_back(std::string());
+}
+
+PagedGraph::~PagedGraph ()
+{
+	if ( file != 0 ) fclose(file);
+}
+
+
+// BLOCKS ///////////////////////////////////////////////////////////
+
+// Set the section offsets of a block of the given numbers of rows and
+// relationships out and in, as ids, out_off, out_nbr, out_key, out_val,
+// in_off, in_nbr, in_key, in_val. Returns the size of the block.
+uint64_t PagedGraph::layout ( uint64_t rows, uint64_t out, uint64_t in,
+	uint64_t* section )
+{
+	uint64_t bytes[] = { 4 * rows, 8 * (rows + 1), 4 * out, 4 * out,
+		4 * out, 8 * (rows + 1), 4 * in, 4 * in, 4 * in };
+	uint64_t at = 0;
+	for ( size_t s = 0; s < 9; ++s ) {
+		section[s] = at;
+		at = (at + bytes[s] + 7) / 8 * 8;
+	}
+	return at;
+}
+
+// Move to a byte offset in a file, which may be past 2 GB.
+bool PagedGraph::seek ( FILE* f, uint64_t at )
+{
+#ifdef _WIN32
+	return _fseeki64(f, (__int64)at, SEEK_SET) == 0;
+#else
+	return fseeko(f, (off_t)at, SEEK_SET) == 0;
+#endif
+}
+
+// Read block b from the file, or return null if it cannot be read or
+// is not valid. The lock must be held.
+PagedGraph::Page PagedGraph::read ( size_t b ) const
+{
+	const Entry& e = index[b];
+	uint64_t s[9];
+	uint64_t bytes = layout(e.rows, e.out, e.in, s);
+	std::shared_ptr<Block> B (new Block);
+	B->words.resize(bytes / 8);
+	if ( !seek(file, e.at) || (bytes > 0
+			&& fread(B->words.data(), bytes, 1, file) != 1) )
+		return Page();
+	++reads;
+
+	const char* p = (const char*)B->words.data();
+	B->rows = e.rows;
+	B->ids = (const int32_t*)(p + s[0]);
+	B->out_off = (const uint64_t*)(p + s[1]);
+	B->out_nbr = (const int32_t*)(p + s[2]);
+	B->out_key = (const uint32_t*)(p + s[3]);
+	B->out_val = (const float*)(p + s[4]);
+	B->in_off = (const uint64_t*)(p + s[5]);
+	B->in_nbr = (const int32_t*)(p + s[6]);
+	B->in_key = (const uint32_t*)(p + s[7]);
+	B->in_val = (const float*)(p + s[8]);
+	if ( !valid(b, *B) ) return Page();
+	return B;
+}
+
+// True if B, read for block b, holds what the index says: IDs sorted
+// from the block's first vertex to below the next block's, and
+// relationships as valid() below. The queries rely on these without
+// checking them.
+bool PagedGraph::valid ( size_t b, const Block& B ) const
+{
+	const Entry& e = index[b];
+	if ( B.ids[0] != e.first ) return false;
+	for ( size_t r = 1; r < B.rows; ++r )
+		if ( B.ids[r] <= B.ids[r - 1] ) return false;
+	if ( b + 1 < index.size() && B.ids[B.rows - 1] >= index[b + 1].first )
+		return false;
+	return valid(B.rows, e.out, B.out_off, B.out_nbr, B.out_key)
+		&& valid(B.rows, e.in, B.in_off, B.in_nbr, B.in_key);
+}
+
+// True if the offsets of rows rows run from 0 to edges without going
+// back, and each row is sorted by (nbr, key), with keys the graph has.
+bool PagedGraph::valid ( size_t rows, uint64_t edges, const uint64_t* off,
+	const int32_t* nbr, const uint32_t* key ) const
+{
+	if ( off[0] != 0 || off[rows] != edges ) return false;
+	for ( size_t r = 0; r < rows; ++r )
+		if ( off[r + 1] < off[r] ) return false;
+	for ( size_t r = 0; r < rows; ++r ) {
+		for ( uint64_t e = off[r]; e < off[r + 1]; ++e ) {
+			if ( key[e] >= key_names.size() ) return false;
+			if ( e > off[r] && (nbr[e] < nbr[e - 1]
+					|| (nbr[e] == nbr[e - 1] && key[e] <= key[e - 1])) )
+				return false;
+		}
+	}
+	return true;
+}
+
+// Get block b from the cache, reading it if it is not there, and
+// dropping the least recently used blocks while the cache holds more
+// than its budget (short of the block just read). A dropped block
+// stays valid for queries still holding it.
+PagedGraph::Page PagedGraph::page ( size_t b ) const
+{
+	std::lock_guard<std::mutex> l (lock);
+	std::map<size_t, Cached>::iterator it = cache.find(b);
+	if ( it != cache.end() ) {
+		uses.splice(uses.begin(), uses, it->second.use);
+		return it->second.page;
+	}
+
+	Page p = read(b);
+	if ( !p ) return p;
+	uses.push_front(b);
+	Cached c = { p, uses.begin() };
+	cache.insert(std::make_pair(b, c));
+	cached += p->bytes();
+	while ( cached > budget && uses.size() > 1 ) {
+		it = cache.find(uses.back());
+		cached -= it->second.page->bytes();
+		cache.erase(it);
+		uses.pop_back();
+	}
+	return p;
+}
+
+// Get the block whose vertices would include i, or NO_BLOCK.
+size_t PagedGraph::block_of ( int i ) const
+{
+	size_t lo = 0, hi = index.size();
+	while ( lo < hi ) {
+		size_t mid = (lo + hi) / 2;
+		if ( index[mid].first <= i ) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo == 0 ? NO_BLOCK : lo - 1;
+}
+
+// Get the block of vertex i, and set r to its row in the block, or
+// return null if i is not in the graph.
+PagedGraph::Page PagedGraph::row ( int i, size_t& r ) const
+{
+	size_t b = block_of(i);
+	if ( b == NO_BLOCK ) return Page();
+	Page p = page(b);
+	if ( !p ) return p;
+	const int32_t* it = std::lower_bound(p->ids, p->ids + p->rows, i);
+	if ( it == p->ids + p->rows || *it != i ) return Page();
+	r = it - p->ids;
+	return p;
+}
+
+// Find the (j, k) relationship in [a, b) of the given arrays, or
+// NO_BLOCK.
+size_t PagedGraph::find ( const int32_t* nbr, const uint32_t* key,
+	size_t a, size_t b, int32_t j, uint32_t k )
+{
+	size_t e = std::lower_bound(nbr + a, nbr + b, j) - nbr;
+	for ( ; e < b && nbr[e] == j; ++e ) {
+		if ( key[e] == k ) return e;
+		if ( key[e] > k ) break;
+	}
+	return NO_BLOCK;
+}
+
+
+// FILES AND CACHE //////////////////////////////////////////////////
+
+// Write a snapshot to a file in blocks of block_rows vertices. The
+// snapshot is read one block at a time, so it may be mapped from its
+// own file (CsrGraph::map) rather than held in memory. Returns false
+// if the file could not be written.
+bool PagedGraph::write ( const CsrGraph& c, const std::string& path,
+	size_t block_rows )
+{
+	if ( block_rows == 0 ) block_rows = 1;
+	FILE* f = fopen(path.c_str(), "wb");
+	if ( f == 0 ) return false;
+
+	Header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, MAGIC, sizeof(h.magic));
+	h.version = VERSION;
+	h.order = ORDER;
+	h.directed = c.directed;
+	h.no_relationship = c.no_relationship;
+	h.n = c.size();
+	h.m = c.num_out();
+	h.keys = c.num_keys();
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+	// blocks
+	std::vector<Entry> E;
+	std::vector<uint64_t> words;
+	uint64_t at = sizeof(Header);
+	for ( size_t r0 = 0; ok && r0 < c.size(); r0 += block_rows ) {
+		size_t r1 = std::min(c.size(), r0 + block_rows);
+		Entry e;
+		e.first = c.vertex(r0);
+		e.rows = r1 - r0;
+		e.out = c.out_begin(r1) - c.out_begin(r0);
+		e.in = c.in_begin(r1) - c.in_begin(r0);
+		e.at = at;
+		uint64_t s[9];
+		uint64_t bytes = layout(e.rows, e.out, e.in, s);
+		words.assign(bytes / 8, 0);
+		char* p = (char*)words.data();
+		int32_t* ids = (int32_t*)(p + s[0]);
+		uint64_t* o_off = (uint64_t*)(p + s[1]);
+		int32_t* o_nbr = (int32_t*)(p + s[2]);
+		uint32_t* o_key = (uint32_t*)(p + s[3]);
+		float* o_val = (float*)(p + s[4]);
+		uint64_t* i_off = (uint64_t*)(p + s[5]);
+		int32_t* i_nbr = (int32_t*)(p + s[6]);
+		uint32_t* i_key = (uint32_t*)(p + s[7]);
+		float* i_val = (float*)(p + s[8]);
+		size_t o0 = c.out_begin(r0), i0 = c.in_begin(r0);
+		for ( size_t r = r0; r < r1; ++r ) {
+			ids[r - r0] = c.vertex(r);
+			o_off[r - r0 + 1] = c.out_end(r) - o0;
+			i_off[r - r0 + 1] = c.in_end(r) - i0;
+		}
+		for ( size_t x = o0; x < o0 + e.out; ++x ) {
+			o_nbr[x - o0] = c.vertex(c.out_nbr(x));
+			o_key[x - o0] = c.out_key(x).id;
+			o_val[x - o0] = c.out_val(x);
+		}
+		for ( size_t x = i0; x < i0 + e.in; ++x ) {
+			i_nbr[x - i0] = c.vertex(c.in_nbr(x));
+			i_key[x - i0] = c.in_key(x).id;
+			i_val[x - i0] = c.in_val(x);
+		}
+		ok = fwrite(p, bytes, 1, f) == 1;
+		at += bytes;
+		E.push_back(e);
+	}
+
+	// index and keys
+	h.blocks = E.size();
+	h.index = at;
+	h.key_off = h.index + sizeof(Entry) * E.size();
+	h.key_chars = h.key_off + 8 * (h.keys + 1);
+	std::vector<uint64_t> key_off (h.keys + 1, 0);
+	for ( size_t k = 0; k < h.keys; ++k )
+		key_off[k + 1] = key_off[k] + c.key_name(KeyID(k)).size();
+	h.bytes = h.key_chars + key_off[h.keys];
+	if ( ok && !E.empty() )
+		ok = fwrite(E.data(), sizeof(Entry) * E.size(), 1, f) == 1;
+	if ( ok ) ok = fwrite(key_off.data(), 8 * key_off.size(), 1, f) == 1;
+	for ( size_t k = 0; ok && k < h.keys; ++k ) {
+		const std::string& s = c.key_name(KeyID(k));
+		ok = s.empty() || fwrite(s.data(), s.size(), 1, f) == 1;
+	}
+
+	ok = ok && seek(f, 0) && fwrite(&h, sizeof(h), 1, f) == 1;
+	return fclose(f) == 0 && ok;
+}
+
+// Serve the graph in a file written by write(), replacing this one
+// and emptying the cache. Only the index of blocks and the keys are
+// read now; each block is checked when it is first read, and one that
+// is not valid is not used, so its vertices are missing from queries.
+// The file must not change while it is open. Returns false (and
+// leaves the graph unchanged) if the file could not be read or is not
+// a paged graph of this version.
+bool PagedGraph::open ( const std::string& path )
+{
+	FILE* f = fopen(path.c_str(), "rb");
+	if ( f == 0 ) return false;
+
+	Header h;
+	bool ok = fread(&h, sizeof(h), 1, f) == 1
+		&& memcmp(h.magic, MAGIC, sizeof(h.magic)) == 0
+		&& h.version == VERSION && h.order == ORDER
+#ifdef _WIN32
+		&& _fseeki64(f, 0, SEEK_END) == 0
+		&& (uint64_t)_ftelli64(f) == h.bytes
+#else
+		&& fseeko(f, 0, SEEK_END) == 0 && (uint64_t)ftello(f) == h.bytes
+#endif
+		&& h.blocks <= h.bytes && h.keys < h.bytes
+		&& h.index >= sizeof(Header)
+		&& h.key_off == h.index + sizeof(Entry) * h.blocks
+		&& h.key_chars == h.key_off + 8 * (h.keys + 1)
+		&& h.key_chars <= h.bytes;
+
+	// the index, whose blocks must lie in order between the header
+	// and the index, and cover n rows and m relationships
+	std::vector<Entry> E (ok ? h.blocks : 0);
+	if ( ok && !E.empty() ) {
+		ok = seek(f, h.index)
+			&& fread(E.data(), sizeof(Entry) * E.size(), 1, f) == 1;
+	}
+	uint64_t rows = 0, rels = 0, end = sizeof(Header);
+	for ( size_t b = 0; ok && b < E.size(); ++b ) {
+		uint64_t s[9];
+		ok = E[b].rows > 0 && E[b].at >= end
+			&& (b == 0 || E[b].first > E[b - 1].first)
+			&& E[b].out <= h.bytes && E[b].in <= h.bytes;
+		end = E[b].at + layout(E[b].rows, E[b].out, E[b].in, s);
+		rows += E[b].rows;
+		rels += E[b].out;
+	}
+	ok = ok && end <= h.index && rows == h.n && rels == h.m;
+
+	// the keys
+	std::vector<uint64_t> key_off (ok ? h.keys + 1 : 0);
+	std::vector<std::string> names (ok ? h.keys : 0);
+	ok = ok && seek(f, h.key_off)
+		&& fread(key_off.data(), 8 * key_off.size(), 1, f) == 1
+		&& key_off[0] == 0 && h.key_chars + key_off[h.keys] == h.bytes;
+	for ( size_t k = 0; ok && k < h.keys; ++k ) {
+		ok = key_off[k] <= key_off[k + 1];
+		names[k].resize(key_off[k + 1] - key_off[k]);
+		if ( ok && !names[k].empty() ) ok = fread(&names[k][0],
+			names[k].size(), 1, f) == 1;
+	}
+	if ( !ok ) {
+		fclose(f);
+		return false;
+	}
+
+	std::lock_guard<std::mutex> l (lock);
+	if ( file != 0 ) fclose(file);
+	file = f;
+	index.swap(E);
+	key_names.swap(names);
+	n = h.n;
+	m = h.m;
+	directed = h.directed != 0;
+	no_relationship = h.no_relationship;
+	cache.clear();
+	uses.clear();
+	cached = 0;
+	return true;
+}
+
+// Set the number of bytes of blocks the cache may hold. The cache
+// always keeps the last block read, however large.
+void PagedGraph::set_cache_bytes ( size_t bytes )
+{
+	std::lock_guard<std::mutex> l (lock);
+	budget = bytes;
+	while ( cached > budget && uses.size() > 1 ) {
+		std::map<size_t, Cached>::iterator it = cache.find(uses.back());
+		cached -= it->second.page->bytes();
+		cache.erase(it);
+		uses.pop_back();
+	}
+}
+
+size_t PagedGraph::cache_bytes () const
+{
+	std::lock_guard<std::mutex> l (lock);
+	return budget;
+}
+
+// Get the number of bytes of blocks in the cache.
+size_t PagedGraph::cached_bytes () const
+{
+	std::lock_guard<std::mutex> l (lock);
+	return cached;
+}
+
+size_t PagedGraph::num_blocks () const
+{
+	return index.size();
+}
+
+// Get the number of blocks read from the file so far, by queries that
+// missed the cache and by streaming passes.
+size_t PagedGraph::blocks_read () const
+{
+	std::lock_guard<std::mutex> l (lock);
+	return reads;
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of a key, or Graph::NO_KEY if the graph does not have it.
+// IDs are the same as those of the graph the file was written from.
+KeyID PagedGraph::key_id ( const std::string& key ) const
+{
+	std::vector<std::string>::const_iterator it =
+		std::find(key_names.begin(), key_names.end(), key);
+	if ( it == key_names.end() ) return Graph::NO_KEY;
+	return KeyID(it - key_names.begin());
+}
+
+const std::string& PagedGraph::key_name ( KeyID k ) const
+{
+	return key_names[k.id];
+}
+
+size_t PagedGraph::num_keys () const
+{
+	return key_names.size();
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of vertices represented in the graph.
+size_t PagedGraph::size () const
+{
+	return n;
+}
+
+// Get the number of relationships, as Graph::num_edges.
+size_t PagedGraph::num_edges () const
+{
+	return m;
+}
+
+// Get a set of neighbor IDs.
+std::set<int> PagedGraph::nbrs ( int i, unsigned char dir,
+	bool limit_key, unsigned int key ) const
+{
+	std::set<int> out;
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return out;
+
+	size_t e;
+	if ( dir != TO ) {
+		for ( e = p->out_off[r]; e < p->out_off[r + 1]; ++e )
+			if ( !limit_key || p->out_key[e] == key )
+				out.insert(out.end(), p->out_nbr[e]);
+	}
+	if ( dir != FROM ) {
+		for ( e = p->in_off[r]; e < p->in_off[r + 1]; ++e )
+			if ( !limit_key || p->in_key[e] == key )
+				out.insert(p->in_nbr[e]);
+	}
+	return out;
+}
+
+std::set<int> PagedGraph::nbrs ( int i, const std::string& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+std::set<int> PagedGraph::nbrs ( int i, KeyID key ) const
+{
+	return nbrs(i, UNDIRECTED, true, key.id);
+}
+
+std::set<int> PagedGraph::nbrs ( int i ) const
+{
+	return nbrs(i, UNDIRECTED, false, 0);
+}
+
+std::set<int> PagedGraph::nbrs_to ( int i, const std::string& key ) const
+{
+	return nbrs_to(i, key_id(key));
+}
+
+std::set<int> PagedGraph::nbrs_to ( int i, KeyID key ) const
+{
+	return nbrs(i, TO, true, key.id);
+}
+
+std::set<int> PagedGraph::nbrs_to ( int i ) const
+{
+	return nbrs(i, TO, false, 0);
+}
+
+std::set<int> PagedGraph::nbrs_from (
+	int i, const std::string& key ) const
+{
+	return nbrs_from(i, key_id(key));
+}
+
+std::set<int> PagedGraph::nbrs_from ( int i, KeyID key ) const
+{
+	return nbrs(i, FROM, true, key.id);
+}
+
+std::set<int> PagedGraph::nbrs_from ( int i ) const
+{
+	return nbrs(i, FROM, false, 0);
+}
+
+// Returns a set of object IDs, read block by block.
+std::set<int> PagedGraph::vertices () const
+{
+	std::set<int> out;
+	for ( size_t b = 0; b < index.size(); ++b ) {
+		Page p;
+		{
+			std::lock_guard<std::mutex> l (lock);
+			p = read(b);
+		}
+		if ( p ) out.insert(p->ids, p->ids + p->rows);
+	}
+	return out;
+}
+
+// Returns all of the keys in the graph, read block by block.
+std::set<std::string> PagedGraph::keys () const
+{
+	std::vector<bool> used (key_names.size(), false);
+	for_each_edge([&used] ( int, int, KeyID k, float ) {
+		used[k.id] = true;
+	});
+
+	std::set<std::string> out;
+	for ( size_t k = 0; k < used.size(); ++k )
+		if ( used[k] ) out.insert(key_names[k]);
+	return out;
+}
+
+// Returns all of the keys associated with the vertex.
+std::set<std::string> PagedGraph::keys ( int i ) const
+{
+	std::set<std::string> out;
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return out;
+
+	size_t e;
+	for ( e = p->out_off[r]; e < p->out_off[r + 1]; ++e )
+		out.insert(key_names[p->out_key[e]]);
+	for ( e = p->in_off[r]; e < p->in_off[r + 1]; ++e )
+		out.insert(key_names[p->in_key[e]]);
+	return out;
+}
+
+// Returns a set of the relationship's keys or properties.
+std::set<std::string> PagedGraph::keys ( int i, int j ) const
+{
+	std::set<std::string> out;
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return out;
+
+	size_t e = std::lower_bound(p->out_nbr + p->out_off[r],
+		p->out_nbr + p->out_off[r + 1], j) - p->out_nbr;
+	for ( ; e < p->out_off[r + 1] && p->out_nbr[e] == j; ++e )
+		out.insert(key_names[p->out_key[e]]);
+	e = std::lower_bound(p->in_nbr + p->in_off[r],
+		p->in_nbr + p->in_off[r + 1], j) - p->in_nbr;
+	for ( ; e < p->in_off[r + 1] && p->in_nbr[e] == j; ++e )
+		out.insert(key_names[p->in_key[e]]);
+	return out;
+}
+
+// Returns true if the relationship exists for the given key.
+bool PagedGraph::contains (
+	int i, int j, const std::string& key, bool undir ) const
+{
+	return contains(i, j, key_id(key), undir);
+}
+
+bool PagedGraph::contains ( int i, int j, KeyID key, bool undir ) const
+{
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return false;
+
+	if ( find(p->out_nbr, p->out_key, p->out_off[r], p->out_off[r + 1], j,
+			key.id) != NO_BLOCK )
+		return true;
+	return undir && find(p->in_nbr, p->in_key, p->in_off[r],
+		p->in_off[r + 1], j, key.id) != NO_BLOCK;
+}
+
+bool PagedGraph::contains_dir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool PagedGraph::contains_dir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, false);
+}
+
+bool PagedGraph::contains_undir (
+	int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool PagedGraph::contains_undir ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, true);
+}
+
+bool PagedGraph::contains ( int i, int j, const std::string& key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+bool PagedGraph::contains ( int i, int j, KeyID key ) const
+{
+	return contains(i, j, key, !directed);
+}
+
+// Returns true if a relationship exists between the given vertices.
+bool PagedGraph::contains_dir ( int i, int j ) const
+{
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return false;
+	return std::binary_search(p->out_nbr + p->out_off[r],
+		p->out_nbr + p->out_off[r + 1], j);
+}
+
+bool PagedGraph::contains_undir ( int i, int j ) const
+{
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return false;
+	return std::binary_search(p->out_nbr + p->out_off[r],
+		p->out_nbr + p->out_off[r + 1], j)
+		|| std::binary_search(p->in_nbr + p->in_off[r],
+		p->in_nbr + p->in_off[r + 1], j);
+}
+
+bool PagedGraph::contains ( int i, int j ) const
+{
+	if ( directed ) return contains_dir(i, j);
+	return contains_undir(i, j);
+}
+
+// Returns true if the given vertex exists. If specifying directed
+// (undir=false), only returns true if the vertex has an outgoing
+// 'from' relationship.
+bool PagedGraph::contains_dir ( int i ) const
+{
+	size_t r;
+	Page p = row(i, r);
+	return p && p->out_off[r] < p->out_off[r + 1];
+}
+
+bool PagedGraph::contains_undir ( int i ) const
+{
+	size_t r;
+	return (bool)row(i, r);
+}
+
+bool PagedGraph::contains ( int i ) const
+{
+	if ( directed ) return contains_dir(i);
+	return contains_undir(i);
+}
+
+// Returns the value of the relationship. If the relationship does
+// not exist, returns the no_relationship value. As on Graph, if the
+// relationship only exists from j to i, returns its value negated.
+float PagedGraph::get ( int i, int j, const std::string& key ) const
+{
+	return get(i, j, key_id(key));
+}
+
+float PagedGraph::get ( int i, int j, KeyID key ) const
+{
+	size_t r;
+	Page p = row(i, r);
+	if ( !p ) return no_relationship;
+
+	size_t e = find(p->out_nbr, p->out_key, p->out_off[r],
+		p->out_off[r + 1], j, key.id);
+	if ( e != NO_BLOCK ) return p->out_val[e];
+	e = find(p->in_nbr, p->in_key, p->in_off[r], p->in_off[r + 1], j,
+		key.id);
+	if ( e != NO_BLOCK ) return -1 * p->in_val[e];
+	return no_relationship;
+}
+
+float PagedGraph::get ( int i, int j ) const
+{
+	return get(i, j, KeyID());
+}
+
+
+// STREAMING ////////////////////////////////////////////////////////
+
+// Call f(i, j, key, x) for each relationship from i toward j, with its
+// KeyID and value, in order of (i, j, key). Reads each block once, in
+// file order, without caching it.
+template <class F>
+F PagedGraph::for_each_edge ( F f ) const
+{
+	for ( size_t b = 0; b < index.size(); ++b ) {
+		Page p;
+		{
+			std::lock_guard<std::mutex> l (lock);
+			p = read(b);
+		}
+		if ( !p ) continue;
+		for ( size_t r = 0; r < p->rows; ++r ) {
+			for ( size_t e = p->out_off[r]; e < p->out_off[r + 1]; ++e ) {
+				f(p->ids[r], p->out_nbr[e], KeyID(p->out_key[e]),
+					p->out_val[e]);
+			}
+		}
+	}
+	return f;
+}
+
+// Call f(i, j, x) for each key relationship from i toward j, of value
+// x, as Graph::for_each_edge; reads every block, as above.
+template <class F>
+F PagedGraph::for_each_edge ( const std::string& key, F f ) const
+{
+	return for_each_edge(key_id(key), f);
+}
+
+template <class F>
+F PagedGraph::for_each_edge ( KeyID key, F f ) const
+{
+	for_each_edge([key, &f] ( int i, int j, KeyID k, float x ) {
+		if ( k == key ) f(i, j, x);
+	});
+	return f;
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_PAGEDGRAPH_20261015
@@ -0,0 +1,296 @@
+/////////////////////////////////////////////////////////////////////
+// The relationships of one key of a graph as a sparse float       //
+// matrix in compressed sparse row (CSR) form, A(r,c) being the    //
+// value of the relationship from the vertex of row r toward that  //
+// of row c. Rows are numbered densely, as the rows of the         //
+// CsrGraph the matrix is taken from.                              //
+//                                                                 //
+// The multiply kernels run over contiguous arrays with several    //
+// independent sums, so that the compiler can vectorize them; the  //
+// parallel versions split rows into parts with about the same     //
+// number of entries and run them on a ThreadPool.                 //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_SPARSEMATRIX_20261014
+#define YOUNG_GIS_SPARSEMATRIX_20261014
+
+#include <algorithm>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+#include "ThreadPool.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+class SparseMatrix {
+private:
+	std::vector<int> ids;            // vertex of each row, increasing
+	std::vector<uint64_t> off;       // row r is [off[r], off[r+1])
+	std::vector<uint32_t> col;       // column of each entry
+	std::vector<float> val;          // value of each entry
+	
+	void init ( const CsrGraph&, KeyID );
+	std::vector<size_t> parts ( size_t ) const;
+	void multiply_rows ( const float*, float*, size_t, size_t ) const;
+	void multiply_rows ( const float*, size_t, float*, size_t,
+		size_t ) const;
+public:
+	// constructors, destructor
+	SparseMatrix ();
+	SparseMatrix ( const CsrGraph&, KeyID );
+	SparseMatrix ( const CsrGraph&, const std::string& );
+	explicit SparseMatrix ( const CsrGraph& );
+	SparseMatrix ( const Graph&, const std::string& );
+	explicit SparseMatrix ( const Graph& );
+	~SparseMatrix ();
+	
+	// rows and entries
+	size_t size () const;
+	size_t num_entries () const;
+	size_t index ( int ) const;
+	int vertex ( size_t ) const;
+	const std::vector<uint64_t>& offsets () const;
+	const std::vector<uint32_t>& columns () const;
+	const std::vector<float>& values () const;
+	SparseMatrix transpose () const;
+	
+	// products
+	void multiply ( const float*, float* ) const;
+	void multiply ( const float*, float*, ThreadPool& ) const;
+	void multiply ( const float*, size_t, float* ) const;
+	void multiply ( const float*, size_t, float*, ThreadPool& ) const;
+}; // SparseMatrix
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+SparseMatrix::SparseMatrix ()
+: off(1, 0)
+{}
+
+// Take the relationships with the given key from a snapshot. There
+// is a row for every vertex of the snapshot, in the same order, so
+// row r is the vertex c.vertex(r) and c.index(i) is the row of i.
+SparseMatrix::SparseMatrix ( const CsrGraph& c, KeyID key )
+{
+	init(c, key);
+}
+
+SparseMatrix::SparseMatrix ( const CsrGraph& c, const std::string& key )
+{
+	init(c, c.key_id(key));
+}
+
+// With the default key "", so that A(r,c) is get(i, j) wherever i has
+// a relationship toward j.
+SparseMatrix::SparseMatrix ( const CsrGraph& c )
+{
+	init(c, KeyID());
+}
+
+// Take the relationships with the given key from a graph, by way of a
+// snapshot; make the snapshot first to take several keys.
+SparseMatrix::SparseMatrix ( const Graph& g, const std::string& key )
+{
+	CsrGraph c (g);
+	init(c, c.key_id(key));
+}
+
+SparseMatrix::SparseMatrix ( const Graph& g )
+{
+	init(CsrGraph(g), KeyID());
+}
+
+SparseMatrix::~SparseMatrix () {}
+
+// Fill in the rows from the outgoing relationships of the snapshot,
+// which are already sorted by neighbor.
+void SparseMatrix::init ( const CsrGraph& c, KeyID key )
+{
+	size_t n = c.size();
+	ids.resize(n);
+	off.assign(n + 1, 0);
+	for ( size_t r = 0; r < n; ++r ) {
+		ids[r] = c.vertex(r);
+		for ( size_t e = c.out_begin(r); e < c.out_end(r); ++e ) {
+			if ( c.out_key(e) != key ) continue;
+			col.push_back(c.out_nbr(e));
+			val.push_back(c.out_val(e));
+		}
+		off[r + 1] = col.size();
+	}
+}
+
+
+// ROWS AND ENTRIES /////////////////////////////////////////////////
+
+// Get the number of rows (and of columns).
+size_t SparseMatrix::size () const
+{
+	return ids.size();
+}
+
+// Get the number of entries that are stored.
+size_t SparseMatrix::num_entries () const
+{
+	return col.size();
+}
+
+// Get the row of vertex i, or CsrGraph::NO_INDEX if it has none.
+size_t SparseMatrix::index ( int i ) const
+{
+	std::vector<int>::const_iterator it =
+		std::lower_bound(ids.begin(), ids.end(), i);
+	if ( it == ids.end() || *it != i ) return CsrGraph::NO_INDEX;
+	return it - ids.begin();
+}
+
+// Get the vertex ID of row r.
+int SparseMatrix::vertex ( size_t r ) const
+{
+	return ids[r];
+}
+
+// The CSR arrays: the entries of row r are [offsets()[r],
+// offsets()[r+1]) of columns() and values(), by increasing column.
+const std::vector<uint64_t>& SparseMatrix::offsets () const
+{
+	return off;
+}
+
+const std::vector<uint32_t>& SparseMatrix::columns () const
+{
+	return col;
+}
+
+const std::vector<float>& SparseMatrix::values () const
+{
+	return val;
+}
+
+// Get the transpose, with the same rows; its rows are the columns of
+// this matrix (its CSC form).
+SparseMatrix SparseMatrix::transpose () const
+{
+	size_t n = ids.size();
+	SparseMatrix t;
+	t.ids = ids;
+	t.off.assign(n + 1, 0);
+	t.col.resize(col.size());
+	t.val.resize(val.size());
+	for ( size_t e = 0; e < col.size(); ++e ) ++t.off[col[e] + 1];
+	for ( size_t r = 0; r < n; ++r ) t.off[r + 1] += t.off[r];
+	
+	// rows are visited in increasing order, so columns come out sorted
+	std::vector<uint64_t> at (t.off.begin(), t.off.end() - 1);
+	for ( size_t r = 0; r < n; ++r ) {
+		for ( size_t e = off[r]; e < off[r + 1]; ++e ) {
+			uint64_t f = at[col[e]]++;
+			t.col[f] = r;
+			t.val[f] = val[e];
+		}
+	}
+	return t;
+}
+
+
+// PRODUCTS /////////////////////////////////////////////////////////
+
+// Split the rows into at most p parts of about equal numbers of
+// entries. Returns the first row of each part, and then size().
+std::vector<size_t> SparseMatrix::parts ( size_t p ) const
+{
+	size_t n = ids.size();
+	std::vector<size_t> b (1, 0);
+	for ( size_t q = 1; q < p; ++q ) {
+		uint64_t target = col.size() * q / p;
+		size_t r = std::upper_bound(off.begin(), off.end(), target)
+			- off.begin() - 1;
+		if ( r > b.back() && r < n ) b.push_back(r);
+	}
+	b.push_back(n);
+	return b;
+}
+
+// y[r] = sum of A(r,c) x[c], for the rows in [first, last).
+void SparseMatrix::multiply_rows ( const float* x, float* y,
+	size_t first, size_t last ) const
+{
+	const uint32_t* c = col.empty() ? 0 : &col[0];
+	const float* v = val.empty() ? 0 : &val[0];
+	for ( size_t r = first; r < last; ++r ) {
+		size_t e = off[r];
+		size_t end = off[r + 1];
+		float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		for ( ; e + 4 <= end; e += 4 ) {
+			s0 += v[e] * x[c[e]];
+			s1 += v[e + 1] * x[c[e + 1]];
+			s2 += v[e + 2] * x[c[e + 2]];
+			s3 += v[e + 3] * x[c[e + 3]];
+		}
+		for ( ; e < end; ++e ) s0 += v[e] * x[c[e]];
+		y[r] = (s0 + s1) + (s2 + s3);
+	}
+}
+
+// Y = A X for the rows in [first, last), where X and Y have k columns
+// and are stored by row.
+void SparseMatrix::multiply_rows ( const float* x, size_t k, float* y,
+	size_t first, size_t last ) const
+{
+	for ( size_t r = first; r < last; ++r ) {
+		float* yr = y + r * k;
+		std::fill(yr, yr + k, 0.0f);
+		for ( size_t e = off[r]; e < off[r + 1]; ++e ) {
+			const float a = val[e];
+			const float* xr = x + (size_t)col[e] * k;
+			for ( size_t t = 0; t < k; ++t ) yr[t] += a * xr[t];
+		}
+	}
+}
+
+// y = A x, where x and y have size() elements and do not overlap.
+void SparseMatrix::multiply ( const float* x, float* y ) const
+{
+	multiply_rows(x, y, 0, ids.size());
+}
+
+// The same, with the rows split over the pool's threads.
+void SparseMatrix::multiply ( const float* x, float* y,
+	ThreadPool& pool ) const
+{
+	std::vector<size_t> b = parts(4 * pool.size());
+	pool.parallel_for(b.size() - 1, [&] ( size_t first, size_t last ) {
+		for ( size_t p = first; p < last; ++p )
+			multiply_rows(x, y, b[p], b[p + 1]);
+	});
+}
+
+// Y = A X, where X and Y are size() by k, stored by row (element
+// (r, t) at r * k + t), and do not overlap.
+void SparseMatrix::multiply ( const float* x, size_t k, float* y ) const
+{
+	multiply_rows(x, k, y, 0, ids.size());
+}
+
+void SparseMatrix::multiply ( const float* x, size_t k, float* y,
+	ThreadPool& pool ) const
+{
+	std::vector<size_t> b = parts(4 * pool.size());
+	pool.parallel_for(b.size() - 1, [&] ( size_t first, size_t last ) {
+		for ( size_t p = first; p < last; ++p )
+			multiply_rows(x, k, y, b[p], b[p + 1]);
+	});
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_SPARSEMATRIX_20261014
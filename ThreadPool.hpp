@@ -0,0 +1,198 @@
+/////////////////////////////////////////////////////////////////////
+// Fixed set of worker threads that run the iterations of a loop   //
+// in parallel. The thread that calls parallel_for works as well,  //
+// and returns when every iteration is done.                       //
+//                                                                 //
+// Any thread may call parallel_for; calls on one pool take turns. //
+// A call made from inside a loop of the same pool (by its body,   //
+// or by code the body calls) runs on the calling thread, in place //
+// of waiting its turn behind the loop it is part of.              //
+// Build with -pthread (or the platform's equivalent).             //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// - parallel_for from inside a loop of the same pool runs inline  //
+//   instead of deadlocking.                                       //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_THREADPOOL_20261014
+#define YOUNG_GIS_THREADPOOL_20261014
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bygis { // Brennan Young GIS namespace
+
+class ThreadPool {
+public:
+	// f(begin, end) runs the iterations [begin, end)
+	typedef std::function<void ( size_t, size_t )> Job;
+private:
+	std::vector<std::thread> workers;
+	std::mutex turn;                  // held for a whole parallel_for
+	
+	// current loop, guarded by lock
+	std::mutex lock;
+	std::condition_variable start, finish;
+	const Job* job;
+	size_t count;
+	size_t chunk;
+	std::atomic<size_t> next;         // first unclaimed iteration
+	unsigned int round;               // incremented for each loop
+	size_t pending;                   // workers still in this round
+	std::exception_ptr error;
+	bool stop;
+	
+	ThreadPool ( const ThreadPool& );
+	ThreadPool& operator= ( const ThreadPool& );
+	
+	static const ThreadPool*& current ();
+	void work ();
+	void serve ();
+public:
+	// constructors, destructor
+	explicit ThreadPool ( unsigned int threads=0 );
+	~ThreadPool ();
+	
+	// operations
+	size_t size () const;
+	void parallel_for ( size_t, const Job& );
+}; // ThreadPool
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Start a pool of the given number of threads, counting the caller of
+// parallel_for, or one per hardware thread if threads is 0.
+ThreadPool::ThreadPool ( unsigned int threads )
+: job(0), count(0), chunk(1), next(0), round(0), pending(0), stop(false)
+{
+	if ( threads == 0 ) threads = std::thread::hardware_concurrency();
+	for ( unsigned int t = 1; t < threads; ++t )
+		workers.push_back(std::thread(&ThreadPool::serve, this));
+}
+
+ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> l (lock);
+		stop = true;
+	}
+	start.notify_all();
+	for ( size_t t = 0; t < workers.size(); ++t ) workers[t].join();
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// The pool whose loop the calling thread is running, if any; set for
+// the life of each worker, and for the caller during parallel_for.
+const ThreadPool*& ThreadPool::current ()
+{
+	static thread_local const ThreadPool* pool = 0;
+	return pool;
+}
+
+// Claim and run chunks of the current loop until none are left. The
+// first exception thrown by the job is kept for the caller.
+void ThreadPool::work ()
+{
+	for ( ;; ) {
+		size_t b = next.fetch_add(chunk);
+		if ( b >= count ) return;
+		try {
+			(*job)(b, std::min(b + chunk, count));
+		}
+		catch ( ... ) {
+			std::lock_guard<std::mutex> l (lock);
+			if ( !error ) error = std::current_exception();
+			next = count;
+		}
+	}
+}
+
+// Body of a worker thread: join every loop until the pool stops.
+void ThreadPool::serve ()
+{
+	unsigned int seen = 0;
+	current() = this;
+	std::unique_lock<std::mutex> l (lock);
+	for ( ;; ) {
+		while ( !stop && round == seen ) start.wait(l);
+		if ( stop ) return;
+		seen = round;
+		l.unlock();
+		work();
+		l.lock();
+		if ( --pending == 0 ) finish.notify_one();
+	}
+}
+
+// Get the number of threads that run a loop, counting the caller.
+size_t ThreadPool::size () const
+{
+	return workers.size() + 1;
+}
+
+// Run f over [0, n) in chunks, on the pool's threads and the calling
+// thread, and wait for it to finish. If f throws, the remaining
+// chunks are skipped and the first exception is rethrown here. From
+// inside a loop of this pool, runs f(0, n) on the calling thread.
+void ThreadPool::parallel_for ( size_t n, const Job& f )
+{
+	if ( n == 0 ) return;
+	if ( current() == this ) {
+		f(0, n);
+		return;
+	}
+	std::lock_guard<std::mutex> t (turn);
+	
+	// mark the caller as inside the loop until it returns
+	struct Inside {
+		const ThreadPool* was;
+		explicit Inside ( const ThreadPool* p ) : was(current())
+		{ current() = p; }
+		~Inside () { current() = was; }
+	} inside (this);
+	if ( workers.empty() || n == 1 ) {
+		f(0, n);
+		return;
+	}
+	
+	// several chunks per thread, so that uneven chunks even out
+	{
+		std::lock_guard<std::mutex> l (lock);
+		job = &f;
+		count = n;
+		chunk = std::max<size_t>(1, n / (4 * size()));
+		next = 0;
+		error = std::exception_ptr();
+		pending = workers.size();
+		++round;
+	}
+	start.notify_all();
+	work();
+	
+	std::exception_ptr e;
+	{
+		std::unique_lock<std::mutex> l (lock);
+		while ( pending > 0 ) finish.wait(l);
+		job = 0;
+		e = error;
+		error = std::exception_ptr();
+	}
+	if ( e ) std::rethrow_exception(e);
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_THREADPOOL_20261014
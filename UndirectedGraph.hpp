@@ -0,0 +1,793 @@
+/////////////////////////////////////////////////////////////////////
+// Undirected graph that stores each relationship once. A Graph    //
+// keeps an undirected relationship at both of its vertices; here  //
+// it is kept only at the vertex with the smaller ID, and the      //
+// other vertex lists that ID in a sorted array, so a relationship //
+// costs about half the memory. Queries have the same meaning as   //
+// on an undirected Graph.                                         //
+//                                                                 //
+// BasicUndirectedGraph<Id, K, W, S> takes the same parameters as  //
+// BasicGraph; UndirectedGraph matches Graph.                      //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_UNDIRECTEDGRAPH_20261014
+#define YOUNG_GIS_UNDIRECTEDGRAPH_20261014
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <scoped_allocator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Graph.hpp"
+#include "NodePool.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+template <class Id, class K, class W, class S=OrderedMaps>
+class BasicUndirectedGraph {
+private:
+	// relationships of a pair of vertices, by key ID
+	typedef typename RelStore<K, W>::template MapOf<W>::type RelMap;
+	typedef typename S::template Map<Id, RelMap,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, RelMap> > > >::type NbrMap; // j -> rels
+	typedef std::vector<Id, PoolAllocator<Id> > IdList;
+	
+	// the neighbors of a vertex i: the relationships with neighbors
+	// j >= i, and the sorted IDs of neighbors j < i, which keep them
+	struct Row : NbrMap {
+		typedef typename NbrMap::allocator_type allocator_type;
+		IdList lower;
+		
+		explicit Row ( const allocator_type& a )
+		: NbrMap(a), lower(PoolAllocator<Id>(a)) {}
+		Row ( const Row& r, const allocator_type& a )
+		: NbrMap(r, a), lower(r.lower, PoolAllocator<Id>(a)) {}
+		Row ( Row&& r, const allocator_type& a )
+		: NbrMap(std::move(r), a),
+		  lower(std::move(r.lower), PoolAllocator<Id>(a)) {}
+		bool empty () const { return NbrMap::empty() && lower.empty(); }
+	};
+	typedef typename S::template Map<Id, Row,
+		std::scoped_allocator_adaptor<PoolAllocator<
+		std::pair<const Id, Row> > > >::type VertexMap;  // i -> nbrs
+	typedef typename VertexMap::allocator_type Alloc;
+	std::unique_ptr<NodePool> pool;                // before data
+	VertexMap data;
+	
+	// key dictionary; KeyID k names key_names[k.id]
+	std::vector<K> key_names;
+	std::map<K, unsigned int> key_ids;
+	
+	// relationships, in all and by key ID
+	size_t edge_count;
+	std::vector<size_t> key_edges;
+	
+	const RelMap* rels ( Id, Id ) const;
+	void erase_pair ( Id, Id );
+	template <class F> void visit ( Id, bool, unsigned int, F& ) const;
+	
+	// visitor that collects neighbor IDs
+	struct Collect {
+		std::set<Id>* out;
+		explicit Collect ( std::set<Id>& s ) : out(&s) {}
+		void operator() ( Id j ) { out->insert(out->end(), j); }
+	};
+public:
+	W no_relationship;
+	
+	// constructors, destructor
+	explicit BasicUndirectedGraph (W x=0);
+	BasicUndirectedGraph (const BasicUndirectedGraph&);
+	BasicUndirectedGraph (BasicUndirectedGraph&&) noexcept;
+	template <class S2>
+	explicit BasicUndirectedGraph (const BasicGraph<Id,K,W,S2>&);
+	~BasicUndirectedGraph ();
+	
+	// operators
+	BasicUndirectedGraph& operator=(const BasicUndirectedGraph&);
+	BasicUndirectedGraph& operator=(BasicUndirectedGraph&&) noexcept;
+	void swap (BasicUndirectedGraph&) noexcept;
+	BasicGraph<Id,K,W,S> to_graph () const;
+	
+	// keys
+	KeyID key_id (const K&) const;
+	KeyID intern (const K&);
+	const K& key_name (KeyID) const;
+	size_t num_keys () const;
+	
+	// operations
+	size_t size () const;
+	size_t num_edges () const;
+	size_t num_edges (const K&) const;
+	size_t num_edges (KeyID) const;
+	size_t degree (Id) const;
+	std::set<Id> nbrs (Id, const K&) const;
+	std::set<Id> nbrs (Id, KeyID) const;
+	std::set<Id> nbrs (Id) const;
+	std::set<Id> vertices () const;
+	template <class F> F for_each_nbr ( Id, const K&, F ) const;
+	template <class F> F for_each_nbr ( Id, KeyID, F ) const;
+	template <class F> F for_each_nbr ( Id, F ) const;
+	
+	std::set<K> keys () const;
+	std::set<K> keys (Id) const;
+	std::set<K> keys (Id, Id) const;
+	bool contains (Id, Id, const K&) const;
+	bool contains (Id, Id, KeyID) const;
+	bool contains_undir (Id, Id, const K&) const;
+	bool contains_undir (Id, Id, KeyID) const;
+	bool contains (Id, Id) const;
+	bool contains_undir (Id, Id) const;
+	bool contains (Id) const;
+	bool contains_undir (Id) const;
+	W get (Id, Id, const K&) const;
+	W get (Id, Id, KeyID) const;
+	W get (Id, Id) const;
+	void set (Id, Id, const K&, W);
+	void set (Id, Id, KeyID, W);
+	void set (Id, Id, W);
+	void set_undir (Id, Id, const K&, W);
+	void set_undir (Id, Id, KeyID, W);
+	void set_undir (Id, Id, W);
+	void clear (Id, Id);
+	void clear_undir (Id, Id);
+	void clear (Id, Id, const K&);
+	void clear (Id, Id, KeyID);
+	void clear_undir (Id, Id, const K&);
+	void clear_undir (Id, Id, KeyID);
+	void clear (Id, const K&);
+	void clear (Id, KeyID);
+	void clear (Id);
+	void clear (const K&);
+	void clear (KeyID);
+	void clear ();
+}; // BasicUndirectedGraph
+
+// An undirected Graph, storing each relationship once.
+typedef BasicUndirectedGraph<int, std::string, float> UndirectedGraph;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>::BasicUndirectedGraph ( W x )
+: pool(new NodePool),
+  data(Alloc(PoolAllocator<int>(pool.get()))), edge_count(0),
+  no_relationship(x)
+{
+	intern(K());
+}
+
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>::BasicUndirectedGraph (
+	const BasicUndirectedGraph& g )
+: pool(new NodePool),
+  data(g.data, Alloc(PoolAllocator<int>(pool.get()))),
+  key_names(g.key_names), key_ids(g.key_ids),
+  edge_count(g.edge_count), key_edges(g.key_edges),
+  no_relationship(g.no_relationship)
+{}
+
+// Take over the contents of g, including its pool, as Graph's move
+// constructor does.
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>::BasicUndirectedGraph (
+	BasicUndirectedGraph&& g ) noexcept
+: data(Alloc(PoolAllocator<int>())), edge_count(0),
+  no_relationship(g.no_relationship)
+{
+	swap(g);
+}
+
+// Copy a graph as undirected, with the same KeyIDs: vertices related
+// in either direction are related. Where both directions are set, the
+// value is that from the smaller ID toward the larger.
+template <class Id, class K, class W, class S>
+template <class S2>
+BasicUndirectedGraph<Id,K,W,S>::BasicUndirectedGraph (
+	const BasicGraph<Id,K,W,S2>& g )
+: pool(new NodePool),
+  data(Alloc(PoolAllocator<int>(pool.get()))), edge_count(0),
+  no_relationship(g.no_relationship)
+{
+	for ( size_t k = 0; k < g.num_keys(); ++k ) intern(g.key_name(KeyID(k)));
+	
+	typedef BasicGraph<Id,K,W,S2> G;
+	typename G::VertexRange R = g.vertex_range();
+	for ( typename G::VertexIterator it = R.begin(); it != R.end(); ++it ) {
+		typename G::ArcRange E = g.out_edges(*it);
+		for ( typename G::ArcIterator at = E.begin(); at != E.end(); ++at ) {
+			typename G::Arc a = *at;
+			if ( *it <= a.j || !g.contains_dir(a.j, *it, a.key) )
+				set(*it, a.j, a.key, a.x);
+		}
+	}
+}
+
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>::~BasicUndirectedGraph () {}
+
+
+// OPERATORS ////////////////////////////////////////////////////////
+
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>& BasicUndirectedGraph<Id,K,W,S>::operator= (
+	const BasicUndirectedGraph& g )
+{
+	if ( this == &g ) return *this;
+	BasicUndirectedGraph t (g);
+	swap(t);
+	return *this;
+}
+
+template <class Id, class K, class W, class S>
+BasicUndirectedGraph<Id,K,W,S>& BasicUndirectedGraph<Id,K,W,S>::operator= (
+	BasicUndirectedGraph&& g ) noexcept
+{
+	if ( this == &g ) return *this;
+	BasicUndirectedGraph t (std::move(g));
+	swap(t);
+	return *this;
+}
+
+// Exchange contents, pools, and settings with g in constant time.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::swap ( BasicUndirectedGraph& g ) noexcept
+{
+	pool.swap(g.pool);
+	data.swap(g.data);
+	std::swap(no_relationship, g.no_relationship);
+	key_names.swap(g.key_names);
+	key_ids.swap(g.key_ids);
+	std::swap(edge_count, g.edge_count);
+	key_edges.swap(g.key_edges);
+}
+
+template <class Id, class K, class W, class S>
+void swap ( BasicUndirectedGraph<Id,K,W,S>& a,
+	BasicUndirectedGraph<Id,K,W,S>& b ) noexcept
+{
+	a.swap(b);
+}
+
+// Get an undirected Graph with the same contents and KeyIDs.
+template <class Id, class K, class W, class S>
+BasicGraph<Id,K,W,S> BasicUndirectedGraph<Id,K,W,S>::to_graph () const
+{
+	BasicGraph<Id,K,W,S> g (false, no_relationship);
+	for ( size_t k = 0; k < key_names.size(); ++k ) g.intern(key_names[k]);
+	
+	typedef typename BasicGraph<Id,K,W,S>::Edge Edge;
+	std::vector<Edge> E;
+	E.reserve(edge_count);
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		typename NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) {
+			typename RelMap::const_iterator kt = jt->second.begin();
+			for ( ; kt != jt->second.end(); ++kt ) {
+				E.push_back(Edge(it->first, jt->first, key_names[kt->first],
+					true, kt->second));
+			}
+		}
+	}
+	g.assign_edges(E.begin(), E.end());
+	return g;
+}
+
+
+// KEYS /////////////////////////////////////////////////////////////
+
+// Get the ID of an interned key, or NO_KEY if the graph has never
+// seen the key.
+template <class Id, class K, class W, class S>
+KeyID BasicUndirectedGraph<Id,K,W,S>::key_id ( const K& key ) const
+{
+	typename std::map<K, unsigned int>::const_iterator it =
+		key_ids.find(key);
+	if ( it == key_ids.end() ) return BasicGraph<Id,K,W,S>::NO_KEY;
+	return KeyID(it->second);
+}
+
+// Get the ID of the key, interning it if it is new.
+template <class Id, class K, class W, class S>
+KeyID BasicUndirectedGraph<Id,K,W,S>::intern ( const K& key )
+{
+	typename std::map<K, unsigned int>::const_iterator it =
+		key_ids.find(key);
+	if ( it != key_ids.end() ) return KeyID(it->second);
+	unsigned int k = key_names.size();
+	key_names.push_back(key);
+	key_ids[key] = k;
+	key_edges.push_back(0);
+	return KeyID(k);
+}
+
+template <class Id, class K, class W, class S>
+const K& BasicUndirectedGraph<Id,K,W,S>::key_name ( KeyID k ) const
+{
+	return key_names[k.id];
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::num_keys () const
+{
+	return key_names.size();
+}
+
+
+// STORAGE //////////////////////////////////////////////////////////
+
+// Get the relationships between i and j, or null if there are none.
+template <class Id, class K, class W, class S>
+const typename BasicUndirectedGraph<Id,K,W,S>::RelMap*
+BasicUndirectedGraph<Id,K,W,S>::rels ( Id i, Id j ) const
+{
+	if ( j < i ) std::swap(i, j);
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return 0;
+	typename NbrMap::const_iterator jt = it->second.find(j);
+	return jt == it->second.end() ? 0 : &jt->second;
+}
+
+// Drop the pair of i < j (or i == j) once it has no relationships, and
+// either vertex once it has no neighbors.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::erase_pair ( Id i, Id j )
+{
+	typename VertexMap::iterator it = data.find(i);
+	it->second.erase(j);
+	if ( it->second.empty() ) data.erase(it);
+	if ( i == j ) return;
+	
+	typename VertexMap::iterator jt = data.find(j);
+	IdList& L = jt->second.lower;
+	L.erase(std::lower_bound(L.begin(), L.end(), i));
+	if ( jt->second.empty() ) data.erase(jt);
+}
+
+// Call f(j) once for each neighbor j of i, with the key if limit_key,
+// in increasing order with OrderedMaps.
+template <class Id, class K, class W, class S>
+template <class F>
+void BasicUndirectedGraph<Id,K,W,S>::visit ( Id i, bool limit_key,
+	unsigned int key, F& f ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return;
+	const Row& V = it->second;
+	
+	// smaller neighbors keep the relationships
+	typename IdList::const_iterator lt = V.lower.begin();
+	for ( ; lt != V.lower.end(); ++lt ) {
+		if ( limit_key ) {
+			const RelMap& N = data.find(*lt)->second.find(i)->second;
+			if ( N.find(key) == N.end() ) continue;
+		}
+		f(*lt);
+	}
+	
+	typename NbrMap::const_iterator jt = V.begin();
+	for ( ; jt != V.end(); ++jt ) {
+		if ( limit_key && jt->second.find(key) == jt->second.end() )
+			continue;
+		f(jt->first);
+	}
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of vertices represented in the graph.
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::size () const
+{
+	return data.size();
+}
+
+// Get the number of relationships, in constant time. Each counts
+// once, where an undirected Graph counts it from both of its
+// vertices (a self-loop once).
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::num_edges () const
+{
+	return edge_count;
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::num_edges ( const K& key ) const
+{
+	return num_edges(key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::num_edges ( KeyID key ) const
+{
+	if ( key.id >= key_edges.size() ) return 0;
+	return key_edges[key.id];
+}
+
+// Get the number of neighbors, as nbrs(i).size() without the copy.
+template <class Id, class K, class W, class S>
+size_t BasicUndirectedGraph<Id,K,W,S>::degree ( Id i ) const
+{
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return 0;
+	return it->second.size() + it->second.lower.size();
+}
+
+// Get a set of neighbor IDs.
+template <class Id, class K, class W, class S>
+std::set<Id> BasicUndirectedGraph<Id,K,W,S>::nbrs ( Id i, const K& key ) const
+{
+	return nbrs(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicUndirectedGraph<Id,K,W,S>::nbrs ( Id i, KeyID key ) const
+{
+	std::set<Id> out;
+	Collect f (out);
+	visit(i, true, key.id, f);
+	return out;
+}
+
+template <class Id, class K, class W, class S>
+std::set<Id> BasicUndirectedGraph<Id,K,W,S>::nbrs ( Id i ) const
+{
+	std::set<Id> out;
+	Collect f (out);
+	visit(i, false, 0, f);
+	return out;
+}
+
+// Returns a set of object IDs.
+template <class Id, class K, class W, class S>
+std::set<Id> BasicUndirectedGraph<Id,K,W,S>::vertices () const
+{
+	std::set<Id> out;
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) out.insert(out.end(), it->first);
+	return out;
+}
+
+// Call f(j) for each neighbor j, as nbrs() without the copy. Returns
+// f, as std::for_each does.
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicUndirectedGraph<Id,K,W,S>::for_each_nbr ( Id i, const K& key,
+	F f ) const
+{
+	return for_each_nbr(i, key_id(key), f);
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicUndirectedGraph<Id,K,W,S>::for_each_nbr ( Id i, KeyID key,
+	F f ) const
+{
+	visit(i, true, key.id, f);
+	return f;
+}
+
+template <class Id, class K, class W, class S>
+template <class F>
+F BasicUndirectedGraph<Id,K,W,S>::for_each_nbr ( Id i, F f ) const
+{
+	visit(i, false, 0, f);
+	return f;
+}
+
+// Returns all of the keys in the graph.
+template <class Id, class K, class W, class S>
+std::set<K> BasicUndirectedGraph<Id,K,W,S>::keys () const
+{
+	std::set<K> out;
+	for ( size_t k = 0; k < key_edges.size(); ++k )
+		if ( key_edges[k] > 0 ) out.insert(key_names[k]);
+	return out;
+}
+
+// Returns all of the keys associated with the vertex.
+template <class Id, class K, class W, class S>
+std::set<K> BasicUndirectedGraph<Id,K,W,S>::keys ( Id i ) const
+{
+	std::set<K> out;
+	typename VertexMap::const_iterator it = data.find(i);
+	if ( it == data.end() ) return out;
+	const Row& V = it->second;
+	
+	typename RelMap::const_iterator kt;
+	typename IdList::const_iterator lt = V.lower.begin();
+	for ( ; lt != V.lower.end(); ++lt ) {
+		const RelMap& N = data.find(*lt)->second.find(i)->second;
+		for ( kt = N.begin(); kt != N.end(); ++kt )
+			out.insert(key_names[kt->first]);
+	}
+	typename NbrMap::const_iterator jt = V.begin();
+	for ( ; jt != V.end(); ++jt ) {
+		for ( kt = jt->second.begin(); kt != jt->second.end(); ++kt )
+			out.insert(key_names[kt->first]);
+	}
+	return out;
+}
+
+// Returns a set of the relationship's keys or properties.
+template <class Id, class K, class W, class S>
+std::set<K> BasicUndirectedGraph<Id,K,W,S>::keys ( Id i, Id j ) const
+{
+	std::set<K> out;
+	const RelMap* N = rels(i, j);
+	if ( !N ) return out;
+	typename RelMap::const_iterator kt = N->begin();
+	for ( ; kt != N->end(); ++kt ) out.insert(key_names[kt->first]);
+	return out;
+}
+
+// Returns true if the relationship exists for the given key. Every
+// relationship is undirected, so contains and contains_undir agree.
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains (
+	Id i, Id j, const K& key ) const
+{
+	return contains(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains ( Id i, Id j, KeyID key ) const
+{
+	const RelMap* N = rels(i, j);
+	return N && N->find(key.id) != N->end();
+}
+
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains_undir (
+	Id i, Id j, const K& key ) const
+{
+	return contains(i, j, key);
+}
+
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains_undir (
+	Id i, Id j, KeyID key ) const
+{
+	return contains(i, j, key);
+}
+
+// Returns true if a relationship exists between the given vertices.
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains ( Id i, Id j ) const
+{
+	return rels(i, j) != 0;
+}
+
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains_undir ( Id i, Id j ) const
+{
+	return contains(i, j);
+}
+
+// Returns true if the given vertex exists.
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains ( Id i ) const
+{
+	return data.find(i) != data.end();
+}
+
+template <class Id, class K, class W, class S>
+bool BasicUndirectedGraph<Id,K,W,S>::contains_undir ( Id i ) const
+{
+	return contains(i);
+}
+
+// Returns the value of the relationship. If the relationship does
+// not exist, returns the no_relationship value.
+template <class Id, class K, class W, class S>
+W BasicUndirectedGraph<Id,K,W,S>::get ( Id i, Id j, const K& key ) const
+{
+	return get(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+W BasicUndirectedGraph<Id,K,W,S>::get ( Id i, Id j, KeyID key ) const
+{
+	const RelMap* N = rels(i, j);
+	if ( !N ) return no_relationship;
+	typename RelMap::const_iterator kt = N->find(key.id);
+	if ( kt == N->end() ) return no_relationship;
+	return kt->second;
+}
+
+template <class Id, class K, class W, class S>
+W BasicUndirectedGraph<Id,K,W,S>::get ( Id i, Id j ) const
+{
+	return get(i, j, KeyID());
+}
+
+// Set the value of the relationship, creating it if it does not exist.
+// Setting the no_relationship value removes it.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set ( Id i, Id j, const K& key, W x )
+{
+	set(i, j, intern(key), x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set ( Id i, Id j, KeyID key, W x )
+{
+	// check for no-relationship value
+	if ( fabs(x - no_relationship) < 0.0000001 ) {
+		clear(i, j, key);
+		return;
+	}
+	
+	if ( j < i ) std::swap(i, j);
+	if ( i != j && !contains(i, j) ) {
+		IdList& L = data[j].lower;
+		L.insert(std::lower_bound(L.begin(), L.end(), i), i);
+	}
+	RelMap& N = data[i][j];
+	typename RelMap::iterator kt = N.find(key.id);
+	if ( kt != N.end() ) {
+		kt->second = x;
+		return;
+	}
+	N[key.id] = x;
+	++edge_count;
+	++key_edges[key.id];
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set ( Id i, Id j, W x )
+{
+	set(i, j, KeyID(), x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set_undir ( Id i, Id j, const K& key,
+	W x )
+{
+	set(i, j, key, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set_undir ( Id i, Id j, KeyID key,
+	W x )
+{
+	set(i, j, key, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::set_undir ( Id i, Id j, W x )
+{
+	set(i, j, KeyID(), x);
+}
+
+// Remove the relationship(s) between the given vertices.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i, Id j )
+{
+	const RelMap* N = rels(i, j);
+	if ( !N ) return;
+	typename RelMap::const_iterator kt = N->begin();
+	for ( ; kt != N->end(); ++kt ) {
+		--edge_count;
+		--key_edges[kt->first];
+	}
+	erase_pair(std::min(i, j), std::max(i, j));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear_undir ( Id i, Id j )
+{
+	clear(i, j);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i, Id j, const K& key )
+{
+	clear(i, j, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i, Id j, KeyID key )
+{
+	if ( !contains(i, j, key) ) return;
+	if ( j < i ) std::swap(i, j);
+	RelMap& N = data.find(i)->second.find(j)->second;
+	N.erase(key.id);
+	--edge_count;
+	--key_edges[key.id];
+	if ( N.size() == 0 ) erase_pair(i, j);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear_undir ( Id i, Id j,
+	const K& key )
+{
+	clear(i, j, key);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear_undir ( Id i, Id j, KeyID key )
+{
+	clear(i, j, key);
+}
+
+// Remove relationships from vertex.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i, const K& key )
+{
+	clear(i, key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i, KeyID key )
+{
+	std::set<Id> N = nbrs(i, key);
+	typename std::set<Id>::iterator it = N.begin();
+	for ( ; it != N.end(); ++it ) clear(i, *it, key);
+}
+
+// Remove vertex.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( Id i )
+{
+	std::set<Id> N = nbrs(i);
+	typename std::set<Id>::iterator it = N.begin();
+	for ( ; it != N.end(); ++it ) clear(i, *it);
+}
+
+// Remove key. Visits every relationship, as the graph keeps no index
+// by key.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( const K& key )
+{
+	clear(key_id(key));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ( KeyID key )
+{
+	if ( num_edges(key) == 0 ) return;
+	std::vector<std::pair<Id, Id> > pairs;
+	typename VertexMap::const_iterator it = data.begin();
+	for ( ; it != data.end(); ++it ) {
+		typename NbrMap::const_iterator jt = it->second.begin();
+		for ( ; jt != it->second.end(); ++jt ) {
+			if ( jt->second.find(key.id) != jt->second.end() )
+				pairs.push_back(std::make_pair(it->first, jt->first));
+		}
+	}
+	for ( size_t p = 0; p < pairs.size(); ++p )
+		clear(pairs[p].first, pairs[p].second, key);
+}
+
+// Remove all relationships. Interned keys remain valid.
+template <class Id, class K, class W, class S>
+void BasicUndirectedGraph<Id,K,W,S>::clear ()
+{
+	if ( !pool ) {
+		*this = BasicUndirectedGraph(no_relationship); // moved-from
+		return;
+	}
+	data.clear();
+	edge_count = 0;
+	key_edges.assign(key_edges.size(), 0);
+	pool->release();
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_UNDIRECTEDGRAPH_20261014
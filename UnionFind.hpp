@@ -0,0 +1,190 @@
+/////////////////////////////////////////////////////////////////////
+// Disjoint sets of the numbers 0..size()-1 (union-find), with     //
+// union by size and path halving, so that finding a set and       //
+// joining two sets take nearly constant time. Each set also lists //
+// its members, so that a set which may have come apart (after a   //
+// relationship is removed, say) can be marked stale and later     //
+// split up and joined again from only its own members.            //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// 10/15/2026                                                      //
+// - find and is_stale on a const set, without path halving.       //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_UNIONFIND_20261014
+#define YOUNG_GIS_UNIONFIND_20261014
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bygis { // Brennan Young GIS namespace
+
+class UnionFind {
+private:
+	std::vector<size_t> up;          // parent; a root is its own
+	std::vector<size_t> next;        // members of a set, in a cycle
+	std::vector<size_t> count;       // members, at a root
+	std::vector<char> stale;         // at a root: may have come apart
+public:
+	// constructors, destructor
+	explicit UnionFind ( size_t n=0 );
+	~UnionFind ();
+
+	// sets
+	size_t size () const;
+	size_t add ();
+	size_t find ( size_t );
+	size_t find ( size_t ) const;
+	bool unite ( size_t, size_t );
+	size_t set_size ( size_t );
+
+	// stale sets
+	void invalidate ( size_t );
+	void validate ( size_t );
+	bool is_stale ( size_t );
+	bool is_stale ( size_t ) const;
+	std::vector<size_t> split ( size_t );
+
+	// operations
+	void reset ( size_t );
+}; // UnionFind
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Make n sets of one member each.
+UnionFind::UnionFind ( size_t n )
+{
+	reset(n);
+}
+
+UnionFind::~UnionFind () {}
+
+
+// SETS /////////////////////////////////////////////////////////////
+
+// Get the number of members of all of the sets.
+size_t UnionFind::size () const
+{
+	return up.size();
+}
+
+// Add a set whose one member is the next number, and return it.
+size_t UnionFind::add ()
+{
+	size_t a = up.size();
+	up.push_back(a);
+	next.push_back(a);
+	count.push_back(1);
+	stale.push_back(0);
+	return a;
+}
+
+// Get the root of a's set, which every member of the set shares until
+// the set is joined to another or split.
+size_t UnionFind::find ( size_t a )
+{
+	while ( up[a] != a ) {
+		up[a] = up[up[a]];
+		a = up[a];
+	}
+	return a;
+}
+
+// Get the root of a's set as find does, but without shortening the
+// path to it, so that readers may share the set.
+size_t UnionFind::find ( size_t a ) const
+{
+	while ( up[a] != a ) a = up[a];
+	return a;
+}
+
+// Join the sets of a and b; false if they were already one set. The
+// result is stale if either set was.
+bool UnionFind::unite ( size_t a, size_t b )
+{
+	a = find(a);
+	b = find(b);
+	if ( a == b ) return false;
+	if ( count[a] < count[b] ) std::swap(a, b);
+	up[b] = a;
+	count[a] += count[b];
+	if ( stale[b] ) stale[a] = 1;
+	std::swap(next[a], next[b]);      // splice the two cycles
+	return true;
+}
+
+// Get the number of members of a's set.
+size_t UnionFind::set_size ( size_t a )
+{
+	return count[find(a)];
+}
+
+
+// STALE SETS ///////////////////////////////////////////////////////
+
+// Mark a's set as one that may have come apart.
+void UnionFind::invalidate ( size_t a )
+{
+	stale[find(a)] = 1;
+}
+
+// Mark a's set as whole again, as when the relationships that were
+// removed turn out not to have split it.
+void UnionFind::validate ( size_t a )
+{
+	stale[find(a)] = 0;
+}
+
+// True if a's set is marked as one that may have come apart.
+bool UnionFind::is_stale ( size_t a )
+{
+	return stale[find(a)] != 0;
+}
+
+bool UnionFind::is_stale ( size_t a ) const
+{
+	return stale[find(a)] != 0;
+}
+
+// Make every member of a's set a set of its own, and return them, so
+// that the caller can join them again. Takes time in the size of the
+// set.
+std::vector<size_t> UnionFind::split ( size_t a )
+{
+	std::vector<size_t> m;
+	m.reserve(count[find(a)]);
+	size_t b = a;
+	do {
+		m.push_back(b);
+		b = next[b];
+	} while ( b != a );
+	for ( size_t t = 0; t < m.size(); ++t ) {
+		up[m[t]] = next[m[t]] = m[t];
+		count[m[t]] = 1;
+		stale[m[t]] = 0;
+	}
+	return m;
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Start over with n sets of one member each.
+void UnionFind::reset ( size_t n )
+{
+	up.resize(n);
+	next.resize(n);
+	for ( size_t a = 0; a < n; ++a ) up[a] = next[a] = a;
+	count.assign(n, 1);
+	stale.assign(n, 0);
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_UNIONFIND_20261014
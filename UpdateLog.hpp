@@ -0,0 +1,264 @@
+/////////////////////////////////////////////////////////////////////
+// Queue of changes to a graph, applied together by commit.        //
+// Changes to the same relationship are reduced to the last one,   //
+// and the rest are made in one sorted pass (apply_edges).         //
+//                                                                 //
+// Readers that must not wait for a commit can read a snapshot     //
+// instead of the graph: commit(snapshot) publishes a new snapshot //
+// once the changes are in, and readers holding the old one keep   //
+// seeing it until they let it go. A CsrGraph snapshot is rebuilt  //
+// from the whole graph on each commit; a GraphFork snapshot is a  //
+// fork of the last one with only the logged changes made to it.   //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/14/2026                                                      //
+// - created.                                                      //
+// 10/15/2026                                                      //
+// - commit into a GraphFork snapshot, which publishes only the    //
+//   changes, and into std::atomic<std::shared_ptr> (C++20).       //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_UPDATELOG_20261014
+#define YOUNG_GIS_UPDATELOG_20261014
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+#include "GraphFork.hpp"
+
+namespace bygis { // Brennan Young GIS namespace
+
+template <class Id, class K, class W, class S=OrderedMaps>
+class BasicUpdateLog {
+public:
+	typedef BasicGraph<Id,K,W,S> G;
+	typedef typename G::Edge Edge;
+private:
+	G* g;
+	std::vector<Edge> edges;
+	
+	std::shared_ptr<const GraphFork> advance (
+		const std::shared_ptr<const GraphFork>& );
+public:
+	// constructors, destructor
+	explicit BasicUpdateLog ( G& );
+	~BasicUpdateLog ();
+	
+	// changes, as the graph methods of the same names
+	void set ( Id, Id, const K&, bool, W );
+	void set ( Id, Id, const K&, W );
+	void set_dir ( Id, Id, const K&, W );
+	void set_undir ( Id, Id, const K&, W );
+	void set ( Id, Id, W );
+	void set_dir ( Id, Id, W );
+	void set_undir ( Id, Id, W );
+	void clear ( Id, Id, const K&, bool );
+	void clear ( Id, Id, const K& );
+	void clear_dir ( Id, Id, const K& );
+	void clear_undir ( Id, Id, const K& );
+	
+	// operations
+	size_t size () const;
+	void discard ();
+	void commit ();
+	void commit ( std::shared_ptr<const CsrGraph>& );
+	void commit ( std::shared_ptr<const GraphFork>& );
+#ifdef __cpp_lib_atomic_shared_ptr
+	void commit ( std::atomic<std::shared_ptr<const CsrGraph> >& );
+	void commit ( std::atomic<std::shared_ptr<const GraphFork> >& );
+#endif
+}; // BasicUpdateLog
+
+// A log of changes to a Graph.
+typedef BasicUpdateLog<int, std::string, float> UpdateLog;
+
+
+// CONSTRUCTORS / DESTRUCTOR ////////////////////////////////////////
+
+// Start an empty log of changes to the graph, which must outlive it.
+template <class Id, class K, class W, class S>
+BasicUpdateLog<Id,K,W,S>::BasicUpdateLog ( G& graph )
+: g(&graph)
+{}
+
+template <class Id, class K, class W, class S>
+BasicUpdateLog<Id,K,W,S>::~BasicUpdateLog () {}
+
+
+// CHANGES //////////////////////////////////////////////////////////
+
+// Undirected if undir == true
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set ( Id i, Id j, const K& key, bool undir,
+	W x )
+{
+	edges.push_back(Edge(i, j, key, undir, x));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set ( Id i, Id j, const K& key, W x )
+{
+	set(i, j, key, !g->directed, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set_dir ( Id i, Id j, const K& key, W x )
+{
+	set(i, j, key, false, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set_undir ( Id i, Id j, const K& key, W x )
+{
+	set(i, j, key, true, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set ( Id i, Id j, W x )
+{
+	set(i, j, K(), !g->directed, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set_dir ( Id i, Id j, W x )
+{
+	set(i, j, K(), false, x);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::set_undir ( Id i, Id j, W x )
+{
+	set(i, j, K(), true, x);
+}
+
+// Remove a relationship, recorded as setting it to no_relationship.
+// Only keyed removals can be logged; use the graph to remove all of
+// the relationships between two vertices.
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::clear ( Id i, Id j, const K& key,
+	bool undir )
+{
+	set(i, j, key, undir, g->no_relationship);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::clear ( Id i, Id j, const K& key )
+{
+	clear(i, j, key, !g->directed);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::clear_dir ( Id i, Id j, const K& key )
+{
+	clear(i, j, key, false);
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::clear_undir ( Id i, Id j, const K& key )
+{
+	clear(i, j, key, true);
+}
+
+
+// OPERATIONS ///////////////////////////////////////////////////////
+
+// Get the number of changes waiting, before they are reduced.
+template <class Id, class K, class W, class S>
+size_t BasicUpdateLog<Id,K,W,S>::size () const
+{
+	return edges.size();
+}
+
+// Drop the changes waiting, without making them.
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::discard ()
+{
+	edges.clear();
+}
+
+// Make the changes waiting, as if each had been made on the graph in
+// the order it was logged, and empty the log.
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::commit ()
+{
+	g->apply_edges(edges.begin(), edges.end());
+	edges.clear();
+}
+
+// Commit, then replace the snapshot with a new one of the graph. The
+// snapshot is replaced with std::atomic_store, so readers that take it
+// with std::atomic_load get either the old or the new one; the old one
+// does not change, and is freed when the last reader lets it go. Only
+// for Graph, as CsrGraph is. The new snapshot is built from the whole
+// graph, in time in its size however few the changes; a GraphFork
+// snapshot takes time in the changes instead. std::atomic_store on a
+// shared_ptr is deprecated in C++20, which has the overload below.
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::commit ( std::shared_ptr<const CsrGraph>& s )
+{
+	commit();
+	std::shared_ptr<const CsrGraph> c (new CsrGraph(*g));
+	std::atomic_store(&s, c);
+}
+
+// Commit, then replace the snapshot with a fork of it that has the
+// same changes, as the CsrGraph snapshot is replaced. The fork shares
+// the arrays of the first snapshot and the rows of the last, so this
+// takes time in the number of changes and of vertices changed since
+// the first snapshot, not in the size of the graph. The snapshot must
+// be null (to start with a fork of the graph, in time in its size) or
+// made by the last commit of this log, and every commit since must
+// have gone into it: changes made to the graph any other way are not
+// in it. When many vertices have changed, reset the snapshot to null
+// to start again from a frozen copy.
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::commit ( std::shared_ptr<const GraphFork>& s )
+{
+	std::shared_ptr<const GraphFork> c = advance(std::atomic_load(&s));
+	std::atomic_store(&s, c);
+}
+
+#ifdef __cpp_lib_atomic_shared_ptr
+// As the commits above, for a snapshot held in a
+// std::atomic<std::shared_ptr>, which readers take with load().
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::commit (
+	std::atomic<std::shared_ptr<const CsrGraph> >& s )
+{
+	commit();
+	s.store(std::shared_ptr<const CsrGraph>(new CsrGraph(*g)));
+}
+
+template <class Id, class K, class W, class S>
+void BasicUpdateLog<Id,K,W,S>::commit (
+	std::atomic<std::shared_ptr<const GraphFork> >& s )
+{
+	s.store(advance(s.load()));
+}
+#endif
+
+// Commit, and get a fork of s with the same changes made to it in the
+// same order, or a fork of the graph if s is null.
+template <class Id, class K, class W, class S>
+std::shared_ptr<const GraphFork> BasicUpdateLog<Id,K,W,S>::advance (
+	const std::shared_ptr<const GraphFork>& s )
+{
+	if ( !s ) {
+		commit();
+		return std::shared_ptr<const GraphFork>(new GraphFork(*g));
+	}
+	std::shared_ptr<GraphFork> f (new GraphFork(*s));
+	typename std::vector<Edge>::const_iterator it = edges.begin();
+	for ( ; it != edges.end(); ++it )
+		f->set(it->i, it->j, it->key, it->undir, it->x);
+	commit();
+	return f;
+}
+
+} // namespace bygis
+
+#endif // YOUNG_GIS_UPDATELOG_20261014
@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////
+// Checks get_batch and contains_batch against get and contains of //
+// each record: random graphs with ordered and hashed maps, with   //
+// and without keys, probed with random batches of records (in     //
+// order, in reverse, and shuffled, with runs of the same vertex,  //
+// pair, and key, and with vertices and keys the graph lacks). A   //
+// round is one graph of each kind (300 by default; see            //
+// Check.hpp).                                                     //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+// Key number k as a key of each type; k == 0 is the default key.
+template <class K> K key_of ( int k );
+
+template <>
+std::string key_of<std::string> ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+template <>
+bygis::NoKey key_of<bygis::NoKey> ( int )
+{
+	return bygis::NoKey();
+}
+
+template <class G>
+bool before ( const typename G::Edge& a, const typename G::Edge& b )
+{
+	if ( a.i != b.i ) return a.i < b.i;
+	return a.j < b.j;
+}
+
+template <class G, class K>
+void check ( size_t rounds, std::mt19937& rng )
+{
+	typedef typename G::Edge Edge;
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 60, k = 1 + rng() % 4;
+		G g (rng() % 2 == 0);
+		for ( size_t m = rng() % 400; m > 0; --m ) {
+			g.set(rng() % n - 2, rng() % n - 2, key_of<K>(rng() % k),
+				rng() % 3 == 0, (float)(1 + rng() % 5));
+		}
+
+		// records: key k (one more than the graph has) is never used
+		std::vector<Edge> E;
+		for ( size_t m = rng() % 500; m > 0; --m ) {
+			Edge e (rng() % (n + 4) - 4, rng() % (n + 4) - 4,
+				key_of<K>(rng() % (k + 1)), rng() % 2 == 0, 0);
+			for ( size_t r = rng() % 4 == 0 ? rng() % 5 : 1; r > 0; --r ) {
+				E.push_back(e);
+				if ( rng() % 2 == 0 ) e.j = rng() % (n + 4) - 4;
+				if ( rng() % 2 == 0 ) e.key = key_of<K>(rng() % (k + 1));
+			}
+		}
+		switch ( rng() % 3 ) {
+		case 0:
+			std::sort(E.begin(), E.end(), before<G>);
+			break;
+		case 1:
+			std::sort(E.begin(), E.end(), before<G>);
+			std::reverse(E.begin(), E.end());
+			break;
+		}
+
+		std::vector<float> X (E.size() + 1, 99);
+		std::vector<char> F (E.size() + 1, 2);
+		g.get_batch(E.begin(), E.end(), X.begin());
+		g.contains_batch(E.begin(), E.end(), F.begin());
+		for ( size_t e = 0; e < E.size(); ++e ) {
+			const Edge& r = E[e];
+			if ( X[e] != g.get(r.i, r.j, r.key) )
+				fail("get_batch", round, "record", e);
+			if ( (bool)F[e] != g.contains(r.i, r.j, r.key, r.undir) )
+				fail("contains_batch", round, "record", e);
+		}
+		if ( X[E.size()] != 99 || F[E.size()] != 2 )
+			fail("past the end", round, "record", E.size());
+		if ( bygis::check::too_many() ) return;
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 300);
+	std::mt19937 rng (1);
+	check<bygis::Graph, std::string>(rounds, rng);
+	check<bygis::HashGraph, std::string>(rounds, rng);
+	check<bygis::BasicGraph<int, bygis::NoKey, float>, bygis::NoKey>(
+		rounds, rng);
+	check<bygis::BasicGraph<int, bygis::NoKey, float, bygis::HashedMaps>,
+		bygis::NoKey>(rounds, rng);
+	return bygis::check::finish();
+}
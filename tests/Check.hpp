@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////
+// What the checks in tests/ share: a count of failures, printed   //
+// as they happen (the first 20 of them), the number of rounds     //
+// from the command line, and the ending line and exit code. Each  //
+// check compares a part of the library against a simpler          //
+// equivalent on random inputs, and is run as                      //
+//                                                                 //
+//   ./SomeCheck [rounds]                                          //
+//                                                                 //
+// printing "ok" or "FAILED", and exiting with 1 if any failed.    //
+// CMakeLists.txt builds them all and runs them with ctest.        //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created, from what the checks repeated.                       //
+/////////////////////////////////////////////////////////////////////
+
+#ifndef YOUNG_GIS_CHECK_20261015
+#define YOUNG_GIS_CHECK_20261015
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bygis { // Brennan Young GIS namespace
+namespace check {
+
+// Number of failures so far.
+inline size_t& failures ()
+{
+	static size_t n = 0;
+	return n;
+}
+
+// True once enough has failed that more would not be printed.
+inline bool too_many () { return failures() > 20; }
+
+// Count a failure of what, and print it (as "FAIL what (round 3,
+// vertex 7)", with of "vertex" and n 7) unless 20 came before it.
+inline void fail ( const char* what, size_t round, const char* of, long n )
+{
+	if ( ++failures() <= 20 )
+		std::printf("FAIL %s (round %zu, %s %ld)\n", what, round, of, n);
+}
+
+// Number of rounds: the first argument, or by default if none.
+inline size_t rounds ( int argc, char** argv, size_t by_default )
+{
+	return argc > 1 ? std::strtoul(argv[1], 0, 10) : by_default;
+}
+
+// Print the ending line, and return the exit code for main.
+inline int finish ()
+{
+	std::printf("%s: %zu failures\n", failures() ? "FAILED" : "ok",
+		failures());
+	return failures() ? 1 : 0;
+}
+
+} // namespace check
+} // namespace bygis
+
+#endif
@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////////////
+// Checks connected and component against a breadth-first search   //
+// of the same relationships: random graphs, with and without the  //
+// key index, changed by setting and clearing relationships and    //
+// removing vertices, and asked every 25 changes about each pair   //
+// of vertices, by each key and by all keys. Each graph starts     //
+// with a path that is then cut in the middle, so that a component //
+// splits. Both the non-const and the const overloads are asked,   //
+// of graphs that track their components and of graphs that do     //
+// not. A round is one graph (200 by default; see Check.hpp).      //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+// the relationships of a graph, as (i, j, key number); key 0 is ""
+typedef std::set<std::tuple<int, int, int> > Rels;
+
+const int KEYS = 3;
+
+std::string key_name ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+// True if i has a relationship in R, and so is in the graph.
+bool has ( const Rels& R, int i )
+{
+	for ( Rels::const_iterator it = R.begin(); it != R.end(); ++it )
+		if ( std::get<0>(*it) == i || std::get<1>(*it) == i ) return true;
+	return false;
+}
+
+// True if a path of relationships with key k (or any key, if k < 0)
+// joins a and b, in either direction.
+bool reach ( const Rels& R, int a, int b, int k )
+{
+	if ( !has(R, a) || !has(R, b) ) return false;
+	std::set<int> seen;
+	std::vector<int> Q (1, a);
+	seen.insert(a);
+	for ( size_t h = 0; h < Q.size(); ++h ) {
+		if ( Q[h] == b ) return true;
+		for ( Rels::const_iterator it = R.begin(); it != R.end(); ++it ) {
+			int i = std::get<0>(*it), j = std::get<1>(*it);
+			if ( k >= 0 && std::get<2>(*it) != k ) continue;
+			int o = i == Q[h] ? j : j == Q[h] ? i : -1;
+			if ( o >= 0 && seen.insert(o).second ) Q.push_back(o);
+		}
+	}
+	return false;
+}
+
+// Ask g about every pair of n vertices, by key k (or all keys, if
+// k < 0), and compare with a search of R; a key g never interned
+// joins nothing. The const overloads are asked first, while the
+// components that may have come apart are not yet checked. Component
+// IDs must match exactly when vertices are connected if g tracks its
+// components, and otherwise be NO_INDEX, without the queries starting
+// to track them.
+template <class G>
+void ask ( G& g, const Rels& R, int n, int k, size_t round )
+{
+	const G& c = g;
+	const std::string key = key_name(k);
+	bool tracked = g.tracks_components();
+	bool known = k < 0 || g.key_id(key) != G::NO_KEY;
+	std::vector<char> want (n * n);
+	for ( int i = 0; i < n; ++i )
+		for ( int j = 0; j < n; ++j )
+			want[i * n + j] = known && reach(R, i, j, k);
+	for ( int pass = 0; pass < 2; ++pass ) {
+		const char* what = pass == 0 ? "const connected" : "connected";
+		std::vector<size_t> id (n);
+		for ( int i = 0; i < n; ++i ) {
+			if ( pass == 0 )
+				id[i] = k < 0 ? c.component(i) : c.component(i, key);
+			else
+				id[i] = k < 0 ? g.component(i) : g.component(i, key);
+			if ( (id[i] == G::NO_INDEX) != (!tracked || !want[i * n + i]) )
+				fail("component in graph", round, "vertex", i);
+		}
+		for ( int i = 0; i < n; ++i ) {
+			for ( int j = 0; j < n; ++j ) {
+				bool got = pass == 0
+					? (k < 0 ? c.connected(i, j) : c.connected(i, j, key))
+					: (k < 0 ? g.connected(i, j) : g.connected(i, j, key));
+				if ( got != (bool)want[i * n + j] )
+					fail(what, round, "vertex", i);
+				if ( id[i] != G::NO_INDEX
+						&& (id[i] == id[j]) != (bool)want[i * n + j] )
+					fail("component", round, "vertex", i);
+			}
+		}
+	}
+	if ( g.tracks_components() != tracked )
+		fail("tracking started", round, "key", k);
+}
+
+template <class G>
+void ask_all ( G& g, const Rels& R, int n, size_t round )
+{
+	for ( int k = -1; k < KEYS; ++k ) ask(g, R, n, k, round);
+}
+
+// A path of "k1" relationships through n vertices, cut between its
+// middle vertices: the component splits in two, and each half stays
+// whole.
+template <class G>
+void split ( G& g, Rels& R, int n, size_t round )
+{
+	for ( int i = 0; i + 1 < n; ++i ) {
+		g.set_dir(i, i + 1, key_name(1), 1);
+		R.insert(std::make_tuple(i, i + 1, 1));
+	}
+	ask_all(g, R, n, round);
+	g.clear_dir(n / 2 - 1, n / 2, key_name(1));
+	R.erase(std::make_tuple(n / 2 - 1, n / 2, 1));
+	ask_all(g, R, n, round);
+	if ( g.tracks_components() && g.component(0, key_name(1))
+			== g.component(n - 1, key_name(1)) )
+		fail("split", round, "key", 1);
+}
+
+// Random changes to g beside R, asking about every pair now and then.
+template <class G>
+void change ( G& g, Rels& R, int n, size_t round, std::mt19937& rng )
+{
+	for ( size_t step = 0; step < 150; ++step ) {
+		int i = rng() % n, j = rng() % n, k = rng() % KEYS;
+		int what = rng() % 10;
+		if ( what < 6 ) {
+			g.set_dir(i, j, key_name(k), 1);
+			R.insert(std::make_tuple(i, j, k));
+		}
+		else if ( what < 9 ) {
+			g.clear_dir(i, j, key_name(k));
+			R.erase(std::make_tuple(i, j, k));
+		}
+		else {
+			g.clear(i);
+			for ( Rels::iterator it = R.begin(); it != R.end(); ) {
+				if ( std::get<0>(*it) == i || std::get<1>(*it) == i )
+					R.erase(it++);
+				else
+					++it;
+			}
+		}
+		if ( step % 25 == 24 ) ask_all(g, R, n, round);
+		if ( bygis::check::too_many() ) return;
+	}
+}
+
+template <class G>
+void check ( size_t rounds, std::mt19937& rng )
+{
+	for ( size_t round = 0; round < rounds; ++round ) {
+		G g (true);
+		if ( rng() % 2 == 0 ) g.index_keys();
+		if ( round % 3 != 0 ) g.track_components();
+		Rels R;
+		int n = 4 + rng() % 16;
+		split(g, R, n, round);
+		change(g, R, n, round, rng);
+		if ( bygis::check::too_many() ) return;
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 200);
+	std::mt19937 rng (1);
+	check<bygis::Graph>(rounds, rng);
+	check<bygis::HashGraph>(rounds / 2, rng);
+	return bygis::check::finish();
+}
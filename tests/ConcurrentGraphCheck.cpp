@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that changes made to a ConcurrentGraph by many threads   //
+// at once leave it as the same changes made one at a time to a    //
+// Graph. Each thread sets and clears relationships, with keys it  //
+// may be first to use, between pairs of vertices that no other    //
+// thread changes, while its vertices are shared with every other  //
+// thread and a reader queries the graph; the Graph replays each   //
+// thread's changes in its order. A round is one run per thread    //
+// count (100 by default; see Check.hpp). Build with               //
+// -fsanitize=thread as well to look for data races.               //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - moved to tests/, with what the checks share in Check.hpp.     //
+// - renamed apply and read, which clash with std::apply and read. //
+/////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentGraph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+// one change: set (with value x) or clear (x unused), directed or not,
+// or either way as the graph is
+struct Change {
+	int i, j;
+	std::string key;
+	bool set;
+	int how;                 // 0 as the graph is, 1 directed, 2 undirected
+	float x;
+};
+
+typedef std::vector<Change> Log;
+
+// m changes for thread t of threads, between n vertices: only pairs
+// {i, j} with (i + j) % threads == t, so that no two threads change the
+// same relationships, though they share every vertex.
+Log changes ( size_t t, size_t threads, int n, size_t m, std::mt19937& rng )
+{
+	std::uniform_int_distribution<int> v (0, n - 1);
+	Log L;
+	while ( L.size() < m ) {
+		Change c;
+		c.i = v(rng);
+		c.j = v(rng);
+		if ( (size_t)(c.i + c.j) % threads != t ) continue;
+		int k = rng() % 5;
+		c.key = k == 0 ? "" : "k" + std::to_string(k);
+		c.set = rng() % 3 != 0;
+		c.how = rng() % 3;
+		c.x = (float)(1 + rng() % 9);
+		L.push_back(c);
+	}
+	return L;
+}
+
+template <class GraphT>
+void make_change ( GraphT& G, const Change& c )
+{
+	if ( c.set ) {
+		if ( c.how == 0 ) G.set(c.i, c.j, c.key, c.x);
+		else if ( c.how == 1 ) G.set_dir(c.i, c.j, c.key, c.x);
+		else G.set_undir(c.i, c.j, c.key, c.x);
+	}
+	else {
+		if ( c.how == 0 ) G.clear(c.i, c.j, c.key);
+		else if ( c.how == 1 ) G.clear_dir(c.i, c.j, c.key);
+		else G.clear_undir(c.i, c.j, c.key);
+	}
+}
+
+// Query g at random until done, so that queries run beside changes.
+void query ( const bygis::ConcurrentGraph& g, int n,
+	const std::atomic<bool>& done )
+{
+	std::mt19937 rng (7);
+	size_t seen = 0;
+	while ( !done.load() ) {
+		int i = rng() % n, j = rng() % n;
+		seen += g.nbrs(i).size() + g.nbrs_from(i, std::string("k1")).size();
+		seen += g.contains(i, j) + (g.get(i, j, std::string("k2")) != 0);
+		seen += g.size() + g.num_edges();
+	}
+	if ( seen == (size_t)-1 ) std::printf("\n");
+}
+
+// True if g and h hold the same relationships; also compares what each
+// has for every pair and key.
+bool same ( const bygis::Graph& g, const bygis::Graph& h, int n )
+{
+	if ( g.size() != h.size() || g.num_edges() != h.num_edges() || g != h )
+		return false;
+	for ( int i = 0; i < n; ++i ) {
+		for ( int j = 0; j < n; ++j ) {
+			for ( int k = 0; k < 5; ++k ) {
+				std::string key = k == 0 ? "" : "k" + std::to_string(k);
+				if ( g.get(i, j, key) != h.get(i, j, key) ) return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 100);
+	std::mt19937 rng (1);
+	for ( size_t threads = 1; threads <= 4; ++threads ) {
+		for ( size_t round = 0; round < rounds; ++round ) {
+			int n = 4 + rng() % 40;
+			bool dir = rng() % 2 == 0;
+
+			// start from a graph of random relationships, or none
+			bygis::Graph want (dir);
+			if ( rng() % 2 == 0 ) {
+				Log L = changes(0, 1, n, rng() % 100, rng);
+				for ( size_t c = 0; c < L.size(); ++c ) make_change(want, L[c]);
+			}
+			bygis::ConcurrentGraph got (want, 1 + rng() % 8);
+
+			std::vector<Log> logs;
+			for ( size_t t = 0; t < threads; ++t )
+				logs.push_back(changes(t, threads, n, 2000, rng));
+			std::atomic<bool> done (false);
+			std::thread reader (query, std::cref(got), n, std::cref(done));
+			std::vector<std::thread> T;
+			for ( size_t t = 0; t < threads; ++t ) {
+				T.push_back(std::thread([&, t] {
+					for ( size_t c = 0; c < logs[t].size(); ++c )
+						make_change(got, logs[t][c]);
+				}));
+			}
+			for ( size_t t = 0; t < threads; ++t ) T[t].join();
+			done.store(true);
+			reader.join();
+
+			for ( size_t t = 0; t < threads; ++t )
+				for ( size_t c = 0; c < logs[t].size(); ++c )
+					make_change(want, logs[t][c]);
+			if ( !same(got.graph(), want, n) )
+				fail("graph", round, "threads", threads);
+
+			// and removing vertices, one thread at a time
+			int i = rng() % n;
+			got.clear(i);
+			want.clear(i);
+			if ( !same(got.graph(), want, n) )
+				fail("clear", round, "threads", threads);
+		}
+	}
+	return bygis::check::finish();
+}
@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that CsrGraph::from_edge_list, the parallel build, makes //
+// the same snapshot as CsrGraph(Graph::from_edge_list(...)) for   //
+// the same Edge records: random batches with repeated,            //
+// undirected, self, and no_relationship records, built on 1 to 4  //
+// threads. A round is one batch per thread count (200 by          //
+// default; see Check.hpp).                                        //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - moved to tests/, with what the checks share in Check.hpp.     //
+/////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <string>
+#include <vector>
+#include "CsrGraph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+typedef std::vector<bygis::Graph::Edge> Edges;
+
+// m records between n vertices, with k keys; about a fifth are
+// undirected and a tenth remove a relationship.
+Edges batch ( int n, size_t m, int k, std::mt19937& rng )
+{
+	std::uniform_int_distribution<int> v (-n / 4, n - 1);
+	std::uniform_int_distribution<int> key (0, k - 1);
+	std::uniform_int_distribution<int> pct (0, 99);
+	Edges E;
+	E.reserve(m);
+	for ( size_t e = 0; e < m; ++e ) {
+		int p = pct(rng);
+		float x = p < 10 ? 0 : (float)(1 + pct(rng) % 5);
+		int c = key(rng);
+		std::string name = c == 0 ? "" : "k" + std::to_string(c);
+		E.push_back(bygis::Graph::Edge(v(rng), v(rng), name, p >= 80, x));
+	}
+	return E;
+}
+
+// True if a and b hold the same rows, keys, and arrays.
+bool same ( const bygis::CsrGraph& a, const bygis::CsrGraph& b )
+{
+	if ( a.directed != b.directed || a.no_relationship != b.no_relationship
+			|| a.size() != b.size() || a.num_out() != b.num_out()
+			|| a.num_in() != b.num_in() || a.num_keys() != b.num_keys() )
+		return false;
+	for ( size_t k = 0; k < a.num_keys(); ++k ) {
+		if ( a.key_name(bygis::KeyID(k)) != b.key_name(bygis::KeyID(k)) )
+			return false;
+	}
+	for ( size_t r = 0; r < a.size(); ++r ) {
+		if ( a.vertex(r) != b.vertex(r)
+				|| a.out_begin(r) != b.out_begin(r)
+				|| a.out_end(r) != b.out_end(r)
+				|| a.in_begin(r) != b.in_begin(r)
+				|| a.in_end(r) != b.in_end(r) )
+			return false;
+	}
+	for ( size_t e = 0; e < a.num_out(); ++e ) {
+		if ( a.out_nbr(e) != b.out_nbr(e) || a.out_key(e) != b.out_key(e)
+				|| a.out_val(e) != b.out_val(e)
+				|| a.in_nbr(e) != b.in_nbr(e) || a.in_key(e) != b.in_key(e)
+				|| a.in_val(e) != b.in_val(e) )
+			return false;
+	}
+	return true;
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 200);
+	std::mt19937 rng (1);
+	for ( size_t threads = 1; threads <= 4; ++threads ) {
+		bygis::ThreadPool pool (threads);
+		for ( size_t round = 0; round < rounds; ++round ) {
+			int n = 1 + rng() % 200;
+			Edges E = batch(n, rng() % 1000, 1 + rng() % 4, rng);
+			bool dir = rng() % 2 == 0;
+			bygis::CsrGraph want (
+				bygis::Graph::from_edge_list(E.begin(), E.end(), dir));
+			bygis::CsrGraph got = bygis::CsrGraph::from_edge_list(
+				E.begin(), E.end(), pool, dir);
+			if ( !same(got, want) ) fail("from_edge_list", round, "threads", threads);
+		}
+	}
+	return bygis::check::finish();
+}
@@ -0,0 +1,191 @@
+/////////////////////////////////////////////////////////////////////
+// Checks the dense vertex indices of a numbered Graph: random     //
+// graphs numbered in their own order or a given one, then changed //
+// at random (relationships set and cleared, vertices removed, and //
+// edges applied in bulk) and copied. After every few changes,     //
+// index and vertex must be inverse on 0..size()-1 and cover the   //
+// vertices, and the index visitors must visit the indices of what //
+// the ID queries return. A round is one graph (200 by default;    //
+// see Check.hpp).                                                 //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+typedef std::set<std::tuple<int, int, float> > Arcs;
+
+std::string key_name ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+// Visitors that collect what they are given, by ID.
+template <class G>
+struct Ids {
+	const G* g;
+	std::set<int>* out;
+	void operator() ( size_t s ) const { out->insert(g->vertex(s)); }
+};
+
+template <class G>
+struct IdArcs {
+	const G* g;
+	Arcs* out;
+	void operator() ( size_t r, size_t s, float x ) const
+	{
+		out->insert(std::make_tuple(g->vertex(r), g->vertex(s), x));
+	}
+};
+
+struct Collect {
+	Arcs* out;
+	void operator() ( int i, int j, float x ) const
+	{
+		out->insert(std::make_tuple(i, j, x));
+	}
+};
+
+// Compare the indices of g with its IDs, for vertices from -3 to n - 2
+// and k keys.
+template <class G>
+void compare ( const G& g, int n, int k, size_t round )
+{
+	if ( !g.numbered() ) fail("numbered", round, "vertex", 0);
+	std::set<int> seen;
+	for ( size_t r = 0; r < g.size(); ++r ) {
+		seen.insert(g.vertex(r));
+		if ( g.index(g.vertex(r)) != r ) fail("index", round, "index", r);
+	}
+	if ( seen != g.vertices() ) fail("vertex", round, "vertex", 0);
+	for ( int i = -3; i < n - 1; ++i )
+		if ( !seen.count(i) && g.index(i) != G::NO_INDEX )
+			fail("index of missing", round, "vertex", i);
+
+	for ( size_t r = 0; r < g.size(); ++r ) {
+		int i = g.vertex(r);
+		std::set<int> nb, to, from;
+		Ids<G> a = { &g, &nb }, b = { &g, &to }, c = { &g, &from };
+		g.for_each_nbr_index(r, a);
+		g.for_each_nbr_to_index(r, b);
+		g.for_each_nbr_from_index(r, c);
+		if ( nb != g.nbrs(i) || to != g.nbrs_to(i) || from != g.nbrs_from(i) )
+			fail("nbrs", round, "vertex", i);
+		for ( int q = 0; q < k; ++q ) {
+			std::string key = key_name(q);
+			nb.clear();
+			to.clear();
+			from.clear();
+			g.for_each_nbr_index(r, key, a);
+			g.for_each_nbr_to_index(r, key, b);
+			g.for_each_nbr_from_index(r, key, c);
+			if ( nb != g.nbrs(i, key) || to != g.nbrs_to(i, key)
+					|| from != g.nbrs_from(i, key) )
+				fail("nbrs by key", round, "vertex", i);
+		}
+	}
+	for ( int q = 0; q < k; ++q ) {
+		Arcs want, got;
+		Collect c = { &want };
+		IdArcs<G> a = { &g, &got };
+		g.for_each_edge(key_name(q), c);
+		g.for_each_edge_index(key_name(q), a);
+		if ( got != want ) fail("for_each_edge_index", round, "key", q);
+	}
+}
+
+// One random change to g, between n vertices with k keys.
+template <class G>
+void change ( G& g, int n, int k, std::mt19937& rng )
+{
+	int i = rng() % n - 2, j = rng() % n - 2;
+	std::string key = key_name(rng() % k);
+	switch ( rng() % 10 ) {
+	case 0:
+		g.clear(i);
+		break;
+	case 1:
+	case 2:
+		g.clear(i, j, key, rng() % 2 == 0);
+		break;
+	case 3: {
+		std::vector<typename G::Edge> E;
+		for ( size_t e = rng() % 10; e > 0; --e ) {
+			E.push_back(typename G::Edge(rng() % n - 2, rng() % n - 2,
+				key_name(rng() % k), rng() % 2 == 0, (float)(rng() % 4)));
+		}
+		g.apply_edges(E.begin(), E.end());
+		break;
+	}
+	default:
+		g.set(i, j, key, rng() % 3 == 0, (float)(1 + rng() % 5));
+		break;
+	}
+}
+
+template <class G>
+void check ( size_t rounds, std::mt19937& rng )
+{
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 40, k = 1 + rng() % 3;
+		G g (rng() % 2 == 0);
+		for ( size_t m = rng() % 60; m > 0; --m ) change(g, n, k, rng);
+		if ( rng() % 2 == 0 ) {
+			g.number_vertices();
+		}
+		else {
+			// a given order, with repeats and IDs not in the graph
+			std::vector<int> order;
+			for ( size_t m = rng() % (n + 4); m > 0; --m )
+				order.push_back(rng() % (n + 4) - 4);
+			g.number_vertices(order);
+			std::vector<int> want;
+			for ( size_t t = 0; t < order.size(); ++t ) {
+				if ( g.contains_undir(order[t])
+						&& std::find(want.begin(), want.end(), order[t])
+							== want.end() )
+					want.push_back(order[t]);
+			}
+			for ( size_t r = 0; r < want.size(); ++r )
+				if ( g.vertex(r) != want[r] ) fail("order", round, "index", r);
+		}
+		compare(g, n, k, round);
+		for ( size_t step = 0; step < 100; ++step ) {
+			change(g, n, k, rng);
+			if ( step % 20 == 19 ) compare(g, n, k, round);
+		}
+		G h (g);
+		compare(h, n, k, round);
+		g.number_vertices(false);
+		if ( g.numbered() || (g.size() > 0
+				&& g.index(*g.vertices().begin()) != G::NO_INDEX) )
+			fail("number_vertices(false)", round, "vertex", 0);
+		if ( bygis::check::too_many() ) return;
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 200);
+	std::mt19937 rng (1);
+	check<bygis::Graph>(rounds, rng);
+	check<bygis::HashGraph>(rounds / 2, rng);
+	return bygis::check::finish();
+}
@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that a GraphFork answers every query as a Graph given    //
+// the same changes: a family of forks of a random snapshot, each  //
+// changed at random (relationships set and cleared, by key and    //
+// not, and vertices removed) and forked again beside a copy of    //
+// the Graph, so that forks share the rows of their parents. Every //
+// fork is queried for each vertex and pair of vertices after the  //
+// others have changed, to find a shared row that changed under    //
+// it. A round is one snapshot (100 by default; see Check.hpp).    //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <string>
+#include <vector>
+#include "GraphFork.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+std::string key_name ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+// Make one random change between n vertices with k keys to both f and
+// g.
+void change ( bygis::GraphFork& f, bygis::Graph& g, int n, int k,
+	std::mt19937& rng )
+{
+	int i = rng() % n - 2, j = rng() % n - 2;
+	std::string key = key_name(rng() % k);
+	bool undir = rng() % 3 == 0;
+	float x = (float)(rng() % 6);             // 0 is no_relationship
+	switch ( rng() % 8 ) {
+	case 0:
+		f.clear(i, j, key, undir);
+		g.clear(i, j, key, undir);
+		break;
+	case 1:
+		f.clear(i, j);
+		g.clear(i, j);
+		break;
+	case 2:
+		f.clear(i, key);
+		g.clear(i, key);
+		break;
+	case 3:
+		f.clear(i);
+		g.clear(i);
+		break;
+	default:
+		f.set(i, j, key, undir, x);
+		g.set(i, j, key, undir, x);
+		break;
+	}
+}
+
+// Compare every query of f with g, for vertices from -3 to n - 2 and
+// k keys and one that neither has.
+void compare ( const bygis::GraphFork& f, const bygis::Graph& g, int n,
+	int k, size_t round )
+{
+	if ( f.size() != g.size() || f.num_edges() != g.num_edges() )
+		fail("counts", round, "vertex", 0);
+	if ( f.vertices() != g.vertices() ) fail("vertices", round, "vertex", 0);
+	if ( f.keys() != g.keys() ) fail("keys", round, "vertex", 0);
+	if ( f.thaw() != g ) fail("thaw", round, "vertex", 0);
+	for ( int i = -3; i < n - 1; ++i ) {
+		if ( f.nbrs(i) != g.nbrs(i) || f.nbrs_to(i) != g.nbrs_to(i)
+				|| f.nbrs_from(i) != g.nbrs_from(i) || f.keys(i) != g.keys(i)
+				|| f.contains(i) != g.contains(i)
+				|| f.contains_undir(i) != g.contains_undir(i) )
+			fail("vertex", round, "vertex", i);
+		for ( int c = 0; c <= k; ++c ) {
+			std::string key = key_name(c);
+			if ( f.nbrs(i, key) != g.nbrs(i, key)
+					|| f.nbrs_to(i, key) != g.nbrs_to(i, key)
+					|| f.nbrs_from(i, key) != g.nbrs_from(i, key) )
+				fail("vertex by key", round, "vertex", i);
+		}
+		for ( int j = -3; j < n - 1; ++j ) {
+			if ( f.get(i, j) != g.get(i, j) || f.keys(i, j) != g.keys(i, j)
+					|| f.contains_dir(i, j) != g.contains_dir(i, j)
+					|| f.contains_undir(i, j) != g.contains_undir(i, j) )
+				fail("pair", round, "vertex", i);
+			for ( int c = 0; c <= k; ++c ) {
+				std::string key = key_name(c);
+				if ( f.get(i, j, key) != g.get(i, j, key)
+						|| f.contains(i, j, key) != g.contains(i, j, key)
+						|| f.contains_dir(i, j, key)
+							!= g.contains_dir(i, j, key)
+						|| f.contains_undir(i, j, key)
+							!= g.contains_undir(i, j, key) )
+					fail("pair by key", round, "vertex", i);
+			}
+		}
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 100);
+	std::mt19937 rng (1);
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 30, k = 1 + rng() % 3;
+		bygis::Graph base (rng() % 2 == 0);
+		for ( size_t m = rng() % 150; m > 0; --m ) {
+			base.set(rng() % n - 2, rng() % n - 2, key_name(rng() % k),
+				rng() % 3 == 0, (float)(1 + rng() % 5));
+		}
+
+		// forks and the graphs they stand for, in turn
+		std::vector<bygis::GraphFork> F (1, bygis::GraphFork(base));
+		std::vector<bygis::Graph> G (1, base);
+		for ( size_t step = 0; step < 200; ++step ) {
+			size_t t = rng() % F.size();
+			if ( rng() % 20 == 0 && F.size() < 8 ) {
+				F.push_back(F[t].fork());
+				G.push_back(G[t]);
+			}
+			else {
+				change(F[t], G[t], n, k, rng);
+			}
+		}
+		for ( size_t t = 0; t < F.size(); ++t )
+			compare(F[t], G[t], n, k, round);
+		if ( bygis::check::too_many() ) break;
+	}
+	return bygis::check::finish();
+}
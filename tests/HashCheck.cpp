@@ -0,0 +1,165 @@
+/////////////////////////////////////////////////////////////////////
+// Checks hash, ==, and diff against the relationships the graphs  //
+// hold: random graphs, each built again in bulk, with keys        //
+// interned in another order, and with hashed maps, which must be  //
+// equal to it and hash the same; and changed a little, given one  //
+// more relationship, or made with other settings, which must be   //
+// equal only if their relationships and settings are. diff must   //
+// turn each graph into the other, and a graph changed and changed //
+// back by diff must hash as before. Hashes of graphs that differ  //
+// by one relationship must rarely agree. A round is one graph     //
+// (300 by default; see Check.hpp).                                //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+typedef bygis::Graph::Edge Edge;
+
+// a relationship from i toward j: (i, j, key, x)
+typedef std::set<std::tuple<int, int, std::string, float> > Arcs;
+
+std::string key_name ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+struct Collect {
+	Arcs* out;
+	std::string key;
+	void operator() ( int i, int j, float x ) const
+	{
+		out->insert(std::make_tuple(i, j, key, x));
+	}
+};
+
+// Every relationship of g, from i toward j.
+template <class G>
+Arcs arcs ( const G& g )
+{
+	Arcs A;
+	std::set<std::string> K = g.keys();
+	std::set<std::string>::const_iterator kt = K.begin();
+	for ( ; kt != K.end(); ++kt ) {
+		Collect c = { &A, *kt };
+		g.for_each_edge(*kt, c);
+	}
+	return A;
+}
+
+// m random records between n vertices with k keys; about a fifth
+// remove a relationship.
+std::vector<Edge> records ( int n, size_t m, int k, std::mt19937& rng )
+{
+	std::vector<Edge> E;
+	for ( size_t e = 0; e < m; ++e ) {
+		float x = rng() % 5 == 0 ? 0 : (float)(1 + rng() % 5);
+		E.push_back(Edge(rng() % n - 2, rng() % n - 2, key_name(rng() % k),
+			rng() % 3 == 0, x));
+	}
+	return E;
+}
+
+template <class G>
+void set_all ( G& g, const std::vector<Edge>& E )
+{
+	for ( size_t e = 0; e < E.size(); ++e )
+		g.set(E[e].i, E[e].j, E[e].key, E[e].undir, E[e].x);
+}
+
+// Check g against h: they must be equal exactly when they have the
+// same relationships and settings, and hash the same if they are;
+// g.diff(h) must be empty if they are, and turn g's relationships
+// into h's.
+void compare ( const bygis::Graph& g, const bygis::Graph& h, size_t round,
+	long what )
+{
+	bool want = g.directed == h.directed
+		&& g.no_relationship == h.no_relationship && arcs(g) == arcs(h);
+	if ( (g == h) != want || (h == g) != want || (g != h) == want )
+		fail("==", round, "case", what);
+	if ( want && g.hash() != h.hash() ) fail("hash", round, "case", what);
+	std::vector<Edge> D = g.diff(h);
+	if ( want && !D.empty() ) fail("diff empty", round, "case", what);
+	for ( size_t d = 0; d < D.size(); ++d )
+		if ( D[d].undir ) fail("diff undir", round, "case", what);
+	bygis::Graph t (g);
+	t.apply_edges(D.begin(), D.end());
+	if ( arcs(t) != arcs(h) ) fail("diff", round, "case", what);
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 300);
+	std::mt19937 rng (1);
+	size_t collisions = 0;
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 30, k = 1 + rng() % 4;
+		bool dir = rng() % 2 == 0;
+		std::vector<Edge> E = records(n, rng() % 200, k, rng);
+		bygis::Graph g (dir);
+		set_all(g, E);
+
+		// the same relationships, built another way: in bulk, with keys
+		// interned in another order, and with hashed maps
+		bygis::Graph h (dir);
+		for ( int c = k - 1; c >= 0; --c ) h.intern(key_name(c));
+		h.apply_edges(E.begin(), E.end());
+		compare(g, h, round, 0);
+		bygis::HashGraph s (dir);
+		set_all(s, E);
+		if ( s.hash() != g.hash() || bygis::Graph(s) != g || arcs(s) != arcs(g) )
+			fail("hashed maps", round, "case", 0);
+
+		// changed, then changed back
+		if ( !g.diff(g).empty() ) fail("diff with itself", round, "case", 1);
+		bygis::Graph d (g);
+		set_all(d, records(n, 1 + rng() % 5, k, rng));
+		compare(g, d, round, 2);
+		compare(d, g, round, 3);
+		std::vector<Edge> back = d.diff(g);
+		d.apply_edges(back.begin(), back.end());
+		if ( d.hash() != g.hash() || d != g )
+			fail("changed back", round, "case", 3);
+
+		// one more relationship, and different settings
+		bygis::Graph e (g);
+		e.set_dir(n, n + 1, key_name(rng() % k), 1);
+		compare(g, e, round, 4);
+		if ( e.hash() == g.hash() ) ++collisions;
+		bygis::Graph u (!dir);
+		set_all(u, E);
+		compare(g, u, round, 5);
+		bygis::Graph v (dir, -1);
+		for ( size_t r = 0; r < E.size(); ++r ) {
+			const Edge& t = E[r];
+			v.set(t.i, t.j, t.key, t.undir, t.x == 0 ? -1 : t.x);
+		}
+		if ( arcs(v) != arcs(g) )
+			fail("no_relationship arcs", round, "case", 6);
+		compare(g, v, round, 6);
+		if ( v.hash() == g.hash() ) fail("no_relationship", round, "case", 6);
+		if ( bygis::check::too_many() ) break;
+	}
+	if ( collisions > rounds / 100 )
+		fail("hash collisions", rounds, "count", collisions);
+	return bygis::check::finish();
+}
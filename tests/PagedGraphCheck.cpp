@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that a PagedGraph answers every query as the CsrGraph it //
+// was written from: random graphs, written in blocks of 1 to 20   //
+// rows and read through caches of a few blocks, queried for each  //
+// vertex and pair of vertices. Also checks that a block whose     //
+// IDs, offsets, or keys have been damaged in the file is not      //
+// used, while the other blocks still are. A round is one graph    //
+// (100 by default; see Check.hpp). The files are written to       //
+// PagedGraphCheck.tmp, in the working directory.                  //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - moved to tests/, with what the checks share in Check.hpp.     //
+/////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "PagedGraph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+typedef std::tuple<int, int, unsigned int, float> Arc;
+
+const char* PATH = "PagedGraphCheck.tmp";
+
+// Count a failure of what at vertex i.
+void fail ( const char* what, size_t round, int i )
+{
+	bygis::check::fail(what, round, "vertex", i);
+}
+
+// A graph of about m relationships between n vertices, some negative,
+// with k keys.
+bygis::Graph random_graph ( int n, size_t m, int k, std::mt19937& rng )
+{
+	std::uniform_int_distribution<int> v (-n / 4, n - 1);
+	bygis::Graph G (rng() % 2 == 0);
+	for ( size_t e = 0; e < m; ++e ) {
+		int c = rng() % k;
+		std::string key = c == 0 ? "" : "k" + std::to_string(c);
+		float x = (float)(1 + rng() % 9);
+		if ( rng() % 4 == 0 ) G.set_undir(v(rng), v(rng), key, x);
+		else G.set_dir(v(rng), v(rng), key, x);
+	}
+	return G;
+}
+
+std::vector<Arc> arcs ( const bygis::CsrGraph& C )
+{
+	std::vector<Arc> A;
+	for ( size_t r = 0; r < C.size(); ++r ) {
+		for ( size_t e = C.out_begin(r); e < C.out_end(r); ++e )
+			A.push_back(Arc(C.vertex(r), C.vertex(C.out_nbr(e)),
+				C.out_key(e).id, C.out_val(e)));
+	}
+	return A;
+}
+
+std::vector<Arc> arcs ( const bygis::PagedGraph& P )
+{
+	std::vector<Arc> A;
+	P.for_each_edge([&A] ( int i, int j, bygis::KeyID k, float x ) {
+		A.push_back(Arc(i, j, k.id, x));
+	});
+	return A;
+}
+
+// Compare P with C for every vertex from lo to hi, and for the pairs
+// among them, with every key and one neither has.
+void compare ( const bygis::PagedGraph& P, const bygis::CsrGraph& C,
+	int lo, int hi, size_t round )
+{
+	if ( P.size() != C.size() || P.num_edges() != C.num_out()
+			|| P.num_keys() != C.num_keys() || P.directed != C.directed
+			|| P.no_relationship != C.no_relationship )
+		fail("counts", round, 0);
+	std::vector<std::string> keys (1, "none");
+	for ( size_t k = 0; k < C.num_keys(); ++k ) {
+		bygis::KeyID id (k);
+		if ( P.key_name(id) != C.key_name(id) ) fail("key_name", round, 0);
+		keys.push_back(C.key_name(id));
+	}
+	if ( P.vertices() != C.vertices() ) fail("vertices", round, 0);
+	if ( P.keys() != C.keys() ) fail("keys", round, 0);
+	if ( arcs(P) != arcs(C) ) fail("for_each_edge", round, 0);
+
+	for ( int i = lo; i <= hi; ++i ) {
+		if ( P.nbrs(i) != C.nbrs(i) || P.nbrs_to(i) != C.nbrs_to(i)
+				|| P.nbrs_from(i) != C.nbrs_from(i) )
+			fail("nbrs", round, i);
+		if ( P.keys(i) != C.keys(i) || P.contains(i) != C.contains(i)
+				|| P.contains_dir(i) != C.contains_dir(i)
+				|| P.contains_undir(i) != C.contains_undir(i) )
+			fail("vertex", round, i);
+		for ( size_t k = 0; k < keys.size(); ++k ) {
+			const std::string& key = keys[k];
+			if ( P.nbrs(i, key) != C.nbrs(i, key)
+					|| P.nbrs_to(i, key) != C.nbrs_to(i, key)
+					|| P.nbrs_from(i, key) != C.nbrs_from(i, key) )
+				fail("nbrs(key)", round, i);
+		}
+		for ( int j = lo; j <= hi; ++j ) {
+			if ( P.keys(i, j) != C.keys(i, j)
+					|| P.contains(i, j) != C.contains(i, j)
+					|| P.contains_dir(i, j) != C.contains_dir(i, j)
+					|| P.contains_undir(i, j) != C.contains_undir(i, j)
+					|| P.get(i, j) != C.get(i, j) )
+				fail("pair", round, i);
+			for ( size_t k = 0; k < keys.size(); ++k ) {
+				const std::string& key = keys[k];
+				if ( P.get(i, j, key) != C.get(i, j, key)
+						|| P.contains_dir(i, j, key) != C.contains_dir(i, j, key)
+						|| P.contains_undir(i, j, key)
+						!= C.contains_undir(i, j, key) )
+					fail("pair(key)", round, i);
+			}
+		}
+	}
+}
+
+// Read the file at PATH.
+std::vector<char> slurp ()
+{
+	std::vector<char> b;
+	FILE* f = std::fopen(PATH, "rb");
+	if ( f == 0 ) return b;
+	char buf[4096];
+	size_t got;
+	while ( (got = std::fread(buf, 1, sizeof(buf), f)) > 0 )
+		b.insert(b.end(), buf, buf + got);
+	std::fclose(f);
+	return b;
+}
+
+void spill ( const std::vector<char>& b )
+{
+	FILE* f = std::fopen(PATH, "wb");
+	if ( f == 0 ) return;
+	std::fwrite(b.data(), 1, b.size(), f);
+	std::fclose(f);
+}
+
+// Damage the first block of the file of C, written in blocks of rows
+// rows, in each of a few ways, and check that the file still opens
+// but that block's vertices are missing, and no others. Assumes the
+// writer's byte order is little-endian.
+void damage ( const bygis::CsrGraph& C, size_t rows, size_t round )
+{
+	std::vector<char> good = slurp();
+	rows = std::min(rows, C.size());
+	size_t out = C.out_begin(rows);
+	size_t ids = 88;                          // after the file's header
+	size_t out_off = ids + (4 * rows + 7) / 8 * 8;
+	size_t out_nbr = out_off + 8 * (rows + 1);
+	size_t out_key = out_nbr + (4 * out + 7) / 8 * 8;
+
+	std::vector<std::vector<char> > bad;
+	std::vector<char> b = good;
+	b[ids] ^= 1;                              // first ID not the index's
+	bad.push_back(b);
+	if ( rows > 1 ) {
+		b = good;                             // IDs out of order
+		std::copy(&b[ids], &b[ids] + 4, &b[ids + 4]);
+		bad.push_back(b);
+	}
+	b = good;
+	b[out_off + 15] = 0x40;                   // offset past the end
+	bad.push_back(b);
+	if ( out > 0 ) {
+		b = good;
+		b[out_key + 3] = 0x7f;                // key the graph lacks
+		bad.push_back(b);
+	}
+
+	std::set<int> rest = C.vertices();
+	for ( size_t r = 0; r < rows; ++r ) rest.erase(C.vertex(r));
+	for ( size_t d = 0; d < bad.size(); ++d ) {
+		spill(bad[d]);
+		bygis::PagedGraph P;
+		if ( !P.open(PATH) ) {
+			bygis::check::fail("open damaged", round, "damage", d);
+			continue;
+		}
+		if ( P.vertices() != rest )
+			bygis::check::fail("damaged block used", round, "damage", d);
+		for ( size_t r = 0; r < C.size(); ++r ) {
+			int i = C.vertex(r);
+			bool kept = r >= rows;
+			if ( P.contains_undir(i) != kept
+					|| (kept && P.nbrs(i) != C.nbrs(i)) )
+				fail("damaged block query", round, i);
+		}
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 100);
+	std::mt19937 rng (1);
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 60;
+		bygis::CsrGraph C (random_graph(n, rng() % 300, 1 + rng() % 4, rng));
+		size_t rows = 1 + rng() % 20;
+		if ( !bygis::PagedGraph::write(C, PATH, rows) ) {
+			fail("write", round, 0);
+			continue;
+		}
+		bygis::PagedGraph P;
+		if ( !P.open(PATH) ) {
+			fail("open", round, 0);
+			continue;
+		}
+		P.set_cache_bytes(rng() % 4096);
+		compare(P, C, -n / 4 - 2, n + 1, round);
+		if ( C.size() > 0 ) damage(C, rows, round);
+	}
+	std::remove(PATH);
+	return bygis::check::finish();
+}
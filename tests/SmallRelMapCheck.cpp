@@ -0,0 +1,233 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that SmallRelMap and SingleRelMap, which hold the        //
+// relationships between two vertices, behave as the std::map they //
+// replaced: random inserts, lookups, erases, copies, and moves on //
+// maps that hold 1, 2, or 4 entries in place and spill past them, //
+// compared after each step with a std::map given the same steps.  //
+// Also checks that all memory from the maps' allocators is given  //
+// back, and that maps which stay in place take none. A round is   //
+// one sequence of steps for each map (2000 by default; see        //
+// Check.hpp).                                                     //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+// - moved to tests/, with what the checks share in Check.hpp.     //
+/////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+typedef std::map<unsigned int, std::string> Ref;
+
+// An allocator that counts the entries it has out; copies share the
+// count, and allocators with different counts are not equal, so moves
+// between them copy the entries.
+template <class T>
+struct Counted {
+	typedef T value_type;
+	long* out;
+
+	explicit Counted ( long* n ) : out(n) {}
+	template <class U> Counted ( const Counted<U>& a ) : out(a.out) {}
+
+	T* allocate ( size_t n )
+	{
+		*out += (long)n;
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+	void deallocate ( T* p, size_t n )
+	{
+		*out -= (long)n;
+		::operator delete(p);
+	}
+	template <class U> bool operator== ( const Counted<U>& a ) const
+	{ return out == a.out; }
+	template <class U> bool operator!= ( const Counted<U>& a ) const
+	{ return out != a.out; }
+};
+
+// Key of the entry at it, or -1 at the end.
+template <class M, class It>
+long key_at ( const M& m, It it )
+{
+	return it == m.end() ? -1 : (long)it->first;
+}
+
+// True if m holds the entries of r, in the same order.
+template <class M>
+bool same ( const M& m, const Ref& r )
+{
+	if ( m.size() != r.size() ) return false;
+	typename M::const_iterator it = m.begin();
+	Ref::const_iterator rt = r.begin();
+	for ( ; rt != r.end(); ++it, ++rt ) {
+		if ( it == m.end() || it->first != rt->first
+				|| it->second != rt->second )
+			return false;
+	}
+	return it == m.end();
+}
+
+// Random steps on three maps with N entries in place, each beside a
+// std::map; keys run up to 3 * N, so the maps often spill. The first
+// two maps share an allocator and the third has its own.
+template <size_t N>
+void check_small ( size_t round, std::mt19937& rng )
+{
+	typedef bygis::SmallRelMap<std::string, N,
+		Counted<std::pair<unsigned int, std::string> > > Map;
+	long out[2] = { 0, 0 };
+	{
+		typename Map::allocator_type a (&out[0]), b (&out[1]);
+		Map m[3] = { Map(a), Map(a), Map(b) };
+		Ref r[3];
+		std::uniform_int_distribution<unsigned int> key (0, 3 * N);
+		for ( size_t step = 0; step < 200; ++step ) {
+			size_t s = rng() % 3, t = rng() % 3;
+			unsigned int k = key(rng);
+			std::string x = "v" + std::to_string(rng() % 100);
+			switch ( rng() % 12 ) {
+			case 0: case 1: case 2:
+				m[s][k] = x;
+				r[s][k] = x;
+				break;
+			case 3:
+				if ( key_at(m[s], m[s].emplace_hint(m[s].end(), k, x))
+						!= key_at(r[s], r[s].emplace_hint(r[s].end(), k, x)) )
+					fail("emplace_hint", round, "step", step);
+				break;
+			case 4:
+				if ( key_at(m[s], m[s].find(k)) != key_at(r[s], r[s].find(k))
+						|| key_at(m[s], m[s].lower_bound(k))
+						!= key_at(r[s], r[s].lower_bound(k))
+						|| key_at(m[s], m[s].upper_bound(k))
+						!= key_at(r[s], r[s].upper_bound(k)) )
+					fail("find", round, "step", step);
+				break;
+			case 5: case 6:
+				if ( m[s].erase(k) != r[s].erase(k) )
+					fail("erase(key)", round, "step", step);
+				break;
+			case 7:
+				if ( r[s].empty() ) break;
+				k = r[s].begin()->first;
+				if ( key_at(m[s], m[s].erase(m[s].find(k)))
+						!= key_at(r[s], r[s].erase(r[s].find(k))) )
+					fail("erase(iterator)", round, "step", step);
+				break;
+			case 8:
+				if ( rng() % 4 == 0 ) {
+					m[s].clear();
+					r[s].clear();
+				}
+				break;
+			case 9:
+				m[s] = m[t];
+				r[s] = r[t];
+				break;
+			case 10: {
+				Map c (m[t]);
+				m[s] = std::move(c);
+				r[s] = r[t];
+				if ( !c.empty() ) fail("move from", round, "step", step);
+				break;
+			}
+			case 11: {
+				Map c (std::move(m[t]), m[s].get_allocator());
+				if ( !m[t].empty() ) fail("move from", round, "step", step);
+				m[t] = c;
+				break;
+			}
+			}
+			for ( size_t u = 0; u < 3; ++u )
+				if ( !same(m[u], r[u]) ) fail("entries", round, "step", step);
+			if ( bygis::check::too_many() ) return;
+		}
+	}
+	if ( out[0] != 0 || out[1] != 0 )
+		fail("memory given back", round, "step", 0);
+
+	// a map that never holds more than N entries takes no memory
+	{
+		typename Map::allocator_type a (&out[0]);
+		Map m (a);
+		for ( unsigned int k = 0; k < 4 * N; ++k ) {
+			if ( m.size() == N ) m.erase(m.begin());
+			m[k] = "x";
+		}
+		if ( out[0] != 0 ) fail("in place", round, "step", 0);
+	}
+}
+
+// Random steps on a SingleRelMap beside a std::map, with key 0 (the
+// one a graph with NoKey keys uses) and key 1 (never found).
+void check_single ( size_t round, std::mt19937& rng )
+{
+	typedef bygis::SingleRelMap<std::string> Map;
+	Map m;
+	Ref r;
+	for ( size_t step = 0; step < 50; ++step ) {
+		unsigned int k = rng() % 4 == 0 ? 1 : 0;
+		std::string x = "v" + std::to_string(rng() % 100);
+		switch ( rng() % 6 ) {
+		case 0:
+			if ( k == 0 ) {
+				m[k] = x;
+				r[k] = x;
+			}
+			break;
+		case 1:
+			if ( k == 0 && key_at(m, m.emplace_hint(m.end(), k, x))
+					!= key_at(r, r.emplace_hint(r.end(), k, x)) )
+				fail("single emplace_hint", round, "step", step);
+			break;
+		case 2:
+			if ( key_at(m, m.find(k)) != key_at(r, r.find(k))
+					|| key_at(m, m.upper_bound(0)) != key_at(r, r.upper_bound(0)) )
+				fail("single find", round, "step", step);
+			break;
+		case 3:
+			if ( m.erase(k) != r.erase(k) )
+				fail("single erase", round, "step", step);
+			break;
+		case 4:
+			if ( r.empty() ) break;
+			if ( key_at(m, m.erase(m.begin())) != key_at(r, r.erase(r.begin())) )
+				fail("single erase(iterator)", round, "step", step);
+			break;
+		case 5: {
+			Map c (m);
+			m = Map();
+			m = c;
+			break;
+		}
+		}
+		if ( !same(m, r) ) fail("single entries", round, "step", step);
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 2000);
+	std::mt19937 rng (1);
+	for ( size_t round = 0; round < rounds && !bygis::check::too_many(); ++round ) {
+		check_small<1>(round, rng);
+		check_small<2>(round, rng);
+		check_small<4>(round, rng);
+		check_single(round, rng);
+	}
+	return bygis::check::finish();
+}
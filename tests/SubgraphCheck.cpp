@@ -0,0 +1,183 @@
+/////////////////////////////////////////////////////////////////////
+// Checks subgraph, filter_key, and filter against graphs built a  //
+// relationship at a time from the same selection: random graphs,  //
+// with and without the key index, and random sets of vertices,    //
+// keys, and predicates. The copies must also keep the settings    //
+// and KeyIDs of the graph, and the graph must not change. A round //
+// is one graph (300 by default; see Check.hpp).                   //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <random>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+// a relationship from i toward j: (i, j, key, x)
+typedef std::tuple<int, int, std::string, float> Arc;
+
+std::string key_name ( int k )
+{
+	return k == 0 ? "" : "k" + std::to_string(k);
+}
+
+struct Collect {
+	std::vector<Arc>* out;
+	std::string key;
+	void operator() ( int i, int j, float x ) const
+	{
+		out->push_back(Arc(i, j, key, x));
+	}
+};
+
+// Every relationship of g, from i toward j.
+template <class G>
+std::vector<Arc> arcs ( const G& g )
+{
+	std::vector<Arc> A;
+	std::set<std::string> K = g.keys();
+	std::set<std::string>::const_iterator kt = K.begin();
+	for ( ; kt != K.end(); ++kt ) {
+		Collect c = { &A, *kt };
+		g.for_each_edge(*kt, c);
+	}
+	return A;
+}
+
+// A graph with g's settings and KeyIDs, and the given relationships.
+template <class G>
+G build ( const G& g, const std::vector<Arc>& A )
+{
+	G h (g.directed, g.no_relationship);
+	for ( size_t k = 0; k < g.num_keys(); ++k )
+		h.intern(g.key_name(bygis::KeyID(k)));
+	for ( size_t a = 0; a < A.size(); ++a ) {
+		h.set_dir(std::get<0>(A[a]), std::get<1>(A[a]), std::get<2>(A[a]),
+			std::get<3>(A[a]));
+	}
+	return h;
+}
+
+// True if h has g's settings and KeyIDs, and the same relationships
+// as want, read from both ends.
+template <class G>
+bool same ( const G& h, const G& g, const G& want )
+{
+	if ( h.directed != g.directed || h.no_relationship != g.no_relationship
+			|| h.num_keys() != g.num_keys() || h != want
+			|| h.size() != want.size() || h.num_edges() != want.num_edges()
+			|| h.vertices() != want.vertices() )
+		return false;
+	for ( size_t k = 0; k < g.num_keys(); ++k )
+		if ( h.key_name(bygis::KeyID(k)) != g.key_name(bygis::KeyID(k)) )
+			return false;
+	std::set<int> V = h.vertices();
+	std::set<int>::const_iterator it, jt;
+	for ( it = V.begin(); it != V.end(); ++it ) {
+		for ( jt = V.begin(); jt != V.end(); ++jt ) {
+			for ( size_t k = 0; k < g.num_keys(); ++k ) {
+				bygis::KeyID c (k);
+				if ( h.get(*it, *jt, c) != want.get(*it, *jt, c) )
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+// A predicate on a relationship from i toward j.
+struct Pick {
+	int how;
+	bygis::KeyID key;
+	bool operator() ( int i, int j, bygis::KeyID k, float x ) const
+	{
+		switch ( how ) {
+		case 0: return x < 3;
+		case 1: return (i + j) % 2 == 0;
+		case 2: return k == key;
+		default: return i < j;
+		}
+	}
+};
+
+template <class G>
+void check ( size_t rounds, std::mt19937& rng )
+{
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 30, k = 1 + rng() % 4;
+		G g (rng() % 2 == 0, rng() % 4 == 0 ? -1 : 0);
+		if ( rng() % 2 == 0 ) g.index_keys();
+		for ( size_t m = rng() % 200; m > 0; --m ) {
+			int i = rng() % n - 2, j = rng() % n - 2;
+			std::string key = key_name(rng() % k);
+			if ( rng() % 6 == 0 ) g.clear(i, j, key, rng() % 2 == 0);
+			else g.set(i, j, key, rng() % 3 == 0, (float)(1 + rng() % 5));
+		}
+		G before (g);
+		std::vector<Arc> A = arcs(g);
+
+		// subgraph: some vertices, and some IDs not in the graph
+		std::set<int> vs;
+		for ( size_t m = rng() % (n + 3); m > 0; --m )
+			vs.insert(rng() % (n + 4) - 4);
+		std::vector<Arc> S;
+		for ( size_t a = 0; a < A.size(); ++a )
+			if ( vs.count(std::get<0>(A[a])) && vs.count(std::get<1>(A[a])) )
+				S.push_back(A[a]);
+		if ( !same(g.subgraph(vs), g, build(g, S)) )
+			fail("subgraph", round, "vertices", vs.size());
+
+		// filter_key, by name and by ID, for each key and one never used
+		for ( int c = 0; c <= k; ++c ) {
+			std::string key = key_name(c);
+			std::vector<Arc> F;
+			for ( size_t a = 0; a < A.size(); ++a )
+				if ( std::get<2>(A[a]) == key ) F.push_back(A[a]);
+			G want = build(g, F);
+			if ( !same(g.filter_key(key), g, want) )
+				fail("filter_key", round, "key", c);
+			if ( g.key_id(key) != G::NO_KEY
+					&& !same(g.filter_key(g.key_id(key)), g, want) )
+				fail("filter_key(KeyID)", round, "key", c);
+		}
+
+		// filter, by value, vertices, and key
+		for ( int how = 0; how < 4; ++how ) {
+			Pick p = { how, g.key_id(key_name(rng() % k)) };
+			std::vector<Arc> F;
+			for ( size_t a = 0; a < A.size(); ++a ) {
+				const Arc& r = A[a];
+				if ( p(std::get<0>(r), std::get<1>(r),
+						g.key_id(std::get<2>(r)), std::get<3>(r)) )
+					F.push_back(r);
+			}
+			if ( !same(g.filter(p), g, build(g, F)) )
+				fail("filter", round, "predicate", how);
+		}
+		if ( g != before ) fail("unchanged", round, "vertices", 0);
+		if ( bygis::check::too_many() ) return;
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 300);
+	std::mt19937 rng (1);
+	check<bygis::Graph>(rounds, rng);
+	check<bygis::HashGraph>(rounds / 2, rng);
+	return bygis::check::finish();
+}
@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////
+// Checks that UpdateLog's commits leave the graph, and publish    //
+// snapshots, as the same changes made one at a time to a Graph:   //
+// random batches of keyed, undirected, and repeated changes and   //
+// removals, committed in turn into a CsrGraph snapshot of one     //
+// graph and a GraphFork snapshot of another, each fork made from  //
+// the last. Also checks that snapshots taken before a commit do   //
+// not change, that discard drops the changes, and (in C++20) the  //
+// commits into std::atomic snapshots. A round is one pair of      //
+// graphs (200 by default; see Check.hpp).                         //
+/////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////
+// -- HISTORY ---------------------------------------------------- //
+// 10/15/2026                                                      //
+// - created.                                                      //
+/////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include "UpdateLog.hpp"
+#include "Check.hpp"
+
+namespace {
+
+using bygis::check::fail;
+
+// Log m random changes between n vertices with k keys in L and M,
+// and make them to want as well; about a fifth are removals.
+void change ( bygis::UpdateLog& L, bygis::UpdateLog& M,
+	bygis::Graph& want, int n, size_t m, int k, std::mt19937& rng )
+{
+	for ( size_t e = 0; e < m; ++e ) {
+		int i = rng() % n, j = rng() % n;
+		int c = rng() % k;
+		std::string key = c == 0 ? "" : "k" + std::to_string(c);
+		bool undir = rng() % 3 == 0;
+		if ( rng() % 5 == 0 ) {
+			L.clear(i, j, key, undir);
+			M.clear(i, j, key, undir);
+			want.clear(i, j, key, undir);
+		}
+		else {
+			float x = (float)(1 + rng() % 5);
+			L.set(i, j, key, undir, x);
+			M.set(i, j, key, undir, x);
+			want.set(i, j, key, undir, x);
+		}
+	}
+}
+
+} // namespace
+
+int main ( int argc, char** argv )
+{
+	size_t rounds = bygis::check::rounds(argc, argv, 200);
+	std::mt19937 rng (1);
+	for ( size_t round = 0; round < rounds; ++round ) {
+		int n = 1 + rng() % 50, k = 1 + rng() % 4;
+		bool dir = rng() % 2 == 0;
+		bygis::Graph g (dir), h (dir), want (dir);
+		bygis::UpdateLog L (g), M (h);
+		std::shared_ptr<const bygis::CsrGraph> C;
+		std::shared_ptr<const bygis::GraphFork> F;
+		for ( size_t commit = 0; commit < 8; ++commit ) {
+			bygis::Graph before (want);
+			std::shared_ptr<const bygis::CsrGraph> C0 = C;
+			std::shared_ptr<const bygis::GraphFork> F0 = F;
+
+			// changes that are dropped
+			bygis::Graph dropped (want);
+			change(L, M, dropped, n, rng() % 20, k, rng);
+			L.discard();
+			M.discard();
+			if ( L.size() != 0 ) fail("discard", round, "commit", commit);
+
+			// sometimes start the fork again from the graph
+			if ( rng() % 8 == 0 ) F.reset();
+			change(L, M, want, n, rng() % 200, k, rng);
+			L.commit(C);
+			M.commit(F);
+			if ( L.size() != 0 ) fail("empty", round, "commit", commit);
+			if ( g != want || h != want )
+				fail("graph", round, "commit", commit);
+			if ( C->thaw() != want )
+				fail("CsrGraph snapshot", round, "commit", commit);
+			if ( F->thaw() != want || F->num_edges() != want.num_edges()
+					|| F->size() != want.size() )
+				fail("GraphFork snapshot", round, "commit", commit);
+			if ( C0 && C0->thaw() != before )
+				fail("old CsrGraph snapshot", round, "commit", commit);
+			if ( F0 && F0->thaw() != before )
+				fail("old GraphFork snapshot", round, "commit", commit);
+		}
+#ifdef __cpp_lib_atomic_shared_ptr
+		std::atomic<std::shared_ptr<const bygis::CsrGraph> > A (C);
+		std::atomic<std::shared_ptr<const bygis::GraphFork> > B (F);
+		change(L, M, want, n, 50, k, rng);
+		L.commit(A);
+		M.commit(B);
+		if ( A.load()->thaw() != want || B.load()->thaw() != want )
+			fail("atomic snapshot", round, "commit", 8);
+#endif
+	}
+	return bygis::check::finish();
+}